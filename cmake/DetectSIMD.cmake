@@ -82,7 +82,7 @@ if(SIMD_OPTION STREQUAL "AVX2")
 	if(MSVC)
 		add_compile_options(/arch:AVX2)
 	else()
-		set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -mavx2 -mfma")
+		set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -mavx2 -mfma -mf16c")
 	endif()
 
 	message(STATUS "Enabled AVX2 instructions")
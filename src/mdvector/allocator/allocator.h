@@ -34,9 +34,9 @@ class SimdAllocator {
   SimdAllocator(const SimdAllocator<U>&) noexcept {}
 
   static constexpr size_t alignment_for() {
-    // 对数值类型使用SIMD对齐，其他类型使用默认对齐
-    if constexpr (std::is_arithmetic_v<T>) {
-      return simd<T>::alignment;
+    // 具备simd特化的数值类型使用SIMD对齐，其他类型使用默认对齐
+    if constexpr (has_simd_v<T>) {
+      return simd<compute_type_t<T>>::alignment;
     } else {
       return alignof(T);  // 使用类型的自然对齐
     }
@@ -46,11 +46,18 @@ class SimdAllocator {
     if (n > max_size()) {
       throw std::bad_alloc();
     }
+    // aligned_alloc要求字节数为对齐的整数倍 int16/uint8等元素个数任意时向上取整
+    constexpr size_t align = alignment_for();
+    const size_t bytes = n * sizeof(T);
+    const size_t padded = (bytes + align - 1) / align * align;
+    if (padded < bytes) {
+      throw std::bad_alloc();
+    }
     void* ptr =
 #ifdef _WIN32
-        _aligned_malloc(n * sizeof(T), alignment_for());
+        _aligned_malloc(padded, align);
 #else
-        aligned_alloc(alignment_for(), n * sizeof(T));
+        aligned_alloc(align, padded);
 #endif
     if (!ptr) throw std::bad_alloc();
     return static_cast<T*>(ptr);
@@ -95,8 +102,8 @@ class SimdAllocator {
 };
 
 template <class T>
-using AutoAllocator = std::conditional_t<std::is_floating_point_v<T>,
-                                         SimdAllocator<T>,  // 浮点类型用对齐分配器
+using AutoAllocator = std::conditional_t<has_simd_v<T>,
+                                         SimdAllocator<T>,  // 浮点与simd整数类型用对齐分配器
                                          std::allocator<T>  // 其他类型用标准分配器
                                          >;
 
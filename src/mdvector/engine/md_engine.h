@@ -8,7 +8,14 @@
 #include <vector>
 
 #include "../allocator/allocator.h"
+#include "../exper_template/assign.h"
+#include "../exper_template/blocked.h"
+#include "../exper_template/cast_expr.h"
+#include "../exper_template/function.h"
+#include "../exper_template/let_expr.h"
 #include "../exper_template/operator.h"
+#include "../exper_template/reduction.h"
+#include "../exper_template/scan.h"
 #include "../simd/simd_function.h"
 #include "../span/mdspan.h"
 #include "../span/subspan.h"
@@ -0,0 +1,153 @@
+#ifndef __MDVECTOR_ASSIGN_H__
+#define __MDVECTOR_ASSIGN_H__
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "cast_expr.h"
+
+// ======================== 多输出融合求值 ========================
+// md::assign(md::tie(out1, out2, ...), expr1, expr2, ...) 在同一次遍历中求出多个同形状表达式
+// 每个pack先求出全部表达式再依次写回 多个表达式共用的叶节点在写回前加载 可由编译器合并为一次加载
+// 例(Runge-Kutta一步): md::assign(md::tie(u1, v1), u + dt * f, v - dt * f);
+// 目标可为mdvector或subspan 写回策略由各自目标决定 表达式按目标元素类型求值(同eval_to)
+// 各表达式读取的均是本次赋值之前的值 即 md::assign(md::tie(a, b), b, a) 交换a与b
+namespace md {
+
+using std::tie;
+
+namespace detail {
+
+// 目标的写回策略 即其TensorExpr基类的策略(mdvector对齐 subspan非对齐)
+template <class D, class P>
+P store_policy_of(const TensorExpr<D, P>&);
+
+template <class Out>
+using store_policy_t = decltype(store_policy_of(std::declval<const Out&>()));
+
+// 写回策略 Stream为true时对齐目标改为流式写回
+template <bool Stream, class Out>
+using assign_store_t =
+    std::conditional_t<Stream && std::is_same_v<store_policy_t<Out>, AlignedPolicy>, StreamPolicy, store_policy_t<Out>>;
+
+// 形状相同 右对齐逐维比较 缺少的前导维度视为1 即subspan的{1, 5, 37}与{5, 37}相同
+template <size_t R1, size_t R2>
+bool same_extents(const std::array<size_t, R1>& a, const std::array<size_t, R2>& b) {
+  for (size_t k = 0; k < std::max(R1, R2); ++k) {
+    const size_t x = k < R1 ? a[R1 - 1 - k] : 1;
+    const size_t y = k < R2 ? b[R2 - 1 - k] : 1;
+    if (x != y) return false;
+  }
+  return true;
+}
+
+template <bool Stream, class Out, class V>
+void store_pack(Out& out, size_t i, const V& v) {
+  assign_store_t<Stream, Out>::template store<typename Out::value_type>(out.begin() + i, v);
+}
+
+template <class Out, class V>
+void store_tail(Out& out, size_t i, size_t remaining, const V& v) {
+  store_policy_t<Out>::template mask_store<typename Out::value_type>(out.begin() + i, remaining, v);
+}
+
+// 全部表达式与一个目标的内存关系
+template <class O, class E, size_t... K>
+alias_kind dest_alias(const O& o, const E& expr, std::index_sequence<K...>) {
+  const mem_range dest = make_mem_range(o.begin(), o.size());
+  return merge_alias(std::get<K>(expr).alias(dest)...);
+}
+
+// 逐个目标检查后合并 如一个目标需正向求值而另一个需反向求值时为partial
+template <class Out, class E, size_t... K>
+alias_kind assign_alias(const Out& out, const E& expr, std::index_sequence<K...> seq) {
+  return merge_alias(dest_alias(std::get<K>(out), expr, seq)...);
+}
+
+// 每个pack先求出全部表达式再依次写回 Reverse为true时按下标反向遍历
+template <class C, bool Stream, bool Reverse, class Out, class E, size_t... K>
+void assign_fused(const Out& out, const E& expr, size_t n, std::index_sequence<K...>) {
+  using V = typename simd<C>::type;
+  auto body = [&](size_t i) {
+    const V v[] = {std::get<K>(expr).template eval_simd<C>(i)...};
+    (store_pack<Stream>(std::get<K>(out), i, v[K]), ...);
+  };
+  // 使用掩码处理尾部元素
+  auto tail = [&](size_t i, size_t remaining) {
+    const V v[] = {std::get<K>(expr).template eval_simd_mask<C>(i)...};
+    (store_tail(std::get<K>(out), i, remaining, v[K]), ...);
+  };
+
+  if constexpr (Reverse) {
+    for_each_pack_reverse<C>(n, body, tail);
+  } else {
+    for_each_pack<C>(0, n, body, tail);
+  }
+  if constexpr (Stream) StreamPolicy::fence();
+}
+
+template <class Out>
+using assign_buffer_t = std::vector<typename Out::value_type, AutoAllocator<typename Out::value_type>>;
+
+// 部分重叠时 全部表达式先求值到各自的临时缓冲区 再依次复制到目标
+template <class Out, class E, size_t... K>
+void assign_buffered(const Out& out, const E& expr, size_t n, std::index_sequence<K...>) {
+  auto buffer = std::make_tuple(assign_buffer_t<std::remove_reference_t<std::tuple_element_t<K, Out>>>(n)...);
+  (std::get<K>(expr).template eval_range<AlignedPolicy>(std::get<K>(buffer).data(), 0, n), ...);
+  (std::copy(std::get<K>(buffer).begin(), std::get<K>(buffer).end(), std::get<K>(out).begin()), ...);
+}
+
+}  // namespace detail
+
+// 各目标与各表达式的形状须相同 否则抛出std::runtime_error
+// 与赋值相同 按各表达式与各目标的内存关系选择求值方式: 不相交或操作数在目标之后时正向求值
+// 操作数在目标之前时反向求值 其余重叠经临时缓冲区 不相交且写回总字节数不小于md::stream_threshold时对齐目标流式写回
+template <class... Out, class... E, class... P>
+void assign(std::tuple<Out&...> out, const TensorExpr<E, P>&... expr) {
+  static_assert(sizeof...(Out) > 0, "md::assign needs at least one destination");
+  static_assert(sizeof...(Out) == sizeof...(E), "md::assign needs one expression per destination");
+
+  // 所有目标共用同一计算类型 以同一pack宽度推进
+  using C = compute_type_t<typename std::tuple_element_t<0, std::tuple<Out...>>::value_type>;
+  static_assert((std::is_same_v<compute_type_t<typename Out::value_type>, C> && ...),
+                "md::assign destinations must share one compute type");
+
+  const auto shape = std::get<0>(out).extents();
+  const bool same_shape =
+      std::apply([&shape](const auto&... o) { return (detail::same_extents(o.extents(), shape) && ...); }, out);
+  if (!same_shape || !(detail::same_extents(expr.extents(), shape) && ...)) {
+    throw std::runtime_error("assign destination shape mismatch");
+  }
+
+  // 表达式按目标元素类型求值 类型相同时CastExpr直接转发
+  const size_t n = std::get<0>(out).size();
+  const auto casted = std::make_tuple(CastExpr<E, typename Out::value_type, P>(expr.derived())...);
+  std::apply([](const auto&... e) { (e.prepare(), ...); }, casted);
+
+  using Seq = std::index_sequence_for<Out...>;
+  switch (detail::assign_alias(out, casted, Seq{})) {
+    case detail::alias_kind::none:
+      if (n * (sizeof(typename Out::value_type) + ...) >= stream_threshold) {
+        detail::assign_fused<C, true, false>(out, casted, n, Seq{});
+        break;
+      }
+      detail::assign_fused<C, false, false>(out, casted, n, Seq{});
+      break;
+    case detail::alias_kind::behind:
+      detail::assign_fused<C, false, true>(out, casted, n, Seq{});
+      break;
+    case detail::alias_kind::partial:
+      detail::assign_buffered(out, casted, n, Seq{});
+      break;
+    default:
+      detail::assign_fused<C, false, false>(out, casted, n, Seq{});
+  }
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_ASSIGN_H__
@@ -0,0 +1,95 @@
+#ifndef __MDVECTOR_BITWISE_EXPR_H__
+#define __MDVECTOR_BITWISE_EXPR_H__
+
+#include "function_expr.h"
+
+// ======================== 位运算 ========================
+// 仅限整数元素类型 int32_t/int64_t/int16_t/uint8_t
+struct BitAndOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    static_assert(std::is_integral_v<T>, "bitwise operations require an integer element type");
+    return simd<T>::bit_and(a, b);
+  }
+};
+
+struct BitOrOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    static_assert(std::is_integral_v<T>, "bitwise operations require an integer element type");
+    return simd<T>::bit_or(a, b);
+  }
+};
+
+struct BitXorOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    static_assert(std::is_integral_v<T>, "bitwise operations require an integer element type");
+    return simd<T>::bit_xor(a, b);
+  }
+};
+
+struct BitNotOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    static_assert(std::is_integral_v<T>, "bitwise operations require an integer element type");
+    return simd<T>::bit_not(x);
+  }
+};
+
+// 移位 有符号类型右移为算术右移
+struct ShlOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x, int n) {
+    static_assert(std::is_integral_v<T>, "shift operations require an integer element type");
+    return simd<T>::shl(x, n);
+  }
+};
+
+struct ShrOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x, int n) {
+    static_assert(std::is_integral_v<T>, "shift operations require an integer element type");
+    return simd<T>::shr(x, n);
+  }
+};
+
+// ======================== 移位表达式 ========================
+// 所有通道移动相同的位数
+template <class E, class Op, class Policy>
+class ShiftExpr : public TensorExpr<ShiftExpr<E, Op, Policy>, Policy> {
+  expr_ref_t<E> expr;
+  int count;
+
+ public:
+  using value_type = typename E::value_type;
+
+  ShiftExpr(const E& e, int n) : expr(e), count(n) {}
+
+  size_t size() const { return expr.size(); }
+
+  auto extents() const { return expr.extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const { return expr.alias(dest); }
+
+  void prepare() const { expr.prepare(); }
+
+  // 以f变换操作数后重建 用于广播下沉到叶节点
+  template <class F>
+  auto map_operands(F f) const {
+    auto e = f(expr);
+    return ShiftExpr<decltype(e), Op, Policy>(e, count);
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    return Op::template apply<T>(expr.template eval_simd<T>(i), count);
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    return Op::template apply<T>(expr.template eval_simd_mask<T>(i), count);
+  }
+};
+
+#endif  // __MDVECTOR_BITWISE_EXPR_H__
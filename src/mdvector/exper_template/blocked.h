@@ -0,0 +1,211 @@
+#ifndef __MDVECTOR_BLOCKED_H__
+#define __MDVECTOR_BLOCKED_H__
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../allocator/allocator.h"
+#include "assign.h"
+
+// ======================== 分块多语句求值 ========================
+// 一个时间步常由若干条逐元素语句组成(如 t = a * b; u = t + c; v = u * u - d;) 逐条求值时每条语句都把数组从内存完整读写一遍
+// md::blocked(md::stmt(t, a * b), md::stmt(u, t + c), md::stmt(v, u * u - d)) 记录语句序列
+// eval()将扁平下标按块划分 每块内依次执行全部语句(TensorExpr::eval_to的区间形式) 前面语句写出的块仍在L1/L2中
+// 只在块内使用的中间量声明为md::scratch 只保留一个块的缓冲区 完整数组不写回内存
+// 所有语句的目标与表达式元素个数须相同 语句逐元素计算
+// 广播操作数在序列开始前取值 读取任一语句目标所在内存(如其中一行)时为部分重叠 eval()抛出std::runtime_error
+// 语句读取其他语句目标所在内存时 须保证逐块执行与逐条执行的结果一致 否则eval()抛出std::runtime_error
+namespace md {
+
+// 块内中间量 形状与语句相同 只持有当前块的对齐缓冲区
+// 仅作为md::blocked语句的目标 以及同一序列中后面语句的操作数使用
+// 只能按下标读取当前块 被广播(需读取整个数组)或在块外读取时抛出std::runtime_error
+template <class T, size_t Rank>
+class scratch : public TensorExpr<scratch<T, Rank>, AlignedPolicy> {
+  std::array<size_t, Rank> extents_;
+  size_t size_ = 1;
+  std::vector<T, AutoAllocator<T>> tile_;
+  size_t begin_ = 0;  // 当前块起始的扁平下标
+  size_t end_ = 0;
+
+ public:
+  using value_type = T;
+
+  explicit scratch(const std::array<size_t, Rank>& extents) : extents_(extents) {
+    for (size_t d : extents_) size_ *= d;
+  }
+
+  size_t size() const { return size_; }
+
+  std::array<size_t, Rank> extents() const { return extents_; }
+
+  // 块缓冲区为自身持有
+  md::detail::alias_kind alias(const md::detail::mem_range&) const { return md::detail::alias_kind::none; }
+
+  void prepare() const {}
+
+  // 切换到下标[begin, begin + len)所在的块
+  void bind_tile(size_t begin, size_t len) {
+    if (tile_.size() < len) tile_.resize(len);
+    begin_ = begin;
+    end_ = begin + len;
+  }
+
+  T* tile_data() { return tile_.data(); }
+
+  template <class T2>
+  typename simd<T2>::type eval_simd(size_t i) const {
+    check_tile(i, i + simd<T2>::pack_size);
+    return AlignedPolicy::template load<T, T2>(tile_.data() + (i - begin_));
+  }
+
+  template <class T2>
+  typename simd<T2>::type eval_simd_mask(size_t i) const {
+    check_tile(i, size_);
+    return AlignedPolicy::template mask_load<T, T2>(tile_.data() + (i - begin_), size_ - i);
+  }
+
+ private:
+  void check_tile(size_t first, size_t last) const {
+    if (first < begin_ || last > end_) {
+      throw std::runtime_error("md::scratch read outside the current tile");
+    }
+  }
+};
+
+}  // namespace md
+
+// 块缓冲区随块切换 表达式须按引用持有
+template <class T, size_t Rank>
+struct held_by_ref<md::scratch<T, Rank>> : std::true_type {};
+
+namespace md {
+namespace detail {
+
+template <class Out>
+void bind_tile(Out&, size_t, size_t) {}
+
+template <class T, size_t Rank>
+void bind_tile(scratch<T, Rank>& out, size_t begin, size_t len) {
+  out.bind_tile(begin, len);
+}
+
+template <class Out>
+auto tile_dest(Out& out, size_t begin) {
+  return out.begin() + begin;
+}
+
+template <class T, size_t Rank>
+T* tile_dest(scratch<T, Rank>& out, size_t) {
+  return out.tile_data();
+}
+
+template <class Out>
+mem_range tile_range(const Out& out) {
+  return make_mem_range(out.begin(), out.size());
+}
+
+template <class T, size_t Rank>
+mem_range tile_range(const scratch<T, Rank>&) {
+  return {};
+}
+
+// 第k条语句读取第j条语句的目标 按块执行时结果与逐条执行相同的内存关系(同assign_to的分类)
+// 第j条语句在前: 应读取已写出的新值 只能读取同一下标或已处理的低位下标(behind)
+// 第j条语句为自身或在后: 应读取写回前的旧值 只能读取同一下标或尚未处理的高位下标(ahead)
+inline bool tile_order_safe(size_t k, size_t j, alias_kind kind) {
+  if (kind == alias_kind::none || kind == alias_kind::same) return true;
+  if (kind == alias_kind::partial) return false;
+  return j < k ? kind == alias_kind::behind : kind == alias_kind::ahead;
+}
+
+// 一条语句 out = expr
+template <class Out, class E>
+class statement {
+  Out& out_;
+  expr_ref_t<E> expr_;
+
+ public:
+  statement(Out& out, const E& expr) : out_(out), expr_(expr) {}
+
+  size_t size() const { return out_.size(); }
+
+  bool same_size() const { return expr_.size() == out_.size(); }
+
+  void bind(size_t begin, size_t len) const { bind_tile(out_, begin, len); }
+
+  // 目标的字节区间 md::scratch不写回数组 区间为空
+  mem_range dest_range() const { return tile_range(out_); }
+
+  alias_kind alias(const mem_range& dest) const { return expr_.alias(dest); }
+
+  // 整个序列开始前调用一次 之后逐块求值不再刷新
+  void prepare() const { expr_.prepare(); }
+
+  void eval(size_t begin, size_t end) const {
+    expr_.template eval_range<store_policy_t<Out>>(tile_dest(out_, begin), begin, end);
+  }
+};
+
+}  // namespace detail
+
+// 默认块长(元素数) 每个数组一块为4KB(float)或8KB(double) 一条语句序列涉及的数组块可同时留在L1/L2中
+inline constexpr size_t blocked_tile_size = 1024;
+
+template <class... S>
+class blocked_statements {
+  std::tuple<S...> stmts_;
+
+  template <size_t... K>
+  void eval_impl(size_t tile, std::index_sequence<K...>) const {
+    const size_t n = std::get<0>(stmts_).size();
+    if (!((std::get<K>(stmts_).size() == n && std::get<K>(stmts_).same_size()) && ...)) {
+      throw std::runtime_error("blocked statement shape mismatch");
+    }
+
+    const std::array<detail::mem_range, sizeof...(K)> dest = {std::get<K>(stmts_).dest_range()...};
+    bool in_order = true;
+    for (size_t j = 0; j < dest.size(); ++j) {
+      in_order = (in_order && ... && detail::tile_order_safe(K, j, std::get<K>(stmts_).alias(dest[j])));
+    }
+    if (!in_order) {
+      throw std::runtime_error("blocked statement reads overlapping memory out of tile order");
+    }
+
+    (std::get<K>(stmts_).prepare(), ...);
+
+    // 块长取64的整数倍 块起始对任意元素类型均为pack_size与对齐的整数倍
+    tile = (std::max<size_t>(tile, 1) + 63) / 64 * 64;
+    for (size_t begin = 0; begin < n; begin += tile) {
+      const size_t end = std::min(begin + tile, n);
+      (std::get<K>(stmts_).bind(begin, end - begin), ...);
+      (std::get<K>(stmts_).eval(begin, end), ...);
+    }
+  }
+
+ public:
+  explicit blocked_statements(const S&... stmts) : stmts_(stmts...) {}
+
+  // 按块依次执行全部语句 元素个数不一致或读取顺序与逐条执行不一致时抛出std::runtime_error
+  void eval(size_t tile = blocked_tile_size) const { eval_impl(tile, std::index_sequence_for<S...>{}); }
+};
+
+// 目标可为mdvector, subspan或md::scratch 表达式按值保存(具名数组按引用) 记录的序列可在每个时间步重复eval()
+template <class Out, class E, class P>
+detail::statement<Out, E> stmt(Out& out, const TensorExpr<E, P>& expr) {
+  return detail::statement<Out, E>(out, expr.derived());
+}
+
+template <class... S>
+blocked_statements<S...> blocked(const S&... stmts) {
+  static_assert(sizeof...(S) > 0, "md::blocked needs at least one statement");
+  return blocked_statements<S...>(stmts...);
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_BLOCKED_H__
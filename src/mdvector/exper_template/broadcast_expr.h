@@ -0,0 +1,552 @@
+#ifndef __MDVECTOR_BROADCAST_EXPR_H__
+#define __MDVECTOR_BROADCAST_EXPR_H__
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "../allocator/allocator.h"
+#include "scalar_expr.h"
+
+// ======================== 广播 ========================
+// 形状按尾部维对齐 操作数缺失的维与长度为1的维沿目标形状重复 对应步长为0
+// 例: (M, N) + (N)  (D, H, W) * (H, W)  (M, N) - (M, 1)  (M, 1) * (1, N)
+// 冷路径不内联
+#if defined(_MSC_VER)
+#define MD_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+#define MD_NOINLINE __attribute__((noinline))
+#else
+#define MD_NOINLINE
+#endif
+
+namespace md {
+namespace detail {
+
+// 表达式的秩 即extents()返回的std::array长度
+template <class E>
+inline constexpr size_t expr_rank_v = std::tuple_size_v<decltype(std::declval<const E&>().extents())>;
+
+// 除数固定的整数除法 构造时预计算倒数M = floor((2^64 - 1) / d) + 1 商为M * n的高64位
+// 被除数与除数均小于2^32时结果精确(Lemire 2019) 以两次32位拆分乘法代替每个pack一次除法指令 超出范围时退回除法
+class fixed_divider {
+  uint64_t d_ = 1;
+  uint64_t m_ = 0;
+
+ public:
+  fixed_divider() = default;
+
+  explicit fixed_divider(size_t d) : d_(d), m_(d <= 0xFFFFFFFFu ? UINT64_C(0xFFFFFFFFFFFFFFFF) / d + 1 : 0) {}
+
+  size_t divide(size_t n, size_t& rem) const {
+    uint64_t q;
+    if (n <= 0xFFFFFFFFu && m_ != 0) {
+      // n < 2^32 时 (m_hi * n + (m_lo * n >> 32)) 不溢出
+      q = ((m_ >> 32) * n + (((m_ & 0xFFFFFFFFu) * n) >> 32)) >> 32;
+    } else {
+      q = n / d_;
+    }
+    rem = static_cast<size_t>(n - q * d_);
+    return static_cast<size_t>(q);
+  }
+};
+
+// 连续存储的操作数(mdvector/subspan) 直接按指针读取 其余表达式每次求值前按原形状求值到缓冲区
+template <class E, class = void>
+struct has_dense_data : std::false_type {};
+
+template <class E>
+struct has_dense_data<E, std::void_t<decltype(std::declval<const E&>().cbegin())>> : std::true_type {};
+
+// 两个形状按尾部维对齐的广播结果 每一维相同或其一为1 否则抛出std::invalid_argument
+template <size_t RL, size_t RR>
+std::array<size_t, (RL > RR ? RL : RR)> broadcast_shape(const std::array<size_t, RL>& l,
+                                                        const std::array<size_t, RR>& r) {
+  constexpr size_t Rank = RL > RR ? RL : RR;
+  std::array<size_t, Rank> out{};
+  for (size_t k = 0; k < Rank; ++k) {
+    const size_t a = k < RL ? l[RL - 1 - k] : 1;
+    const size_t b = k < RR ? r[RR - 1 - k] : 1;
+    if (a != b && a != 1 && b != 1) {
+      throw std::invalid_argument("operand shapes are not broadcast compatible");
+    }
+    out[Rank - 1 - k] = a == 1 ? b : a;
+  }
+  return out;
+}
+
+template <size_t Rank>
+size_t shape_size(const std::array<size_t, Rank>& extents) {
+  size_t n = 1;
+  for (size_t d : extents) n *= d;
+  return n;
+}
+
+// 掩码不做广播(求值结果为比较掩码而非数值) 与公共形状兼容且元素数相同(仅可少前导的长度1维) 否则抛出std::invalid_argument
+template <class C, size_t Rank>
+void require_mask_size(const C& c, const std::array<size_t, Rank>& extents) {
+  if (c.size() != shape_size(extents)) {
+    throw std::invalid_argument("mask cannot be broadcast to the operand shape");
+  }
+}
+
+// 表达式的访存策略 即TensorExpr基类的Policy参数
+template <class D, class P>
+P expr_policy(const TensorExpr<D, P>&);
+
+template <class E>
+using expr_policy_t = decltype(expr_policy(std::declval<const E&>()));
+
+// 车道下标向量 {0, 1, ..., pack_size - 1}
+template <class T>
+struct lane_index_table {
+  T value[64] = {};
+
+  constexpr lane_index_table() {
+    for (size_t k = 0; k < 64; ++k) value[k] = static_cast<T>(k);
+  }
+};
+
+template <class T>
+inline typename simd<T>::type simd_lane_index() {
+  static_assert(simd<T>::pack_size <= 64, "lane index table holds 64 lanes");
+  static constexpr lane_index_table<T> table;
+  return simd<T>::loadu(table.value);
+}
+
+}  // namespace detail
+}  // namespace md
+
+// ======================== 广播表达式 ========================
+// 将操作数E按步长0映射到Rank维目标形状 按输出的扁平下标求值
+// 构造时去掉目标长度为1的维 合并步长连续(或同为0)的相邻维 最内一段为"行"
+// pack落在同一行内时: 行内连续则为一次非对齐加载 行内广播(如列向量)则为set1
+// 跨一行的pack(行长不是pack_size整数倍时每行一个):
+//   行内广播: 按车道下标select两行的值
+//   行内连续且下一行重复同一操作数行(如 (M, N) + (N)): 从每行后接周期延拓的副本连续加载
+//   行内连续且下一行在操作数中紧接本行: 直接连续加载
+// 其余情况(行长小于pack_size等)按行分段复制到缓冲区后加载
+// 操作数为表达式(如 m * (row * 2.0f))时 每次求值前(prepare)按其原形状求值到节点持有的缓冲区 不展开
+// 缓冲区与周期延拓副本在首次求值时分配 之后的求值复用并按操作数当前内容刷新 构造时不分配也不计算
+template <class E, size_t Rank, class Policy>
+class BroadcastExpr : public TensorExpr<BroadcastExpr<E, Rank, Policy>, Policy> {
+  using V = typename E::value_type;
+  using buffer_type = std::vector<V, AutoAllocator<V>>;
+
+  static constexpr bool dense_ = md::detail::has_dense_data<E>::value;
+
+  // 延拓元素数 取一个512位寄存器的元素数
+  static constexpr size_t halo_ = 64 / sizeof(V) > 0 ? 64 / sizeof(V) : 1;
+
+  expr_ref_t<E> expr_;
+  mutable const V* data_ = nullptr;
+  size_t data_size_ = 0;
+  mutable std::shared_ptr<buffer_type> owned_;
+  std::array<size_t, Rank> extents_;
+  size_t size_ = 1;
+
+  // 行 即合并后的最内维
+  md::detail::fixed_divider row_div_;
+  size_t row_len_ = 1;
+  size_t row_stride_ = 0;  // 0: 行内广播 1: 行内连续
+
+  // 外层维(由内向外) 最外一维不需要取模
+  std::array<md::detail::fixed_divider, Rank> outer_div_;
+  std::array<size_t, Rank> outer_stride_{};
+  size_t outer_dims_ = 0;
+
+  // 行内连续且外层最内维广播时 同一操作数行连续重复period_行
+  // ext_中每个操作数行长row_len_ + halo_ 行尾接本行开头的周期延拓
+  mutable const V* ext_ = nullptr;
+  mutable std::shared_ptr<buffer_type> ext_owned_;
+  size_t period_ = 0;
+
+  // 最近访问行的缓存 按扁平下标顺序求值时每行至多一次除法 行内pack仅一次比较
+  // 乱序访问时重新定位 结果不变 同一节点不可被多个线程同时求值
+  mutable size_t row_ = 0;
+  mutable size_t row_begin_ = 0;
+  mutable size_t row_base_ = 0;
+  mutable size_t row_ext_ = 0;
+  mutable size_t rows_left_ = 0;
+
+  // 第q行在操作数中的起始偏移
+  size_t row_offset(size_t q) const {
+    size_t offset = 0;
+    for (size_t k = 0; k + 1 < outer_dims_; ++k) {
+      size_t idx;
+      q = outer_div_[k].divide(q, idx);
+      offset += idx * outer_stride_[k];
+    }
+    return outer_dims_ > 0 ? offset + q * outer_stride_[outer_dims_ - 1] : offset;
+  }
+
+  void set_row(size_t q) const {
+    row_ = q;
+    row_begin_ = q * row_len_;
+    row_base_ = row_offset(q);
+    if (period_ > 0) {
+      size_t rem;
+      row_ext_ = row_div_.divide(row_base_, rem) * (row_len_ + halo_);
+      outer_div_[0].divide(q, rem);
+      rows_left_ = period_ - rem;
+    }
+  }
+
+  void next_row() const {
+    if (rows_left_ > 1) {
+      ++row_;
+      row_begin_ += row_len_;
+      --rows_left_;
+    } else {
+      set_row(row_ + 1);
+    }
+  }
+
+  // p起连续n个元素
+  template <class T>
+  static typename simd<T>::type load_run(const V* p, size_t n) {
+    return n == simd<T>::pack_size ? UnalignedPolicy::template load<V, T>(p)
+                                   : UnalignedPolicy::template mask_load<V, T>(p, n);
+  }
+
+  // 输出下标i起n个元素(n <= pack_size)
+  // 落在缓存行内为热路径 其余交给不内联的load_slow 减少主循环寄存器压力
+  template <class T>
+  typename simd<T>::type load(size_t i, size_t n) const {
+    const size_t j = i - row_begin_;
+    if (j < row_len_ && j + n <= row_len_) {
+      return row_stride_ == 0 ? simd<T>::set1(static_cast<T>(data_[row_base_])) : load_run<T>(data_ + row_base_ + j, n);
+    }
+    return load_slow<T>(i, n);
+  }
+
+  template <class T>
+  MD_NOINLINE typename simd<T>::type load_slow(size_t i, size_t n) const {
+    using S = simd<T>;
+    size_t j = i - row_begin_;
+    if (j >= row_len_) {
+      if (n == 0) {
+        return S::set1(T(0));
+      }
+      // 顺序求值时通常恰好进入下一行 免去除法
+      if (j < 2 * row_len_) {
+        next_row();
+        j -= row_len_;
+      } else {
+        set_row(row_div_.divide(i, j));
+      }
+      if (j + n <= row_len_) {
+        return row_stride_ == 0 ? S::set1(static_cast<T>(data_[row_base_])) : load_run<T>(data_ + row_base_ + j, n);
+      }
+    }
+
+    // 跨一行 缓存前移一行
+    if (j + n <= 2 * row_len_) {
+      const size_t base = row_base_;
+      const size_t ext = row_ext_;
+      const bool repeat = rows_left_ > 1;
+      next_row();
+      if (row_stride_ == 0) {
+        return S::select(S::cmp_lt(md::detail::simd_lane_index<T>(), S::set1(static_cast<T>(row_len_ - j))),
+                         S::set1(static_cast<T>(data_[base])), S::set1(static_cast<T>(data_[row_base_])));
+      }
+      if (repeat && j + n <= row_len_ + halo_) {
+        return load_run<T>(ext_ + ext + j, n);
+      }
+      if (row_base_ == base + row_len_) {
+        return load_run<T>(data_ + base + j, n);
+      }
+      set_row(row_ - 1);
+    }
+
+    // 跨多行 按行分段复制到缓冲区 缓存停在最后一段所在行
+    V buffer[S::pack_size];
+    for (size_t k = 0; k < n;) {
+      const size_t run = std::min(n - k, row_len_ - j);
+      if (row_stride_ == 0) {
+        std::fill_n(buffer + k, run, data_[row_base_]);
+      } else {
+        std::copy_n(data_ + row_base_ + j, run, buffer + k);
+      }
+      k += run;
+      if (k < n) {
+        j = 0;
+        next_row();
+      }
+    }
+    return load_run<T>(buffer, n);
+  }
+
+ public:
+  using value_type = V;
+
+  // 操作数形状按尾部维对齐 每一维须与目标相同或为1 否则抛出std::invalid_argument
+  BroadcastExpr(const E& e, const std::array<size_t, Rank>& extents) : expr_(e), extents_(extents) {
+    constexpr size_t ERank = md::detail::expr_rank_v<E>;
+    static_assert(ERank <= Rank, "broadcast target rank must not be lower than the operand rank");
+    const auto src = e.extents();
+    data_size_ = e.size();
+
+    // 操作数各维步长(行主序) 广播维为0
+    std::array<size_t, Rank> stride{};
+    size_t step = 1;
+    for (size_t k = 0; k < ERank; ++k) {
+      const size_t d = ERank - 1 - k;
+      const size_t out = extents[Rank - 1 - k];
+      if (src[d] != out && src[d] != 1) {
+        throw std::invalid_argument("operand shape is not broadcast compatible with target shape");
+      }
+      stride[Rank - 1 - k] = src[d] == 1 ? 0 : step;
+      step *= src[d];
+    }
+
+    // 由内向外合并 跳过长度为1的维
+    std::array<size_t, Rank> len{};
+    std::array<size_t, Rank> str{};
+    size_t m = 0;
+    for (size_t k = 0; k < Rank; ++k) {
+      const size_t d = Rank - 1 - k;
+      size_ *= extents[d];
+      if (extents[d] == 1) continue;
+      if (m > 0 && stride[d] == str[m - 1] * len[m - 1]) {
+        len[m - 1] *= extents[d];
+      } else {
+        len[m] = extents[d];
+        str[m] = stride[d];
+        ++m;
+      }
+    }
+
+    if (m > 0) {
+      row_len_ = len[0];
+      row_stride_ = str[0];
+    }
+    row_div_ = md::detail::fixed_divider(row_len_);
+    for (size_t k = 1; k < m; ++k) {
+      outer_div_[outer_dims_] = md::detail::fixed_divider(len[k]);
+      outer_stride_[outer_dims_] = str[k];
+      ++outer_dims_;
+    }
+
+    // 行内连续且外层最内维广播时使用周期延拓副本
+    if (row_stride_ == 1 && outer_dims_ > 0 && outer_stride_[0] == 0) {
+      period_ = len[1];
+    }
+    if constexpr (dense_) {
+      data_ = e.cbegin();
+    }
+  }
+
+  size_t size() const { return size_; }
+
+  std::array<size_t, Rank> extents() const { return extents_; }
+
+  const E& operand() const { return expr_; }
+
+  // 操作数元素按广播映射读取 与目标有任何重叠即为部分重叠
+  // 表达式操作数在prepare()时求值到节点的缓冲区 其读取的内存与目标重叠时同样为部分重叠:
+  // 赋值时经临时缓冲区 md::blocked中缓冲区不随前面语句的写回更新 须拒绝
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    bool overlap;
+    if constexpr (dense_) {
+      overlap = md::detail::range_alias(expr_.cbegin(), data_size_, dest) != md::detail::alias_kind::none;
+    } else {
+      overlap = expr_.alias(dest) != md::detail::alias_kind::none;
+    }
+    return overlap ? md::detail::alias_kind::partial : md::detail::alias_kind::none;
+  }
+
+  // 按操作数当前内容刷新: 表达式操作数求值到缓冲区 重建周期延拓副本(大小为操作数行数 * (row_len_ + halo_))
+  void prepare() const {
+    if constexpr (dense_) {
+      data_ = expr_.cbegin();
+    } else {
+      if (!owned_) owned_ = std::make_shared<buffer_type>(data_size_);
+      expr_.eval_to(owned_->data());
+      data_ = owned_->data();
+    }
+    if (period_ > 0) {
+      const size_t rows = data_size_ / row_len_;
+      const size_t width = row_len_ + halo_;
+      if (!ext_owned_) ext_owned_ = std::make_shared<buffer_type>(rows * width);
+      V* ext = ext_owned_->data();
+      for (size_t r = 0; r < rows; ++r) {
+        for (size_t t = 0; t < width; ++t) {
+          ext[r * width + t] = data_[r * row_len_ + t % row_len_];
+        }
+      }
+      ext_ = ext;
+    }
+    set_row(0);
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    return load<T>(i, simd<T>::pack_size);
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    return load<T>(i, std::min(simd<T>::pack_size, size_ - i));
+  }
+};
+
+// ======================== 同秩广播 ========================
+// 秩与目标相同 且不能把广播下沉到子节点的操作数(叶节点及map_operands以外的节点) 是否广播在构造时按形状确定
+// 连续存储的操作数(mdvector/subspan): 始终按指针加载 形状相同时指向操作数 无每个pack的分支
+//   含长度为1的维时 每次求值前(prepare)经BroadcastExpr展开到节点持有的目标大小缓冲区(首次求值时分配)
+// 其余表达式: 每个pack一次结果固定的分支 选择直接求值或BroadcastExpr
+// 不展开的按步长0广播可用md::broadcast_to显式指定
+template <class E, size_t Rank, class Policy>
+class MaybeBroadcastExpr : public TensorExpr<MaybeBroadcastExpr<E, Rank, Policy>, Policy> {
+  using V = typename E::value_type;
+  using B = BroadcastExpr<E, Rank, Policy>;
+  using buffer_type = std::vector<V, AutoAllocator<V>>;
+  using LoadPolicy = md::detail::expr_policy_t<E>;
+
+  static constexpr bool dense_ = md::detail::has_dense_data<E>::value;
+
+  expr_ref_t<E> expr_;
+  std::optional<B> bcast_;
+  mutable const V* data_ = nullptr;
+  mutable std::shared_ptr<buffer_type> owned_;
+  size_t size_;
+
+ public:
+  using value_type = V;
+
+  MaybeBroadcastExpr(const E& e, const std::array<size_t, Rank>& extents) : expr_(e), size_(e.size()) {
+    if (e.extents() != extents) {
+      bcast_.emplace(e, extents);
+      size_ = bcast_->size();
+    } else if constexpr (dense_) {
+      data_ = e.cbegin();
+    }
+  }
+
+  size_t size() const { return size_; }
+
+  std::array<size_t, Rank> extents() const { return bcast_ ? bcast_->extents() : expr_.extents(); }
+
+  const E& operand() const { return expr_; }
+
+  // 广播时操作数在prepare()时展开 与目标重叠即为部分重叠(同BroadcastExpr)
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    if (!bcast_) return expr_.alias(dest);
+    return bcast_->alias(dest);
+  }
+
+  void prepare() const {
+    if (!bcast_) {
+      expr_.prepare();
+      if constexpr (dense_) data_ = expr_.cbegin();
+      return;
+    }
+    bcast_->prepare();
+    if constexpr (dense_) {
+      if (!owned_) owned_ = std::make_shared<buffer_type>(size_);
+      bcast_->template eval_range<AlignedPolicy>(owned_->data(), 0, size_);
+      data_ = owned_->data();
+    }
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    if constexpr (dense_) {
+      return LoadPolicy::template load<V, T>(data_ + i);
+    } else {
+      return bcast_ ? bcast_->template eval_simd<T>(i) : expr_.template eval_simd<T>(i);
+    }
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    if constexpr (dense_) {
+      return LoadPolicy::template mask_load<V, T>(data_ + i, size_ - i);
+    } else {
+      return bcast_ ? bcast_->template eval_simd_mask<T>(i) : expr_.template eval_simd_mask<T>(i);
+    }
+  }
+};
+
+namespace md {
+namespace detail {
+
+template <class E>
+struct is_broadcast_expr : std::false_type {};
+
+template <class E, size_t Rank, class Policy>
+struct is_broadcast_expr<BroadcastExpr<E, Rank, Policy>> : std::true_type {};
+
+template <class E>
+struct is_maybe_broadcast_expr : std::false_type {};
+
+template <class E, size_t Rank, class Policy>
+struct is_maybe_broadcast_expr<MaybeBroadcastExpr<E, Rank, Policy>> : std::true_type {};
+
+// 逐元素节点提供map_operands(f): 以f变换各操作数后重建同类节点
+template <class E, class = void>
+struct has_map_operands : std::false_type {};
+
+struct identity_operand {
+  template <class X>
+  const X& operator()(const X& x) const {
+    return x;
+  }
+};
+
+template <class E>
+struct has_map_operands<E, std::void_t<decltype(std::declval<const E&>().map_operands(identity_operand{}))>>
+    : std::true_type {};
+
+// 将操作数广播到目标形状(已由broadcast_shape确定) 广播可传递 已广播的操作数取其原操作数直接广播 不嵌套
+// 标量: 原样  BroadcastExpr: 原操作数按步长0广播到目标  低秩: BroadcastExpr
+// 同秩逐元素节点: 广播下沉到各操作数 保留a * b + c的融合乘加识别 形状相同时叶节点不引入分支
+// 其余同秩操作数: MaybeBroadcastExpr
+template <class Policy, class E, size_t Rank>
+auto broadcast_operand(const E& e, const std::array<size_t, Rank>& extents) {
+  if constexpr (is_scalar_expr_v<E>) {
+    return e;
+  } else if constexpr (is_broadcast_expr<E>::value) {
+    using X = std::decay_t<decltype(e.operand())>;
+    return BroadcastExpr<X, Rank, Policy>(e.operand(), extents);
+  } else if constexpr (is_maybe_broadcast_expr<E>::value) {
+    return broadcast_operand<Policy>(e.operand(), extents);
+  } else if constexpr (expr_rank_v<E> < Rank) {
+    return BroadcastExpr<E, Rank, Policy>(e, extents);
+  } else if constexpr (has_map_operands<E>::value) {
+    return e.map_operands([&extents](const auto& x) { return broadcast_operand<Policy>(x, extents); });
+  } else {
+    return MaybeBroadcastExpr<E, Rank, Policy>(e, extents);
+  }
+}
+
+}  // namespace detail
+}  // namespace md
+
+// ======================== 运算符广播 ========================
+// 两个操作数按尾部维对齐广播到公共形状(同numpy) 低秩一侧补齐缺失维 长度为1的维沿另一侧重复
+// 形状不兼容时抛出std::invalid_argument
+// Node<L, R, Policy>: + - * /
+template <template <class, class, class> class Node, class Policy, class L, class R>
+auto make_broadcast_node(const L& l, const R& r) {
+  const auto extents = md::detail::broadcast_shape(l.extents(), r.extents());
+  auto bl = md::detail::broadcast_operand<Policy>(l, extents);
+  auto br = md::detail::broadcast_operand<Policy>(r, extents);
+  return Node<decltype(bl), decltype(br), Policy>(bl, br);
+}
+
+// Node<L, R, Op, Policy>: 比较 位运算 二元函数(min/max/pow/atan2/div)
+template <template <class, class, class, class> class Node, class Op, class Policy, class L, class R>
+auto make_broadcast_node(const L& l, const R& r) {
+  const auto extents = md::detail::broadcast_shape(l.extents(), r.extents());
+  auto bl = md::detail::broadcast_operand<Policy>(l, extents);
+  auto br = md::detail::broadcast_operand<Policy>(r, extents);
+  return Node<decltype(bl), decltype(br), Op, Policy>(bl, br);
+}
+
+#endif  // __MDVECTOR_BROADCAST_EXPR_H__
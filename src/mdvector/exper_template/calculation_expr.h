@@ -3,72 +3,173 @@
 
 #include "scalar_expr.h"
 
+// ======================== 乘法子树识别 ========================
+// a * b + c / a * b - c / c - a * b 编译期识别为融合乘加
+template <typename L, typename R, class Policy>
+class MulExpr;
+
+template <class E>
+struct is_mul_expr : std::false_type {};
+
+template <class L, class R, class Policy>
+struct is_mul_expr<MulExpr<L, R, Policy>> : std::true_type {};
+
+template <class E>
+inline constexpr bool is_mul_expr_v = is_mul_expr<E>::value;
+
 // ======================== 表达式类 ========================
 template <class L, class R, class Policy>
 class AddExpr : public TensorExpr<AddExpr<L, R, Policy>, Policy> {
-  const L& lhs;
-  const R& rhs;
+  expr_ref_t<L> lhs;
+  expr_ref_t<R> rhs;
 
  public:
+  using value_type = operand_value_t<L, R>;
+
   AddExpr(const L& l, const R& r) : lhs(l), rhs(r) {}
 
-  size_t size() const { return lhs.size(); }
+  size_t size() const { return shape_source(lhs, rhs).size(); }
 
-  auto extents() const { return lhs.extents(); }
+  auto extents() const { return shape_source(lhs, rhs).extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::merge_alias(lhs.alias(dest), rhs.alias(dest));
+  }
+
+  void prepare() const { lhs.prepare(); rhs.prepare(); }
+
+  // 以f变换各操作数后重建 用于广播下沉到叶节点
+  template <class F>
+  auto map_operands(F f) const {
+    auto l = f(lhs);
+    auto r = f(rhs);
+    return AddExpr<decltype(l), decltype(r), Policy>(l, r);
+  }
 
   template <typename T>
   typename simd<T>::type eval_simd(size_t i) const {
-    auto l = lhs.template eval_simd<T>(i);
-    auto r = rhs.template eval_simd<T>(i);
-    return simd<T>::add(l, r);
+    if constexpr (is_mul_expr_v<L>) {
+      // a * b + c
+      return simd<T>::fmadd(lhs.left().template eval_simd<T>(i), lhs.right().template eval_simd<T>(i),
+                            rhs.template eval_simd<T>(i));
+    } else if constexpr (is_mul_expr_v<R>) {
+      // c + a * b
+      return simd<T>::fmadd(rhs.left().template eval_simd<T>(i), rhs.right().template eval_simd<T>(i),
+                            lhs.template eval_simd<T>(i));
+    } else {
+      auto l = lhs.template eval_simd<T>(i);
+      auto r = rhs.template eval_simd<T>(i);
+      return simd<T>::add(l, r);
+    }
   }
 
   template <typename T>
   typename simd<T>::type eval_simd_mask(size_t i) const {
-    auto l = lhs.template eval_simd_mask<T>(i);
-    auto r = rhs.template eval_simd_mask<T>(i);
-    return simd<T>::add(l, r);
+    if constexpr (is_mul_expr_v<L>) {
+      return simd<T>::fmadd(lhs.left().template eval_simd_mask<T>(i), lhs.right().template eval_simd_mask<T>(i),
+                            rhs.template eval_simd_mask<T>(i));
+    } else if constexpr (is_mul_expr_v<R>) {
+      return simd<T>::fmadd(rhs.left().template eval_simd_mask<T>(i), rhs.right().template eval_simd_mask<T>(i),
+                            lhs.template eval_simd_mask<T>(i));
+    } else {
+      auto l = lhs.template eval_simd_mask<T>(i);
+      auto r = rhs.template eval_simd_mask<T>(i);
+      return simd<T>::add(l, r);
+    }
   }
 };
 
 template <class L, class R, class Policy>
 class SubExpr : public TensorExpr<SubExpr<L, R, Policy>, Policy> {
-  const L& lhs;
-  const R& rhs;
+  expr_ref_t<L> lhs;
+  expr_ref_t<R> rhs;
 
  public:
+  using value_type = operand_value_t<L, R>;
+
   SubExpr(const L& l, const R& r) : lhs(l), rhs(r) {}
 
-  size_t size() const { return lhs.size(); }
+  size_t size() const { return shape_source(lhs, rhs).size(); }
 
-  auto extents() const { return lhs.extents(); }
+  auto extents() const { return shape_source(lhs, rhs).extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::merge_alias(lhs.alias(dest), rhs.alias(dest));
+  }
+
+  void prepare() const { lhs.prepare(); rhs.prepare(); }
+
+  template <class F>
+  auto map_operands(F f) const {
+    auto l = f(lhs);
+    auto r = f(rhs);
+    return SubExpr<decltype(l), decltype(r), Policy>(l, r);
+  }
 
   template <class T>
   typename simd<T>::type eval_simd(size_t i) const {
-    auto l = lhs.template eval_simd<T>(i);
-    auto r = rhs.template eval_simd<T>(i);
-    return simd<T>::sub(l, r);
+    if constexpr (is_mul_expr_v<L>) {
+      // a * b - c
+      return simd<T>::fmsub(lhs.left().template eval_simd<T>(i), lhs.right().template eval_simd<T>(i),
+                            rhs.template eval_simd<T>(i));
+    } else if constexpr (is_mul_expr_v<R>) {
+      // c - a * b
+      return simd<T>::fnmadd(rhs.left().template eval_simd<T>(i), rhs.right().template eval_simd<T>(i),
+                             lhs.template eval_simd<T>(i));
+    } else {
+      auto l = lhs.template eval_simd<T>(i);
+      auto r = rhs.template eval_simd<T>(i);
+      return simd<T>::sub(l, r);
+    }
   }
 
   template <class T>
   typename simd<T>::type eval_simd_mask(size_t i) const {
-    auto l = lhs.template eval_simd_mask<T>(i);
-    auto r = rhs.template eval_simd_mask<T>(i);
-    return simd<T>::sub(l, r);
+    if constexpr (is_mul_expr_v<L>) {
+      return simd<T>::fmsub(lhs.left().template eval_simd_mask<T>(i), lhs.right().template eval_simd_mask<T>(i),
+                            rhs.template eval_simd_mask<T>(i));
+    } else if constexpr (is_mul_expr_v<R>) {
+      return simd<T>::fnmadd(rhs.left().template eval_simd_mask<T>(i), rhs.right().template eval_simd_mask<T>(i),
+                             lhs.template eval_simd_mask<T>(i));
+    } else {
+      auto l = lhs.template eval_simd_mask<T>(i);
+      auto r = rhs.template eval_simd_mask<T>(i);
+      return simd<T>::sub(l, r);
+    }
   }
 };
 
 template <typename L, typename R, class Policy>
 class MulExpr : public TensorExpr<MulExpr<L, R, Policy>, Policy> {
-  const L& lhs;
-  const R& rhs;
+  expr_ref_t<L> lhs;
+  expr_ref_t<R> rhs;
 
  public:
+  using value_type = operand_value_t<L, R>;
+
   MulExpr(const L& l, const R& r) : lhs(l), rhs(r) {}
 
-  size_t size() const { return lhs.size(); }
+  size_t size() const { return shape_source(lhs, rhs).size(); }
 
-  auto extents() const { return lhs.extents(); }
+  auto extents() const { return shape_source(lhs, rhs).extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::merge_alias(lhs.alias(dest), rhs.alias(dest));
+  }
+
+  void prepare() const { lhs.prepare(); rhs.prepare(); }
+
+  template <class F>
+  auto map_operands(F f) const {
+    auto l = f(lhs);
+    auto r = f(rhs);
+    return MulExpr<decltype(l), decltype(r), Policy>(l, r);
+  }
+
+  // 供外层加减法融合乘加使用
+  const L& left() const { return lhs; }
+
+  const R& right() const { return rhs; }
 
   template <class T>
   typename simd<T>::type eval_simd(size_t i) const {
@@ -87,15 +188,30 @@ class MulExpr : public TensorExpr<MulExpr<L, R, Policy>, Policy> {
 
 template <class L, class R, class Policy>
 class DivExpr : public TensorExpr<DivExpr<L, R, Policy>, Policy> {
-  const L& lhs;
-  const R& rhs;
+  expr_ref_t<L> lhs;
+  expr_ref_t<R> rhs;
 
  public:
+  using value_type = operand_value_t<L, R>;
+
   DivExpr(const L& l, const R& r) : lhs(l), rhs(r) {}
 
-  size_t size() const { return lhs.size(); }
+  size_t size() const { return shape_source(lhs, rhs).size(); }
 
-  auto extents() const { return lhs.extents(); }
+  auto extents() const { return shape_source(lhs, rhs).extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::merge_alias(lhs.alias(dest), rhs.alias(dest));
+  }
+
+  void prepare() const { lhs.prepare(); rhs.prepare(); }
+
+  template <class F>
+  auto map_operands(F f) const {
+    auto l = f(lhs);
+    auto r = f(rhs);
+    return DivExpr<decltype(l), decltype(r), Policy>(l, r);
+  }
 
   template <typename T>
   typename simd<T>::type eval_simd(size_t i) const {
@@ -112,4 +228,54 @@ class DivExpr : public TensorExpr<DivExpr<L, R, Policy>, Policy> {
   }
 };
 
+// 向量 / 浮点标量 乘以构造时计算的倒数 结果与除法至多相差1 ULP 除数为2的幂时完全一致
+// 倒数为非正规数或上溢时退回除法 见md::detail::use_reciprocal
+// S为倒数的存储类型 取表达式计算类型与标量类型的公共类型 提升计算时不损失倒数精度
+template <class L, class S, class Policy>
+class ScalarDivExpr : public TensorExpr<ScalarDivExpr<L, S, Policy>, Policy> {
+  using C = compute_type_t<typename L::value_type>;
+
+  expr_ref_t<L> lhs;
+  ScalarWrapper<S, Policy> divisor_;
+  ScalarWrapper<S, Policy> reciprocal_;
+  bool use_reciprocal_;
+
+ public:
+  using value_type = typename L::value_type;
+
+  ScalarDivExpr(const L& l, S d)
+      : lhs(l),
+        divisor_(d),
+        reciprocal_(S(1) / d),
+        use_reciprocal_(md::detail::use_reciprocal(d) && md::detail::use_reciprocal(static_cast<C>(d))) {}
+
+  size_t size() const { return lhs.size(); }
+
+  auto extents() const { return lhs.extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const { return lhs.alias(dest); }
+
+  void prepare() const { lhs.prepare(); }
+
+  template <class F>
+  auto map_operands(F f) const {
+    auto l = f(lhs);
+    return ScalarDivExpr<decltype(l), S, Policy>(l, divisor_.value());
+  }
+
+  template <typename T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    auto l = lhs.template eval_simd<T>(i);
+    return use_reciprocal_ ? simd<T>::mul(l, reciprocal_.template eval_simd<T>(i))
+                           : simd<T>::div(l, divisor_.template eval_simd<T>(i));
+  }
+
+  template <typename T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    auto l = lhs.template eval_simd_mask<T>(i);
+    return use_reciprocal_ ? simd<T>::mul(l, reciprocal_.template eval_simd<T>(i))
+                           : simd<T>::div(l, divisor_.template eval_simd<T>(i));
+  }
+};
+
 #endif  // __MDVECTOR_CALCULATION_EXPR_H__
\ No newline at end of file
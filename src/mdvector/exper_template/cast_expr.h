@@ -0,0 +1,120 @@
+#ifndef __MDVECTOR_CAST_EXPR_H__
+#define __MDVECTOR_CAST_EXPR_H__
+
+#include "scalar_expr.h"
+
+// ======================== 类型转换表达式 ========================
+// 内部表达式按源计算类型S求值 转换与计算在同一次遍历中完成 不生成中间数组
+// 同宽度(float <-> int32_t): 逐通道转换
+// 收窄(double -> float): 内部表达式求值两次 合并为一个simd<T> 更多段时(double -> uint8_t)经缓冲区逐元素转换
+// 浮点扩展(float -> double)与叶节点: 直接按目标类型求值 叶节点加载时转换 精度不低于源类型
+// 整数源扩展(int32_t -> double, int32_t -> int64_t): 内部表达式须按源类型运算(如整数除法与回绕)
+//   在所在的源pack按源类型求值 取其中对应的一段转换 每个源pack求值pack_size之比次
+// 转换作用于计算类型 外层按更宽类型计算时(如cast<float>(d) + d) 不做中间舍入
+template <class E, class U, class Policy>
+class CastExpr : public TensorExpr<CastExpr<E, U, Policy>, Policy> {
+  expr_ref_t<E> expr;
+
+  using S = compute_type_t<typename E::value_type>;
+
+  // 按目标类型求值与按源类型求值结果相同: 浮点之间扩展 或叶节点(加载时逐元素转换)
+  static constexpr bool widen_direct =
+      (std::is_floating_point_v<S> && std::is_floating_point_v<U>) || held_by_ref<E>::value || is_scalar_expr_v<E>;
+
+  // 扩展: 下标i所在的源pack按源类型求值 转换其中从i开始的simd<T>::pack_size个元素
+  template <class T>
+  typename simd<T>::type widen_part(size_t i) const {
+    constexpr size_t ps = simd<S>::pack_size;
+    const size_t i0 = i - i % ps;
+    alignas(simd<S>::alignment) S buf[ps];
+    simd<S>::store(buf, i0 + ps <= size() ? expr.template eval_simd<S>(i0) : expr.template eval_simd_mask<S>(i0));
+    return simd_convert<S, T>::loadu(buf + (i - i0));
+  }
+
+  // 多段收窄(如double -> uint8_t): 从i开始的simd<T>::pack_size个元素逐段按源类型求值 写入缓冲后转换
+  template <class T>
+  typename simd<T>::type narrow_packs(size_t i) const {
+    constexpr size_t ps = simd<S>::pack_size;
+    constexpr size_t pt = simd<T>::pack_size;
+    static_assert(pt % ps == 0, "unsupported cast between element types");
+    alignas(simd<S>::alignment) S buf[pt] = {};
+    const size_t n = size();
+    for (size_t k = 0; k < pt && i + k < n; k += ps) {
+      const size_t j = i + k;
+      simd<S>::store(buf + k, j + ps <= n ? expr.template eval_simd<S>(j) : expr.template eval_simd_mask<S>(j));
+    }
+    return simd_convert<S, T>::loadu(buf);
+  }
+
+ public:
+  using value_type = U;
+
+  explicit CastExpr(const E& e) : expr(e) {}
+
+  size_t size() const { return expr.size(); }
+
+  auto extents() const { return expr.extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const { return expr.alias(dest); }
+
+  void prepare() const { expr.prepare(); }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    constexpr size_t ps = simd<S>::pack_size;
+    constexpr size_t pt = simd<T>::pack_size;
+    if constexpr (std::is_same_v<S, T>) {
+      return expr.template eval_simd<T>(i);
+    } else if constexpr (ps == pt) {
+      return simd_convert<S, T>::apply(expr.template eval_simd<S>(i));
+    } else if constexpr (pt < ps) {
+      if constexpr (widen_direct) {
+        return expr.template eval_simd<T>(i);
+      } else {
+        return widen_part<T>(i);
+      }
+    } else if constexpr (pt == 2 * ps) {
+      return simd_convert<S, T>::narrow(expr.template eval_simd<S>(i), expr.template eval_simd<S>(i + ps));
+    } else {
+      return narrow_packs<T>(i);
+    }
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    constexpr size_t ps = simd<S>::pack_size;
+    constexpr size_t pt = simd<T>::pack_size;
+    if constexpr (std::is_same_v<S, T>) {
+      return expr.template eval_simd_mask<T>(i);
+    } else if constexpr (ps == pt) {
+      return simd_convert<S, T>::apply(expr.template eval_simd_mask<S>(i));
+    } else if constexpr (pt < ps) {
+      if constexpr (widen_direct) {
+        return expr.template eval_simd_mask<T>(i);
+      } else {
+        return widen_part<T>(i);  // 尾部之外的通道由外层掩码写回丢弃
+      }
+    } else if constexpr (pt == 2 * ps) {
+      // 尾部不足两段 前段可能完整 后段可能为空
+      const size_t n = size();
+      const auto lo = i + ps <= n ? expr.template eval_simd<S>(i) : expr.template eval_simd_mask<S>(i);
+      const auto hi = i + ps < n ? expr.template eval_simd_mask<S>(i + ps) : simd<S>::set1(S(0));
+      return simd_convert<S, T>::narrow(lo, hi);
+    } else {
+      return narrow_packs<T>(i);
+    }
+  }
+};
+
+// ======================== 类型转换 ========================
+// 例: double s = md::sum(md::cast<double>(f) * d); mdvector_2d<float> r = md::cast<float>(a * b);
+namespace md {
+
+template <class U, class E, class Policy>
+CastExpr<E, U, Policy> cast(const TensorExpr<E, Policy>& x) {
+  return CastExpr<E, U, Policy>(x.derived());
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_CAST_EXPR_H__
@@ -0,0 +1,206 @@
+#ifndef __MDVECTOR_COMPARE_EXPR_H__
+#define __MDVECTOR_COMPARE_EXPR_H__
+
+#include "scalar_expr.h"
+
+// ======================== 掩码表达式基类 ========================
+// 比较运算的惰性结果 eval_simd/eval_simd_mask返回simd<T>::mask_type
+// 只能作为where的条件或参与逻辑运算 不能直接写入mdvector
+template <class Derived, class Policy>
+class MaskExpr {
+ public:
+  const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+  size_t size() const { return derived().size(); }
+
+  auto extents() const { return derived().extents(); }
+};
+
+// ======================== 比较运算 ========================
+struct LtOp {
+  template <class T>
+  static typename simd<T>::mask_type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::cmp_lt(a, b);
+  }
+};
+
+struct LeOp {
+  template <class T>
+  static typename simd<T>::mask_type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::cmp_le(a, b);
+  }
+};
+
+struct GtOp {
+  template <class T>
+  static typename simd<T>::mask_type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::cmp_lt(b, a);
+  }
+};
+
+struct GeOp {
+  template <class T>
+  static typename simd<T>::mask_type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::cmp_le(b, a);
+  }
+};
+
+struct EqOp {
+  template <class T>
+  static typename simd<T>::mask_type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::cmp_eq(a, b);
+  }
+};
+
+// 与标量语义一致 含NaN时为真
+struct NeOp {
+  template <class T>
+  static typename simd<T>::mask_type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::cmp_ne(a, b);
+  }
+};
+
+struct MaskAndOp {
+  template <class T>
+  static typename simd<T>::mask_type apply(typename simd<T>::mask_type a, typename simd<T>::mask_type b) {
+    return simd<T>::mask_and(a, b);
+  }
+};
+
+struct MaskOrOp {
+  template <class T>
+  static typename simd<T>::mask_type apply(typename simd<T>::mask_type a, typename simd<T>::mask_type b) {
+    return simd<T>::mask_or(a, b);
+  }
+};
+
+// ======================== 比较表达式 ========================
+template <class L, class R, class Op, class Policy>
+class CompareExpr : public MaskExpr<CompareExpr<L, R, Op, Policy>, Policy> {
+  expr_ref_t<L> lhs;
+  expr_ref_t<R> rhs;
+
+ public:
+  using value_type = operand_value_t<L, R>;
+
+  CompareExpr(const L& l, const R& r) : lhs(l), rhs(r) {}
+
+  size_t size() const { return shape_source(lhs, rhs).size(); }
+
+  auto extents() const { return shape_source(lhs, rhs).extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::merge_alias(lhs.alias(dest), rhs.alias(dest));
+  }
+
+  void prepare() const { lhs.prepare(); rhs.prepare(); }
+
+  template <class T>
+  typename simd<T>::mask_type eval_simd(size_t i) const {
+    return Op::template apply<T>(lhs.template eval_simd<T>(i), rhs.template eval_simd<T>(i));
+  }
+
+  template <class T>
+  typename simd<T>::mask_type eval_simd_mask(size_t i) const {
+    return Op::template apply<T>(lhs.template eval_simd_mask<T>(i), rhs.template eval_simd_mask<T>(i));
+  }
+};
+
+// ======================== 掩码逻辑表达式 ========================
+template <class L, class R, class Op, class Policy>
+class MaskBinaryExpr : public MaskExpr<MaskBinaryExpr<L, R, Op, Policy>, Policy> {
+  expr_ref_t<L> lhs;
+  expr_ref_t<R> rhs;
+
+ public:
+  using value_type = typename L::value_type;
+
+  MaskBinaryExpr(const L& l, const R& r) : lhs(l), rhs(r) {}
+
+  size_t size() const { return lhs.size(); }
+
+  auto extents() const { return lhs.extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::merge_alias(lhs.alias(dest), rhs.alias(dest));
+  }
+
+  void prepare() const { lhs.prepare(); rhs.prepare(); }
+
+  template <class T>
+  typename simd<T>::mask_type eval_simd(size_t i) const {
+    return Op::template apply<T>(lhs.template eval_simd<T>(i), rhs.template eval_simd<T>(i));
+  }
+
+  template <class T>
+  typename simd<T>::mask_type eval_simd_mask(size_t i) const {
+    return Op::template apply<T>(lhs.template eval_simd_mask<T>(i), rhs.template eval_simd_mask<T>(i));
+  }
+};
+
+template <class E, class Policy>
+class MaskNotExpr : public MaskExpr<MaskNotExpr<E, Policy>, Policy> {
+  expr_ref_t<E> expr;
+
+ public:
+  using value_type = typename E::value_type;
+
+  explicit MaskNotExpr(const E& e) : expr(e) {}
+
+  size_t size() const { return expr.size(); }
+
+  auto extents() const { return expr.extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const { return expr.alias(dest); }
+
+  void prepare() const { expr.prepare(); }
+
+  template <class T>
+  typename simd<T>::mask_type eval_simd(size_t i) const {
+    return simd<T>::mask_not(expr.template eval_simd<T>(i));
+  }
+
+  template <class T>
+  typename simd<T>::mask_type eval_simd_mask(size_t i) const {
+    return simd<T>::mask_not(expr.template eval_simd_mask<T>(i));
+  }
+};
+
+// ======================== 条件选择表达式 ========================
+// where(cond, a, b) 逐元素cond ? a : b 两侧均计算后混合 无分支
+// 条件与a, b按同一计算类型求值 条件为浮点而a, b为整数时(如where(x < 2.5, 1, 0))按浮点计算 比较不截断
+template <class C, class A, class B, class Policy>
+class WhereExpr : public TensorExpr<WhereExpr<C, A, B, Policy>, Policy> {
+  expr_ref_t<C> cond;
+  expr_ref_t<A> a_;
+  expr_ref_t<B> b_;
+
+ public:
+  using value_type = promote_scalar_t<operand_value_t<A, B>, compute_type_t<typename C::value_type>>;
+
+  // a, b已由md::where广播到公共形状
+  WhereExpr(const C& c, const A& a, const B& b) : cond(c), a_(a), b_(b) { require_same_shape(a, b); }
+
+  size_t size() const { return shape_source(a_, b_, cond).size(); }
+
+  auto extents() const { return shape_source(a_, b_, cond).extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::merge_alias(cond.alias(dest), a_.alias(dest), b_.alias(dest));
+  }
+
+  void prepare() const { cond.prepare(); a_.prepare(); b_.prepare(); }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    return simd<T>::select(cond.template eval_simd<T>(i), a_.template eval_simd<T>(i), b_.template eval_simd<T>(i));
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    return simd<T>::select(cond.template eval_simd_mask<T>(i), a_.template eval_simd_mask<T>(i),
+                           b_.template eval_simd_mask<T>(i));
+  }
+};
+
+#endif  // __MDVECTOR_COMPARE_EXPR_H__
@@ -0,0 +1,285 @@
+#ifndef __MDVECTOR_FUNCTION_H__
+#define __MDVECTOR_FUNCTION_H__
+
+#include "broadcast_expr.h"
+#include "compare_expr.h"
+#include "function_expr.h"
+
+// ======================== 元素级数学函数 ========================
+// 返回惰性表达式 与四则运算组合后在同一次eval_to中计算
+// 例: r = md::exp(-a * b) * md::sin(c);
+namespace md {
+
+template <class E, class Policy>
+UnaryExpr<E, ExpOp, Policy> exp(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, ExpOp, Policy>(x.derived());
+}
+
+template <class E, class Policy>
+UnaryExpr<E, LogOp, Policy> log(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, LogOp, Policy>(x.derived());
+}
+
+template <class E, class Policy>
+UnaryExpr<E, SinOp, Policy> sin(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, SinOp, Policy>(x.derived());
+}
+
+template <class E, class Policy>
+UnaryExpr<E, CosOp, Policy> cos(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, CosOp, Policy>(x.derived());
+}
+
+template <class E, class Policy>
+UnaryExpr<E, TanOp, Policy> tan(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, TanOp, Policy>(x.derived());
+}
+
+// 激活/特殊函数 模板参数选择精度档 默认accurate
+// 例: r = md::tanh(x) * md::sigmoid<md::fast_math>(y);
+template <math_precision P = accurate_math, class E, class Policy>
+UnaryExpr<E, TanhOp<P>, Policy> tanh(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, TanhOp<P>, Policy>(x.derived());
+}
+
+template <math_precision P = accurate_math, class E, class Policy>
+UnaryExpr<E, SigmoidOp<P>, Policy> sigmoid(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, SigmoidOp<P>, Policy>(x.derived());
+}
+
+template <math_precision P = accurate_math, class E, class Policy>
+UnaryExpr<E, ErfOp<P>, Policy> erf(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, ErfOp<P>, Policy>(x.derived());
+}
+
+template <math_precision P = accurate_math, class E, class Policy>
+UnaryExpr<E, SoftplusOp<P>, Policy> softplus(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, SoftplusOp<P>, Policy>(x.derived());
+}
+
+// 除法 模板参数选择精度档 accurate与运算符/相同
+// fast: 近似倒数(rcp_ps/rcp14)经牛顿迭代 误差 <= 3 ULP 吞吐接近乘法
+// 例: r = md::div<md::fast_math>(a, b + 1.0f);
+template <math_precision P = accurate_math, class L, class R, class PL, class PR>
+auto div(const TensorExpr<L, PL>& x, const TensorExpr<R, PR>& y) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<BinaryExpr, DivOp<P>, Policy>(x.derived(), y.derived());
+}
+
+// div(向量, 标量) 两档均为乘以标量倒数
+template <math_precision P = accurate_math, class L, class T, class Policy,
+          typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto div(const TensorExpr<L, Policy>& x, T y) {
+  return x / y;
+}
+
+// div(标量, 向量)
+template <math_precision P = accurate_math, class R, class T, class Policy,
+          typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto div(T x, const TensorExpr<R, Policy>& y) {
+  return BinaryExpr<ScalarWrapper<T, Policy>, R, DivOp<P>, Policy>(ScalarWrapper<T, Policy>(x), y.derived());
+}
+
+// atan2(向量, 向量)
+template <class L, class R, class PL, class PR>
+auto atan2(const TensorExpr<L, PL>& y, const TensorExpr<R, PR>& x) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<BinaryExpr, Atan2Op, Policy>(y.derived(), x.derived());
+}
+
+// atan2(向量, 标量)
+template <class L, class T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto atan2(const TensorExpr<L, Policy>& y, T x) {
+  return BinaryExpr<L, ScalarWrapper<T, Policy>, Atan2Op, Policy>(y.derived(), ScalarWrapper<T, Policy>(x));
+}
+
+// atan2(标量, 向量)
+template <class R, class T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto atan2(T y, const TensorExpr<R, Policy>& x) {
+  return BinaryExpr<ScalarWrapper<T, Policy>, R, Atan2Op, Policy>(ScalarWrapper<T, Policy>(y), x.derived());
+}
+
+// pow(向量, 向量)
+template <class L, class R, class PL, class PR>
+auto pow(const TensorExpr<L, PL>& x, const TensorExpr<R, PR>& y) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<BinaryExpr, PowOp, Policy>(x.derived(), y.derived());
+}
+
+// pow(向量, 标量) 整数与±0.5指数走乘法/开方快速路径
+template <class L, class T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+PowScalarExpr<L, Policy> pow(const TensorExpr<L, Policy>& x, T y) {
+  return PowScalarExpr<L, Policy>(x.derived(), static_cast<double>(y));
+}
+
+// pow<N>(向量) / pow<N, 2>(向量) 编译期整数或半整数指数
+// 例: r = md::pow<3>(x) + md::pow<-1, 2>(y);
+template <int N, int D = 1, class E, class Policy>
+UnaryExpr<E, PowNOp<N, D>, Policy> pow(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, PowNOp<N, D>, Policy>(x.derived());
+}
+
+// pow(标量, 向量)
+template <class R, class T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto pow(T x, const TensorExpr<R, Policy>& y) {
+  return BinaryExpr<ScalarWrapper<T, Policy>, R, PowOp, Policy>(ScalarWrapper<T, Policy>(x), y.derived());
+}
+
+// polyval(向量, 系数) 多项式求值 系数按最高次项在前(同numpy.polyval) 单次遍历无中间数组
+// 编译期项数(C数组/std::array)展开为fmadd链 模板参数选择md::horner(默认)或md::estrin
+// 运行期项数(std::vector)为Horner循环
+// 例: r = md::polyval(x, {c6, c5, c4, c3, c2, c1, c0}) * gain;
+//     r = md::polyval<md::estrin>(x, coef_array);
+template <poly_scheme S = horner, class E, class Policy, class K, size_t N>
+PolyvalExpr<E, K, N, S, Policy> polyval(const TensorExpr<E, Policy>& x, const K (&coef)[N]) {
+  return PolyvalExpr<E, K, N, S, Policy>(x.derived(), coef, N);
+}
+
+template <poly_scheme S = horner, class E, class Policy, class K, size_t N>
+PolyvalExpr<E, K, N, S, Policy> polyval(const TensorExpr<E, Policy>& x, const std::array<K, N>& coef) {
+  return PolyvalExpr<E, K, N, S, Policy>(x.derived(), coef.data(), N);
+}
+
+template <poly_scheme S = horner, class E, class Policy, class K>
+PolyvalExpr<E, K, 0, S, Policy> polyval(const TensorExpr<E, Policy>& x, const std::vector<K>& coef) {
+  return PolyvalExpr<E, K, 0, S, Policy>(x.derived(), coef.data(), coef.size());
+}
+
+template <class E, class Policy>
+UnaryExpr<E, SqrtOp, Policy> sqrt(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, SqrtOp, Policy>(x.derived());
+}
+
+template <class E, class Policy>
+UnaryExpr<E, AbsOp, Policy> abs(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, AbsOp, Policy>(x.derived());
+}
+
+template <class E, class Policy>
+UnaryExpr<E, FloorOp, Policy> floor(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, FloorOp, Policy>(x.derived());
+}
+
+template <class E, class Policy>
+UnaryExpr<E, CeilOp, Policy> ceil(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, CeilOp, Policy>(x.derived());
+}
+
+// 就近取整 中间值取偶
+template <class E, class Policy>
+UnaryExpr<E, RoundOp, Policy> round(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, RoundOp, Policy>(x.derived());
+}
+
+// min(向量, 向量)
+template <class L, class R, class PL, class PR>
+auto min(const TensorExpr<L, PL>& a, const TensorExpr<R, PR>& b) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<BinaryExpr, MinOp, Policy>(a.derived(), b.derived());
+}
+
+// min(向量, 标量)
+template <class L, class T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto min(const TensorExpr<L, Policy>& a, T b) {
+  return BinaryExpr<L, ScalarWrapper<T, Policy>, MinOp, Policy>(a.derived(), ScalarWrapper<T, Policy>(b));
+}
+
+// min(标量, 向量)
+template <class R, class T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto min(T a, const TensorExpr<R, Policy>& b) {
+  return BinaryExpr<ScalarWrapper<T, Policy>, R, MinOp, Policy>(ScalarWrapper<T, Policy>(a), b.derived());
+}
+
+// max(向量, 向量)
+template <class L, class R, class PL, class PR>
+auto max(const TensorExpr<L, PL>& a, const TensorExpr<R, PR>& b) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<BinaryExpr, MaxOp, Policy>(a.derived(), b.derived());
+}
+
+// max(向量, 标量)
+template <class L, class T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto max(const TensorExpr<L, Policy>& a, T b) {
+  return BinaryExpr<L, ScalarWrapper<T, Policy>, MaxOp, Policy>(a.derived(), ScalarWrapper<T, Policy>(b));
+}
+
+// max(标量, 向量)
+template <class R, class T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto max(T a, const TensorExpr<R, Policy>& b) {
+  return BinaryExpr<ScalarWrapper<T, Policy>, R, MaxOp, Policy>(ScalarWrapper<T, Policy>(a), b.derived());
+}
+
+// clamp(向量, 标量下界, 标量上界)
+template <class E, class T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto clamp(const TensorExpr<E, Policy>& x, T lo, T hi) {
+  using Scalar = ScalarWrapper<T, Policy>;
+  return TernaryExpr<E, Scalar, Scalar, ClampOp, Policy>(x.derived(), Scalar(lo), Scalar(hi));
+}
+
+// clamp(向量, 向量下界, 向量上界) 三者按广播规则对齐
+template <class E, class L, class H, class PE, class PL, class PH>
+auto clamp(const TensorExpr<E, PE>& x, const TensorExpr<L, PL>& lo, const TensorExpr<H, PH>& hi) {
+  using Policy = common_policy_t<PE, PL, PH>;
+  const auto xl = detail::broadcast_shape(x.derived().extents(), lo.derived().extents());
+  const auto extents = detail::broadcast_shape(xl, hi.derived().extents());
+  auto bx = detail::broadcast_operand<Policy>(x.derived(), extents);
+  auto bl = detail::broadcast_operand<Policy>(lo.derived(), extents);
+  auto bh = detail::broadcast_operand<Policy>(hi.derived(), extents);
+  return TernaryExpr<decltype(bx), decltype(bl), decltype(bh), ClampOp, Policy>(bx, bl, bh);
+}
+
+// ======================== 广播 ========================
+// broadcast_to(向量, 形状) 按尾部维对齐以步长0重复到目标形状 不生成展开后的副本
+// 两个数组操作数的运算与比较已按公共形状自动广播 需要广播到指定形状(如写入更大的目标)时显式调用
+// 例: plane = md::broadcast_to(col, plane.shapes());
+template <class E, class Policy, size_t Rank>
+BroadcastExpr<E, Rank, Policy> broadcast_to(const TensorExpr<E, Policy>& x, const std::array<size_t, Rank>& shape) {
+  return BroadcastExpr<E, Rank, Policy>(x.derived(), shape);
+}
+
+// ======================== 条件选择 ========================
+// where(cond, a, b) 逐元素cond ? a : b 编译为blend/掩码混合指令 无分支
+// a, b按广播规则对齐到与cond的公共形状 cond本身不广播
+// 例: r = md::where(x < 0.0, -x * 0.5, x);
+// where(掩码, 向量, 向量)
+template <class C, class A, class B, class PC, class PA, class PB>
+auto where(const MaskExpr<C, PC>& cond, const TensorExpr<A, PA>& a, const TensorExpr<B, PB>& b) {
+  using Policy = common_policy_t<PC, PA, PB>;
+  const auto ab = detail::broadcast_shape(a.derived().extents(), b.derived().extents());
+  const auto extents = detail::broadcast_shape(cond.derived().extents(), ab);
+  detail::require_mask_size(cond.derived(), extents);
+  auto ba = detail::broadcast_operand<Policy>(a.derived(), extents);
+  auto bb = detail::broadcast_operand<Policy>(b.derived(), extents);
+  return WhereExpr<C, decltype(ba), decltype(bb), Policy>(cond.derived(), ba, bb);
+}
+
+// where(掩码, 向量, 标量)
+template <class C, class A, class T, class PC, class PA, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto where(const MaskExpr<C, PC>& cond, const TensorExpr<A, PA>& a, T b) {
+  using Policy = common_policy_t<PC, PA>;
+  const auto extents = detail::broadcast_shape(cond.derived().extents(), a.derived().extents());
+  detail::require_mask_size(cond.derived(), extents);
+  auto ba = detail::broadcast_operand<Policy>(a.derived(), extents);
+  return WhereExpr<C, decltype(ba), ScalarWrapper<T, Policy>, Policy>(cond.derived(), ba, ScalarWrapper<T, Policy>(b));
+}
+
+// where(掩码, 标量, 向量)
+template <class C, class B, class T, class PC, class PB, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto where(const MaskExpr<C, PC>& cond, T a, const TensorExpr<B, PB>& b) {
+  using Policy = common_policy_t<PC, PB>;
+  const auto extents = detail::broadcast_shape(cond.derived().extents(), b.derived().extents());
+  detail::require_mask_size(cond.derived(), extents);
+  auto bb = detail::broadcast_operand<Policy>(b.derived(), extents);
+  return WhereExpr<C, ScalarWrapper<T, Policy>, decltype(bb), Policy>(cond.derived(), ScalarWrapper<T, Policy>(a), bb);
+}
+
+// where(掩码, 标量, 标量)
+template <class C, class T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto where(const MaskExpr<C, Policy>& cond, T a, T b) {
+  return WhereExpr<C, ScalarWrapper<T, Policy>, ScalarWrapper<T, Policy>, Policy>(
+      cond.derived(), ScalarWrapper<T, Policy>(a), ScalarWrapper<T, Policy>(b));
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_FUNCTION_H__
@@ -0,0 +1,441 @@
+#ifndef __MDVECTOR_FUNCTION_EXPR_H__
+#define __MDVECTOR_FUNCTION_EXPR_H__
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "../simd/simd_math.h"
+#include "scalar_expr.h"
+
+// ======================== 函数运算 ========================
+struct ExpOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd_exp<T>(x);
+  }
+};
+
+struct LogOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd_log<T>(x);
+  }
+};
+
+struct SinOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd_sin<T>(x);
+  }
+};
+
+struct CosOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd_cos<T>(x);
+  }
+};
+
+struct TanOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd_tan<T>(x);
+  }
+};
+
+struct Atan2Op {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type y, typename simd<T>::type x) {
+    return simd_atan2<T>(y, x);
+  }
+};
+
+struct PowOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x, typename simd<T>::type y) {
+    return simd_pow<T>(x, y);
+  }
+};
+
+// x^(N/D) D为1或2 编译期展开为平方乘链 D == 2时先开方 负指数取倒数
+// 例: pow<3>(x) = x*x*x 的两次乘法  pow<-1, 2>(x) = 1 / sqrt(x)
+template <int N, int D>
+struct PowNOp {
+  static_assert(D == 1 || D == 2, "pow<N, D> supports D = 1 or 2");
+
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    static_assert((N >= 0 && D == 1) || std::is_floating_point_v<T>,
+                  "negative or fractional powers require a floating-point element type");
+    if constexpr (D == 2) {
+      x = simd_pow_half<T>(x);
+    }
+    constexpr unsigned m = N < 0 ? static_cast<unsigned>(-N) : static_cast<unsigned>(N);
+    const typename simd<T>::type r = simd_pow_n<T, m>(x);
+    if constexpr (N < 0) {
+      return simd<T>::div(simd<T>::set1(T(1)), r);
+    } else {
+      return r;
+    }
+  }
+};
+
+// 激活/特殊函数 P选择精度档 (md::accurate_math / md::fast_math)
+template <md::math_precision P>
+struct TanhOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd_tanh<T, P>(x);
+  }
+};
+
+template <md::math_precision P>
+struct SigmoidOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd_sigmoid<T, P>(x);
+  }
+};
+
+template <md::math_precision P>
+struct ErfOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd_erf<T, P>(x);
+  }
+};
+
+template <md::math_precision P>
+struct SoftplusOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd_softplus<T, P>(x);
+  }
+};
+
+// 除法 fast档以近似倒数加牛顿迭代代替除法指令 整数元素类型保持除法
+template <md::math_precision P>
+struct DivOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    if constexpr (P == md::math_precision::fast && std::is_floating_point_v<T>) {
+      return simd_div_fast<T>(a, b);
+    } else {
+      return simd<T>::div(a, b);
+    }
+  }
+};
+
+struct SqrtOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd<T>::sqrt(x);
+  }
+};
+
+struct AbsOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd<T>::abs(x);
+  }
+};
+
+struct NegOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd<T>::neg(x);
+  }
+};
+
+struct FloorOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd<T>::floor(x);
+  }
+};
+
+struct CeilOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd<T>::ceil(x);
+  }
+};
+
+struct RoundOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x) {
+    return simd<T>::round(x);
+  }
+};
+
+struct MinOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::min(a, b);
+  }
+};
+
+struct MaxOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::max(a, b);
+  }
+};
+
+struct ClampOp {
+  template <class T>
+  static typename simd<T>::type apply(typename simd<T>::type x, typename simd<T>::type lo,
+                                      typename simd<T>::type hi) {
+    return simd<T>::min(simd<T>::max(x, lo), hi);
+  }
+};
+
+// ======================== 一元函数表达式 ========================
+template <class E, class Op, class Policy>
+class UnaryExpr : public TensorExpr<UnaryExpr<E, Op, Policy>, Policy> {
+  expr_ref_t<E> expr;
+
+ public:
+  using value_type = typename E::value_type;
+
+  explicit UnaryExpr(const E& e) : expr(e) {}
+
+  size_t size() const { return expr.size(); }
+
+  auto extents() const { return expr.extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const { return expr.alias(dest); }
+
+  void prepare() const { expr.prepare(); }
+
+  // 以f变换各操作数后重建 用于广播下沉到叶节点
+  template <class F>
+  auto map_operands(F f) const {
+    auto e = f(expr);
+    return UnaryExpr<decltype(e), Op, Policy>(e);
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    return Op::template apply<T>(expr.template eval_simd<T>(i));
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    return Op::template apply<T>(expr.template eval_simd_mask<T>(i));
+  }
+};
+
+// ======================== 二元函数表达式 ========================
+template <class L, class R, class Op, class Policy>
+class BinaryExpr : public TensorExpr<BinaryExpr<L, R, Op, Policy>, Policy> {
+  expr_ref_t<L> lhs;
+  expr_ref_t<R> rhs;
+
+ public:
+  using value_type = operand_value_t<L, R>;
+
+  BinaryExpr(const L& l, const R& r) : lhs(l), rhs(r) {}
+
+  size_t size() const { return shape_source(lhs, rhs).size(); }
+
+  auto extents() const { return shape_source(lhs, rhs).extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::merge_alias(lhs.alias(dest), rhs.alias(dest));
+  }
+
+  void prepare() const { lhs.prepare(); rhs.prepare(); }
+
+  template <class F>
+  auto map_operands(F f) const {
+    auto l = f(lhs);
+    auto r = f(rhs);
+    return BinaryExpr<decltype(l), decltype(r), Op, Policy>(l, r);
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    auto l = lhs.template eval_simd<T>(i);
+    auto r = rhs.template eval_simd<T>(i);
+    return Op::template apply<T>(l, r);
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    auto l = lhs.template eval_simd_mask<T>(i);
+    auto r = rhs.template eval_simd_mask<T>(i);
+    return Op::template apply<T>(l, r);
+  }
+};
+
+// ======================== 标量指数幂表达式 ========================
+// 构造时按指数分类 每个pack只走一条与数据无关的分支
+// 整数指数(|y| <= 64)为平方乘 y = ±0.5为开方 其余为exp(y * log|x|)
+template <class E, class Policy>
+class PowScalarExpr : public TensorExpr<PowScalarExpr<E, Policy>, Policy> {
+  enum class Kind { Integer, Sqrt, RSqrt, General };
+
+  expr_ref_t<E> expr;
+  double exponent_;
+  long long n_ = 0;
+  Kind kind_ = Kind::General;
+
+  template <class T>
+  typename simd<T>::type apply(typename simd<T>::type x) const {
+    if constexpr (std::is_floating_point_v<T>) {
+      switch (kind_) {
+        case Kind::Integer:
+          return simd_pow_int<T>(x, n_);
+        case Kind::Sqrt:
+          return simd_pow_half<T>(x);
+        case Kind::RSqrt:
+          return simd<T>::div(simd<T>::set1(T(1)), simd_pow_half<T>(x));
+        default:
+          return simd_pow<T>(x, simd<T>::set1(static_cast<T>(exponent_)));
+      }
+    } else {
+      return simd_pow_int<T>(x, n_);
+    }
+  }
+
+ public:
+  using value_type = typename E::value_type;
+
+  PowScalarExpr(const E& e, double y) : expr(e), exponent_(y) {
+    if (y == std::nearbyint(y) && std::fabs(y) <= 64.0) {
+      kind_ = Kind::Integer;
+      n_ = static_cast<long long>(y);
+    } else if (y == 0.5) {
+      kind_ = Kind::Sqrt;
+    } else if (y == -0.5) {
+      kind_ = Kind::RSqrt;
+    }
+  }
+
+  size_t size() const { return expr.size(); }
+
+  auto extents() const { return expr.extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const { return expr.alias(dest); }
+
+  void prepare() const { expr.prepare(); }
+
+  template <class F>
+  auto map_operands(F f) const {
+    auto e = f(expr);
+    return PowScalarExpr<decltype(e), Policy>(e, exponent_);
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    return apply<T>(expr.template eval_simd<T>(i));
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    return apply<T>(expr.template eval_simd_mask<T>(i));
+  }
+};
+
+// ======================== 多项式表达式 ========================
+// polyval(x, coef) 系数按值保存 最高次项在前 在计算类型T下求值
+// N > 0: 编译期项数 std::array保存 fmadd链完全展开 Scheme选择Horner或Estrin
+// N == 0: 运行期项数 std::vector保存 Horner循环
+template <class E, class K, size_t N, md::poly_scheme Scheme, class Policy>
+class PolyvalExpr : public TensorExpr<PolyvalExpr<E, K, N, Scheme, Policy>, Policy> {
+  static_assert(std::is_arithmetic_v<K>, "polyval coefficients must be arithmetic");
+
+  expr_ref_t<E> expr;
+  std::conditional_t<N == 0, std::vector<K>, std::array<K, N>> coef_;
+
+  template <class T>
+  typename simd<T>::type apply(typename simd<T>::type x) const {
+    if constexpr (N == 0) {
+      return simd_horner<T>(x, coef_.data(), coef_.size());
+    } else if constexpr (Scheme == md::poly_scheme::estrin) {
+      return simd_estrin<T, N>(x, coef_.data());
+    } else {
+      return simd_horner<T>(x, coef_.data(), N);
+    }
+  }
+
+ public:
+  // 整数自变量与浮点系数按浮点计算 系数不截断
+  using value_type = promote_scalar_t<typename E::value_type, K>;
+
+  PolyvalExpr(const E& e, const K* coef, size_t n) : expr(e) {
+    if constexpr (N == 0) {
+      coef_.assign(coef, coef + n);
+    } else {
+      for (size_t k = 0; k < N; ++k) {
+        coef_[k] = coef[k];
+      }
+    }
+  }
+
+  size_t size() const { return expr.size(); }
+
+  auto extents() const { return expr.extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const { return expr.alias(dest); }
+
+  void prepare() const { expr.prepare(); }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    return apply<T>(expr.template eval_simd<T>(i));
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    return apply<T>(expr.template eval_simd_mask<T>(i));
+  }
+};
+
+// ======================== 三元函数表达式 ========================
+// 非标量操作数形状须相同(md::clamp已按广播规则对齐) 否则抛出std::invalid_argument
+template <class A, class B, class C, class Op, class Policy>
+class TernaryExpr : public TensorExpr<TernaryExpr<A, B, C, Op, Policy>, Policy> {
+  expr_ref_t<A> a_;
+  expr_ref_t<B> b_;
+  expr_ref_t<C> c_;
+
+ public:
+  using value_type = operand_value_t<A, B, C>;
+
+  TernaryExpr(const A& a, const B& b, const C& c) : a_(a), b_(b), c_(c) { require_same_shape(a, b, c); }
+
+  size_t size() const { return shape_source(a_, b_, c_).size(); }
+
+  auto extents() const { return shape_source(a_, b_, c_).extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::merge_alias(a_.alias(dest), b_.alias(dest), c_.alias(dest));
+  }
+
+  void prepare() const { a_.prepare(); b_.prepare(); c_.prepare(); }
+
+  template <class F>
+  auto map_operands(F f) const {
+    auto a = f(a_);
+    auto b = f(b_);
+    auto c = f(c_);
+    return TernaryExpr<decltype(a), decltype(b), decltype(c), Op, Policy>(a, b, c);
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    return Op::template apply<T>(a_.template eval_simd<T>(i), b_.template eval_simd<T>(i),
+                                 c_.template eval_simd<T>(i));
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    return Op::template apply<T>(a_.template eval_simd_mask<T>(i), b_.template eval_simd_mask<T>(i),
+                                 c_.template eval_simd_mask<T>(i));
+  }
+};
+
+#endif  // __MDVECTOR_FUNCTION_EXPR_H__
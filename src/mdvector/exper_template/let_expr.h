@@ -0,0 +1,134 @@
+#ifndef __MDVECTOR_LET_EXPR_H__
+#define __MDVECTOR_LET_EXPR_H__
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "assign.h"
+
+// ======================== 公共子表达式绑定 ========================
+// r = (a + b) * (a + b) - c / (a + b) 中每个(a + b)节点各自加载a, b并求和
+// md::let(a + b, [&](auto s) { return s * s - c / s; }) 每个pack只求一次a + b 结果存入槽位 s的每次使用直接读取
+// 表达式在求值处就地构造时 编译器常能自行合并相同子树 保存后在别处求值的表达式(如求解器中)无法合并 此时收益明显
+// 槽位由let节点及其副本共享 同一let表达式不能被多个线程同时求值
+namespace md {
+namespace detail {
+
+// 最近一次求出的pack 及其下标
+template <class C>
+struct let_slot {
+  typename simd<C>::type value;
+  size_t index = SIZE_MAX;
+  bool masked = false;
+};
+
+}  // namespace detail
+}  // namespace md
+
+// ======================== 绑定变量 ========================
+// 下标与槽位一致时直接返回槽位 否则(如外层类型转换按其他类型或下标求值 广播时按原形状求值)重新计算子表达式
+// 仅在md::let的函数体内使用
+template <class E, class Policy>
+class LetVar : public TensorExpr<LetVar<E, Policy>, Policy> {
+  using C = compute_type_t<typename E::value_type>;
+
+  expr_ref_t<E> expr;
+  const md::detail::let_slot<C>* slot_;
+
+ public:
+  using value_type = typename E::value_type;
+
+  LetVar(const E& e, const md::detail::let_slot<C>* slot) : expr(e), slot_(slot) {}
+
+  size_t size() const { return expr.size(); }
+
+  auto extents() const { return expr.extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const { return expr.alias(dest); }
+
+  void prepare() const { expr.prepare(); }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    if constexpr (std::is_same_v<T, C>) {
+      if (slot_->index == i && !slot_->masked) return slot_->value;
+    }
+    return expr.template eval_simd<T>(i);
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    if constexpr (std::is_same_v<T, C>) {
+      if (slot_->index == i && slot_->masked) return slot_->value;
+    }
+    return expr.template eval_simd_mask<T>(i);
+  }
+};
+
+// ======================== let表达式 ========================
+// 每个pack先按子表达式的计算类型求值写入槽位 再求函数体
+// 子表达式与函数体元素个数不同时(函数体将其广播) 不使用槽位
+template <class E, class B, class Policy>
+class LetExpr : public TensorExpr<LetExpr<E, B, Policy>, Policy> {
+  using C = compute_type_t<typename E::value_type>;
+
+  std::shared_ptr<md::detail::let_slot<C>> slot_;
+  expr_ref_t<E> expr;
+  expr_ref_t<B> body;
+  bool shared_;
+
+ public:
+  using value_type = typename B::value_type;
+
+  LetExpr(std::shared_ptr<md::detail::let_slot<C>> slot, const E& e, const B& b)
+      : slot_(std::move(slot)), expr(e), body(b), shared_(e.size() == b.size()) {}
+
+  size_t size() const { return body.size(); }
+
+  auto extents() const { return body.extents(); }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::merge_alias(expr.alias(dest), body.alias(dest));
+  }
+
+  void prepare() const { expr.prepare(); body.prepare(); }
+
+  template <class T>
+  typename simd<T>::type eval_simd(size_t i) const {
+    if (shared_) {
+      slot_->value = expr.template eval_simd<C>(i);
+      slot_->index = i;
+      slot_->masked = false;
+    }
+    return body.template eval_simd<T>(i);
+  }
+
+  template <class T>
+  typename simd<T>::type eval_simd_mask(size_t i) const {
+    if (shared_) {
+      slot_->value = expr.template eval_simd_mask<C>(i);
+      slot_->index = i;
+      slot_->masked = true;
+    }
+    return body.template eval_simd_mask<T>(i);
+  }
+};
+
+namespace md {
+
+// f以绑定变量为参数 返回使用它的表达式 绑定变量不能在f返回的表达式之外保存
+// 例: r = md::let(md::exp(-a * b), [&](auto e) { return e * c + e * e; });
+template <class E, class P, class F>
+auto let(const TensorExpr<E, P>& x, F&& f) {
+  using C = compute_type_t<typename E::value_type>;
+  auto slot = std::make_shared<detail::let_slot<C>>();
+  const auto body = f(LetVar<E, P>(x.derived(), slot.get()));
+  using B = std::remove_const_t<decltype(body)>;
+  static_assert(!is_mdvector_v<B>, "md::let body must return an expression, not a copy of an mdvector");
+  return LetExpr<E, B, detail::store_policy_t<B>>(std::move(slot), x.derived(), body);
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_LET_EXPR_H__
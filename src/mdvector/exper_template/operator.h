@@ -1,13 +1,24 @@
 #ifndef __MDVECTOR_OPERATOR_H__
 #define __MDVECTOR_OPERATOR_H__
 
+#include "bitwise_expr.h"
+#include "broadcast_expr.h"
 #include "calculation_expr.h"
+#include "compare_expr.h"
+#include "function_expr.h"
 
 // ======================== 运算符重载 ========================
-// 向量 + 向量
-template <typename L, typename R, class Policy>
-AddExpr<L, R, Policy> operator+(const TensorExpr<L, Policy>& lhs, const TensorExpr<R, Policy>& rhs) {
-  return AddExpr<L, R, Policy>(lhs.derived(), rhs.derived());
+// -向量
+template <typename E, class Policy>
+UnaryExpr<E, NegOp, Policy> operator-(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, NegOp, Policy>(x.derived());
+}
+
+// 向量 + 向量 形状不同时按尾部维对齐广播
+template <typename L, typename R, class PL, class PR>
+auto operator+(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<AddExpr, Policy>(lhs.derived(), rhs.derived());
 }
 
 // 向量 + 标量
@@ -22,10 +33,11 @@ auto operator+(T lhs, const TensorExpr<R, Policy>& rhs) {
   return AddExpr<ScalarWrapper<T, Policy>, R, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
 }
 
-// 向量 - 向量
-template <typename L, typename R, class Policy>
-SubExpr<L, R, Policy> operator-(const TensorExpr<L, Policy>& lhs, const TensorExpr<R, Policy>& rhs) {
-  return SubExpr<L, R, Policy>(lhs.derived(), rhs.derived());
+// 向量 - 向量 形状不同时按尾部维对齐广播
+template <typename L, typename R, class PL, class PR>
+auto operator-(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<SubExpr, Policy>(lhs.derived(), rhs.derived());
 }
 
 // 向量 - 标量
@@ -40,10 +52,11 @@ auto operator-(T lhs, const TensorExpr<R, Policy>& rhs) {
   return SubExpr<ScalarWrapper<T, Policy>, R, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
 }
 
-// 向量 * 向量
-template <typename L, typename R, class Policy>
-MulExpr<L, R, Policy> operator*(const TensorExpr<L, Policy>& lhs, const TensorExpr<R, Policy>& rhs) {
-  return MulExpr<L, R, Policy>(lhs.derived(), rhs.derived());
+// 向量 * 向量 形状不同时按尾部维对齐广播
+template <typename L, typename R, class PL, class PR>
+auto operator*(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<MulExpr, Policy>(lhs.derived(), rhs.derived());
 }
 
 // 向量 * 标量
@@ -58,17 +71,24 @@ auto operator*(T lhs, const TensorExpr<R, Policy>& rhs) {
   return MulExpr<ScalarWrapper<T, Policy>, R, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
 }
 
-// 向量 / 向量
-template <typename L, typename R, class Policy>
-DivExpr<L, R, Policy> operator/(const TensorExpr<L, Policy>& lhs, const TensorExpr<R, Policy>& rhs) {
-  return DivExpr<L, R, Policy>(lhs.derived(), rhs.derived());
+// 向量 / 向量 形状不同时按尾部维对齐广播
+template <typename L, typename R, class PL, class PR>
+auto operator/(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<DivExpr, Policy>(lhs.derived(), rhs.derived());
 }
 
 // 向量 / 标量
-// 优化为标量倒数乘法 win x64有bug？
+// 浮点表达式乘以标量倒数 整数表达式保持除法
 template <typename L, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
 auto operator/(const TensorExpr<L, Policy>& lhs, T rhs) {
-  return DivExpr<L, ScalarWrapper<T, Policy>, Policy>(lhs.derived(), ScalarWrapper<T, Policy>(rhs));
+  using C = compute_type_t<typename L::value_type>;
+  if constexpr (std::is_floating_point_v<C>) {
+    using S = std::common_type_t<C, T>;
+    return ScalarDivExpr<L, S, Policy>(lhs.derived(), static_cast<S>(rhs));
+  } else {
+    return DivExpr<L, ScalarWrapper<T, Policy>, Policy>(lhs.derived(), ScalarWrapper<T, Policy>(rhs));
+  }
 }
 
 // 标量 / 向量
@@ -77,4 +97,223 @@ auto operator/(T lhs, const TensorExpr<R, Policy>& rhs) {
   return DivExpr<ScalarWrapper<T, Policy>, R, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
 }
 
+// ======================== 位运算符 ========================
+// 仅限整数元素类型 两个数组操作数按广播规则对齐
+
+// 向量 & 向量
+template <typename L, typename R, class PL, class PR>
+auto operator&(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<BinaryExpr, BitAndOp, Policy>(lhs.derived(), rhs.derived());
+}
+
+// 向量 & 标量
+template <typename L, typename T, class Policy, typename = std::enable_if_t<std::is_integral_v<T>>>
+auto operator&(const TensorExpr<L, Policy>& lhs, T rhs) {
+  return BinaryExpr<L, ScalarWrapper<T, Policy>, BitAndOp, Policy>(lhs.derived(), ScalarWrapper<T, Policy>(rhs));
+}
+
+// 标量 & 向量
+template <typename R, typename T, class Policy, typename = std::enable_if_t<std::is_integral_v<T>>>
+auto operator&(T lhs, const TensorExpr<R, Policy>& rhs) {
+  return BinaryExpr<ScalarWrapper<T, Policy>, R, BitAndOp, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
+}
+
+// 向量 | 向量
+template <typename L, typename R, class PL, class PR>
+auto operator|(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<BinaryExpr, BitOrOp, Policy>(lhs.derived(), rhs.derived());
+}
+
+// 向量 | 标量
+template <typename L, typename T, class Policy, typename = std::enable_if_t<std::is_integral_v<T>>>
+auto operator|(const TensorExpr<L, Policy>& lhs, T rhs) {
+  return BinaryExpr<L, ScalarWrapper<T, Policy>, BitOrOp, Policy>(lhs.derived(), ScalarWrapper<T, Policy>(rhs));
+}
+
+// 标量 | 向量
+template <typename R, typename T, class Policy, typename = std::enable_if_t<std::is_integral_v<T>>>
+auto operator|(T lhs, const TensorExpr<R, Policy>& rhs) {
+  return BinaryExpr<ScalarWrapper<T, Policy>, R, BitOrOp, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
+}
+
+// 向量 ^ 向量
+template <typename L, typename R, class PL, class PR>
+auto operator^(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<BinaryExpr, BitXorOp, Policy>(lhs.derived(), rhs.derived());
+}
+
+// 向量 ^ 标量
+template <typename L, typename T, class Policy, typename = std::enable_if_t<std::is_integral_v<T>>>
+auto operator^(const TensorExpr<L, Policy>& lhs, T rhs) {
+  return BinaryExpr<L, ScalarWrapper<T, Policy>, BitXorOp, Policy>(lhs.derived(), ScalarWrapper<T, Policy>(rhs));
+}
+
+// 标量 ^ 向量
+template <typename R, typename T, class Policy, typename = std::enable_if_t<std::is_integral_v<T>>>
+auto operator^(T lhs, const TensorExpr<R, Policy>& rhs) {
+  return BinaryExpr<ScalarWrapper<T, Policy>, R, BitXorOp, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
+}
+
+// ~向量
+template <typename E, class Policy>
+UnaryExpr<E, BitNotOp, Policy> operator~(const TensorExpr<E, Policy>& x) {
+  return UnaryExpr<E, BitNotOp, Policy>(x.derived());
+}
+
+// 向量 << 位数 / 向量 >> 位数
+template <typename E, typename N, class Policy, typename = std::enable_if_t<std::is_integral_v<N>>>
+ShiftExpr<E, ShlOp, Policy> operator<<(const TensorExpr<E, Policy>& x, N n) {
+  return ShiftExpr<E, ShlOp, Policy>(x.derived(), static_cast<int>(n));
+}
+
+template <typename E, typename N, class Policy, typename = std::enable_if_t<std::is_integral_v<N>>>
+ShiftExpr<E, ShrOp, Policy> operator>>(const TensorExpr<E, Policy>& x, N n) {
+  return ShiftExpr<E, ShrOp, Policy>(x.derived(), static_cast<int>(n));
+}
+
+// ======================== 比较运算符 ========================
+// 返回惰性掩码表达式 配合md::where使用 两个数组操作数按广播规则对齐
+
+// 向量 < 向量
+template <typename L, typename R, class PL, class PR>
+auto operator<(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<CompareExpr, LtOp, Policy>(lhs.derived(), rhs.derived());
+}
+
+// 向量 < 标量
+template <typename L, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator<(const TensorExpr<L, Policy>& lhs, T rhs) {
+  return CompareExpr<L, ScalarWrapper<T, Policy>, LtOp, Policy>(lhs.derived(), ScalarWrapper<T, Policy>(rhs));
+}
+
+// 标量 < 向量
+template <typename R, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator<(T lhs, const TensorExpr<R, Policy>& rhs) {
+  return CompareExpr<ScalarWrapper<T, Policy>, R, LtOp, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
+}
+
+// 向量 <= 向量
+template <typename L, typename R, class PL, class PR>
+auto operator<=(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<CompareExpr, LeOp, Policy>(lhs.derived(), rhs.derived());
+}
+
+// 向量 <= 标量
+template <typename L, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator<=(const TensorExpr<L, Policy>& lhs, T rhs) {
+  return CompareExpr<L, ScalarWrapper<T, Policy>, LeOp, Policy>(lhs.derived(), ScalarWrapper<T, Policy>(rhs));
+}
+
+// 标量 <= 向量
+template <typename R, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator<=(T lhs, const TensorExpr<R, Policy>& rhs) {
+  return CompareExpr<ScalarWrapper<T, Policy>, R, LeOp, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
+}
+
+// 向量 > 向量
+template <typename L, typename R, class PL, class PR>
+auto operator>(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<CompareExpr, GtOp, Policy>(lhs.derived(), rhs.derived());
+}
+
+// 向量 > 标量
+template <typename L, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator>(const TensorExpr<L, Policy>& lhs, T rhs) {
+  return CompareExpr<L, ScalarWrapper<T, Policy>, GtOp, Policy>(lhs.derived(), ScalarWrapper<T, Policy>(rhs));
+}
+
+// 标量 > 向量
+template <typename R, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator>(T lhs, const TensorExpr<R, Policy>& rhs) {
+  return CompareExpr<ScalarWrapper<T, Policy>, R, GtOp, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
+}
+
+// 向量 >= 向量
+template <typename L, typename R, class PL, class PR>
+auto operator>=(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<CompareExpr, GeOp, Policy>(lhs.derived(), rhs.derived());
+}
+
+// 向量 >= 标量
+template <typename L, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator>=(const TensorExpr<L, Policy>& lhs, T rhs) {
+  return CompareExpr<L, ScalarWrapper<T, Policy>, GeOp, Policy>(lhs.derived(), ScalarWrapper<T, Policy>(rhs));
+}
+
+// 标量 >= 向量
+template <typename R, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator>=(T lhs, const TensorExpr<R, Policy>& rhs) {
+  return CompareExpr<ScalarWrapper<T, Policy>, R, GeOp, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
+}
+
+// 向量 == 向量
+template <typename L, typename R, class PL, class PR>
+auto operator==(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<CompareExpr, EqOp, Policy>(lhs.derived(), rhs.derived());
+}
+
+// 向量 == 标量
+template <typename L, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator==(const TensorExpr<L, Policy>& lhs, T rhs) {
+  return CompareExpr<L, ScalarWrapper<T, Policy>, EqOp, Policy>(lhs.derived(), ScalarWrapper<T, Policy>(rhs));
+}
+
+// 标量 == 向量
+template <typename R, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator==(T lhs, const TensorExpr<R, Policy>& rhs) {
+  return CompareExpr<ScalarWrapper<T, Policy>, R, EqOp, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
+}
+
+// 向量 != 向量
+template <typename L, typename R, class PL, class PR>
+auto operator!=(const TensorExpr<L, PL>& lhs, const TensorExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  return make_broadcast_node<CompareExpr, NeOp, Policy>(lhs.derived(), rhs.derived());
+}
+
+// 向量 != 标量
+template <typename L, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator!=(const TensorExpr<L, Policy>& lhs, T rhs) {
+  return CompareExpr<L, ScalarWrapper<T, Policy>, NeOp, Policy>(lhs.derived(), ScalarWrapper<T, Policy>(rhs));
+}
+
+// 标量 != 向量
+template <typename R, typename T, class Policy, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+auto operator!=(T lhs, const TensorExpr<R, Policy>& rhs) {
+  return CompareExpr<ScalarWrapper<T, Policy>, R, NeOp, Policy>(ScalarWrapper<T, Policy>(lhs), rhs.derived());
+}
+
+// ======================== 掩码逻辑运算符 ========================
+// 两侧均会计算 不短路 掩码不广播 两侧形状须兼容且元素数相同
+template <typename L, typename R, class PL, class PR>
+auto operator&&(const MaskExpr<L, PL>& lhs, const MaskExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  const auto extents = md::detail::broadcast_shape(lhs.derived().extents(), rhs.derived().extents());
+  md::detail::require_mask_size(lhs.derived(), extents);
+  md::detail::require_mask_size(rhs.derived(), extents);
+  return MaskBinaryExpr<L, R, MaskAndOp, Policy>(lhs.derived(), rhs.derived());
+}
+
+template <typename L, typename R, class PL, class PR>
+auto operator||(const MaskExpr<L, PL>& lhs, const MaskExpr<R, PR>& rhs) {
+  using Policy = common_policy_t<PL, PR>;
+  const auto extents = md::detail::broadcast_shape(lhs.derived().extents(), rhs.derived().extents());
+  md::detail::require_mask_size(lhs.derived(), extents);
+  md::detail::require_mask_size(rhs.derived(), extents);
+  return MaskBinaryExpr<L, R, MaskOrOp, Policy>(lhs.derived(), rhs.derived());
+}
+
+template <typename E, class Policy>
+MaskNotExpr<E, Policy> operator!(const MaskExpr<E, Policy>& x) {
+  return MaskNotExpr<E, Policy>(x.derived());
+}
+
 #endif  // __OPERATOR_H__
\ No newline at end of file
@@ -0,0 +1,471 @@
+#ifndef __MDVECTOR_REDUCTION_H__
+#define __MDVECTOR_REDUCTION_H__
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "../span/detail.h"
+#include "operator.h"
+
+// ======================== 归约运算 ========================
+// identity: 单位元 尾部无效通道用其填充
+// accumulate: 向量累加器与一个pack合并
+// combine: 两个向量累加器合并
+// fold: 标量合并 用于累加器之间与水平归约
+struct SumReduceOp {
+  template <class T>
+  static T identity() {
+    return T(0);
+  }
+  // 累加项 供补偿求和使用
+  template <class T>
+  static typename simd<T>::type term(typename simd<T>::type v) {
+    return v;
+  }
+  template <class T>
+  static typename simd<T>::type accumulate(typename simd<T>::type acc, typename simd<T>::type v) {
+    return simd<T>::add(acc, v);
+  }
+  template <class T>
+  static typename simd<T>::type combine(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::add(a, b);
+  }
+  template <class T>
+  static T fold(T a, T b) {
+    return a + b;
+  }
+};
+
+struct ProdReduceOp {
+  template <class T>
+  static T identity() {
+    return T(1);
+  }
+  template <class T>
+  static typename simd<T>::type accumulate(typename simd<T>::type acc, typename simd<T>::type v) {
+    return simd<T>::mul(acc, v);
+  }
+  template <class T>
+  static typename simd<T>::type combine(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::mul(a, b);
+  }
+  template <class T>
+  static T fold(T a, T b) {
+    return a * b;
+  }
+};
+
+struct MinReduceOp {
+  template <class T>
+  static T identity() {
+    if constexpr (std::numeric_limits<T>::has_infinity) {
+      return std::numeric_limits<T>::infinity();
+    } else {
+      return std::numeric_limits<T>::max();
+    }
+  }
+  template <class T>
+  static typename simd<T>::type accumulate(typename simd<T>::type acc, typename simd<T>::type v) {
+    return simd<T>::min(acc, v);
+  }
+  template <class T>
+  static typename simd<T>::type combine(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::min(a, b);
+  }
+  template <class T>
+  static T fold(T a, T b) {
+    return b < a ? b : a;
+  }
+};
+
+struct MaxReduceOp {
+  template <class T>
+  static T identity() {
+    if constexpr (std::numeric_limits<T>::has_infinity) {
+      return -std::numeric_limits<T>::infinity();
+    } else {
+      return std::numeric_limits<T>::lowest();
+    }
+  }
+  template <class T>
+  static typename simd<T>::type accumulate(typename simd<T>::type acc, typename simd<T>::type v) {
+    return simd<T>::max(acc, v);
+  }
+  template <class T>
+  static typename simd<T>::type combine(typename simd<T>::type a, typename simd<T>::type b) {
+    return simd<T>::max(a, b);
+  }
+  template <class T>
+  static T fold(T a, T b) {
+    return a < b ? b : a;
+  }
+};
+
+// 平方和 acc + v * v 单条fma
+struct SumSqReduceOp : SumReduceOp {
+  template <class T>
+  static typename simd<T>::type term(typename simd<T>::type v) {
+    return simd<T>::mul(v, v);
+  }
+  template <class T>
+  static typename simd<T>::type accumulate(typename simd<T>::type acc, typename simd<T>::type v) {
+    return simd<T>::fmadd(v, v, acc);
+  }
+};
+
+// ======================== 归约实现 ========================
+namespace md {
+
+// 求和类归约(sum/mean/dot/norm2)的累加策略
+// plain_sum: 4路向量累加 最快 float在1e8量级元素时误差明显
+// pairwise_sum: 分块两两累加 误差随log(n)增长 吞吐接近plain
+// kahan_sum: Neumaier补偿累加 误差与n无关 吞吐最低
+struct plain_sum_t {};
+struct pairwise_sum_t {};
+struct kahan_sum_t {};
+inline constexpr plain_sum_t plain_sum{};
+inline constexpr pairwise_sum_t pairwise_sum{};
+inline constexpr kahan_sum_t kahan_sum{};
+
+namespace detail {
+
+// 尾部有效通道掩码 通道序号 < remaining
+template <class T>
+typename simd<T>::mask_type tail_lanes(size_t remaining) {
+  alignas(simd<T>::alignment) T iota[simd<T>::pack_size];
+  for (size_t k = 0; k < simd<T>::pack_size; ++k) {
+    iota[k] = static_cast<T>(k);
+  }
+  return simd<T>::cmp_lt(simd<T>::load(iota), simd<T>::set1(static_cast<T>(remaining)));
+}
+
+// 向量累加器的水平归约 通道两两合并
+template <class Op, class T>
+T horizontal_fold(typename simd<T>::type v) {
+  alignas(simd<T>::alignment) T lanes[simd<T>::pack_size];
+  simd<T>::store(lanes, v);
+  for (size_t width = simd<T>::pack_size / 2; width > 0; width /= 2) {
+    for (size_t k = 0; k < width; ++k) {
+      lanes[k] = Op::template fold<T>(lanes[k], lanes[k + width]);
+    }
+  }
+  return lanes[0];
+}
+
+// sum(a * b)直接以fma累加 省去一次乘法舍入
+template <class Op, class E>
+inline constexpr bool fuse_mul_v = std::is_same_v<Op, SumReduceOp> && is_mul_expr_v<E>;
+
+// 累加位置i处的一个完整pack
+template <class Op, class T, class E>
+typename simd<T>::type accumulate_pack(typename simd<T>::type acc, const E& e, size_t i) {
+  if constexpr (fuse_mul_v<Op, E>) {
+    return simd<T>::fmadd(e.left().template eval_simd<T>(i), e.right().template eval_simd<T>(i), acc);
+  } else {
+    return Op::template accumulate<T>(acc, e.template eval_simd<T>(i));
+  }
+}
+
+// 位置i处的尾部pack 无效通道替换为单位元
+template <class Op, class T, class E>
+typename simd<T>::type tail_pack(const E& e, size_t i) {
+  return simd<T>::select(tail_lanes<T>(e.size() - i), e.template eval_simd_mask<T>(i),
+                         simd<T>::set1(Op::template identity<T>()));
+}
+
+// 普通累加
+// 4路独立累加器隐藏加法延迟 float误差随n线性增长
+template <class Op, class T, class E>
+T reduce_all(const E& e) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr size_t P = S::pack_size;
+  const size_t n = e.size();
+  const V id = S::set1(Op::template identity<T>());
+
+  V acc0 = id, acc1 = id, acc2 = id, acc3 = id;
+  size_t i = 0;
+  for (; i + 4 * P <= n; i += 4 * P) {
+    acc0 = accumulate_pack<Op, T>(acc0, e, i);
+    acc1 = accumulate_pack<Op, T>(acc1, e, i + P);
+    acc2 = accumulate_pack<Op, T>(acc2, e, i + 2 * P);
+    acc3 = accumulate_pack<Op, T>(acc3, e, i + 3 * P);
+  }
+  for (; i + P <= n; i += P) {
+    acc0 = accumulate_pack<Op, T>(acc0, e, i);
+  }
+  if (i < n) {
+    acc1 = Op::template accumulate<T>(acc1, tail_pack<Op, T>(e, i));
+  }
+
+  const V acc = Op::template combine<T>(Op::template combine<T>(acc0, acc1), Op::template combine<T>(acc2, acc3));
+  return horizontal_fold<Op, T>(acc);
+}
+
+// 分块两两累加 [begin, end)
+// 块内仍为4路顺序累加 块间按二叉树合并 误差约O(eps * (块长 + log2(n)))
+// 切分点为pack_size整数倍 只有最后一块可能含尾部
+template <class Op, class T, class E>
+typename simd<T>::type pairwise_range(const E& e, size_t begin, size_t end) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr size_t P = S::pack_size;
+  constexpr size_t block = 64 * P;
+
+  if (end - begin > block) {
+    const size_t half = (end - begin) / 2 / P * P;
+    return S::add(pairwise_range<Op, T>(e, begin, begin + half), pairwise_range<Op, T>(e, begin + half, end));
+  }
+
+  const V zero = S::set1(T(0));
+  V acc0 = zero, acc1 = zero, acc2 = zero, acc3 = zero;
+  size_t i = begin;
+  for (; i + 4 * P <= end; i += 4 * P) {
+    acc0 = accumulate_pack<Op, T>(acc0, e, i);
+    acc1 = accumulate_pack<Op, T>(acc1, e, i + P);
+    acc2 = accumulate_pack<Op, T>(acc2, e, i + 2 * P);
+    acc3 = accumulate_pack<Op, T>(acc3, e, i + 3 * P);
+  }
+  for (; i + P <= end; i += P) {
+    acc0 = accumulate_pack<Op, T>(acc0, e, i);
+  }
+  if (i < end) {
+    acc1 = Op::template accumulate<T>(acc1, tail_pack<Op, T>(e, i));
+  }
+  return S::add(S::add(acc0, acc1), S::add(acc2, acc3));
+}
+
+template <class Op, class T, class E>
+T reduce_pairwise(const E& e) {
+  return horizontal_fold<SumReduceOp, T>(pairwise_range<Op, T>(e, 0, e.size()));
+}
+
+// Neumaier补偿累加 s + c为精确和的近似 误差与n无关
+// 2组(s, c)交替累加隐藏延迟 乘积项(如dot)本身的舍入不做补偿
+template <class Op, class T, class E>
+T reduce_kahan(const E& e) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr size_t P = S::pack_size;
+  const size_t n = e.size();
+
+  auto term = [&](size_t i) {
+    if constexpr (fuse_mul_v<Op, E>) {
+      return S::mul(e.left().template eval_simd<T>(i), e.right().template eval_simd<T>(i));
+    } else {
+      return Op::template term<T>(e.template eval_simd<T>(i));
+    }
+  };
+  // |s| >= |v|时 低位丢失在v中 否则丢失在s中
+  auto add = [](V& s, V& c, V v) {
+    const V t = S::add(s, v);
+    const auto s_big = S::cmp_le(S::abs(v), S::abs(s));
+    c = S::add(c, S::select(s_big, S::add(S::sub(s, t), v), S::add(S::sub(v, t), s)));
+    s = t;
+  };
+
+  const V zero = S::set1(T(0));
+  V s0 = zero, c0 = zero, s1 = zero, c1 = zero;
+  size_t i = 0;
+  for (; i + 2 * P <= n; i += 2 * P) {
+    add(s0, c0, term(i));
+    add(s1, c1, term(i + P));
+  }
+  for (; i + P <= n; i += P) {
+    add(s0, c0, term(i));
+  }
+  if (i < n) {
+    add(s1, c1, Op::template term<T>(tail_pack<Op, T>(e, i)));
+  }
+
+  // 通道间同样补偿合并
+  alignas(S::alignment) T sv[2 * P];
+  alignas(S::alignment) T cv[2 * P];
+  S::store(sv, s0);
+  S::store(sv + P, s1);
+  S::store(cv, c0);
+  S::store(cv + P, c1);
+  T sum = 0, comp = 0;
+  for (size_t k = 0; k < 2 * P; ++k) {
+    const T t = sum + sv[k];
+    comp += (std::fabs(sum) >= std::fabs(sv[k])) ? (sum - t) + sv[k] : (sv[k] - t) + sum;
+    sum = t;
+    comp += cv[k];
+  }
+  return sum + comp;
+}
+
+// 求和类归约(sum/prod/mean/dot/norm2)的累加类型 64位以下整数以int64_t累加(同numpy) 其余为计算类型
+// 如40个uint8_t的200求和为8000而非回绕后的64
+template <class V, class C = compute_type_t<V>>
+using sum_type_t = std::conditional_t<std::is_integral_v<C> && sizeof(C) < sizeof(int64_t), int64_t, C>;
+
+// 平均值类型 整数同numpy返回double(如{1, 2}为1.5) 其余为计算类型
+template <class V, class C = compute_type_t<V>>
+using mean_type_t = std::conditional_t<std::is_integral_v<C>, double, C>;
+
+// 窄整数以更宽的T累加 每个pack按源类型求值一次 写入缓冲后分段扩展 各段有独立的累加器
+// 整数加法无舍入 不区分累加策略
+template <class Op, class T, class E>
+T reduce_widen(const E& e) {
+  using Src = compute_type_t<typename E::value_type>;
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr size_t PS = simd<Src>::pack_size;
+  constexpr size_t PT = S::pack_size;
+  constexpr size_t parts = PS / PT;
+  const size_t n = e.size();
+
+  V acc[parts];
+  for (size_t k = 0; k < parts; ++k) acc[k] = S::set1(Op::template identity<T>());
+
+  alignas(simd<Src>::alignment) Src buf[PS];
+  for (size_t i = 0; i < n; i += PS) {
+    simd<Src>::store(buf, i + PS <= n ? e.template eval_simd<Src>(i) : tail_pack<Op, Src>(e, i));
+    for (size_t k = 0; k < parts; ++k) {
+      acc[k] = Op::template accumulate<T>(acc[k], simd_convert<Src, T>::loadu(buf + k * PT));
+    }
+  }
+  for (size_t k = 1; k < parts; ++k) acc[0] = Op::template combine<T>(acc[0], acc[k]);
+  return horizontal_fold<Op, T>(acc[0]);
+}
+
+// 按累加策略分派 仅用于求和类归约 窄整数以sum_type_t累加
+template <class Op, class E, class Accum>
+sum_type_t<typename E::value_type> reduce_sum(const E& e, Accum) {
+  using T = sum_type_t<typename E::value_type>;
+  if constexpr (!std::is_same_v<T, compute_type_t<typename E::value_type>>) {
+    return reduce_widen<Op, T>(e);
+  } else if constexpr (std::is_same_v<Accum, pairwise_sum_t>) {
+    return reduce_pairwise<Op, T>(e);
+  } else if constexpr (std::is_same_v<Accum, kahan_sum_t>) {
+    return reduce_kahan<Op, T>(e);
+  } else {
+    return reduce_all<Op, T>(e);
+  }
+}
+
+// 连续内存行 供reduce_all按非对齐方式读取
+template <class T>
+struct contiguous_row {
+  const T* ptr;
+  size_t n;
+
+  size_t size() const { return n; }
+
+  template <class U>
+  typename simd<U>::type eval_simd(size_t i) const {
+    return simd<U>::loadu(ptr + i);
+  }
+
+  template <class U>
+  typename simd<U>::type eval_simd_mask(size_t i) const {
+    return simd<U>::mask_loadu(ptr + i, n - i);
+  }
+};
+
+// 沿axis归约 src按行主序连续存放 dest为去掉axis后的连续数组
+// 视为[outer, n, inner]三维:
+//   inner == 1 (最内维) 每个outer对应一段连续行 水平归约
+//   inner > 1 (外层维) 按行读入n个长度为inner的连续行 纵向逐元素累加到dest 访存保持连续
+template <class Op, class T, size_t Rank>
+void reduce_axis(const T* src, const std::array<size_t, Rank>& extents, size_t axis, T* dest) {
+  using S = simd<T>;
+  constexpr size_t P = S::pack_size;
+  const auto strides = md::compute_strides(extents);
+  const size_t n = extents[axis];
+  const size_t inner = strides[axis];
+  size_t outer = 1;
+  for (size_t d = 0; d < axis; ++d) {
+    outer *= extents[d];
+  }
+
+  if (n == 0) {
+    std::fill(dest, dest + outer * inner, Op::template identity<T>());
+    return;
+  }
+
+  if (inner == 1) {
+    for (size_t o = 0; o < outer; ++o) {
+      dest[o] = reduce_all<Op, T>(contiguous_row<T>{src + o * n, n});
+    }
+    return;
+  }
+
+  for (size_t o = 0; o < outer; ++o) {
+    const T* s = src + o * n * inner;
+    T* d = dest + o * inner;
+    std::fill(d, d + inner, Op::template identity<T>());
+    for (size_t k = 0; k < n; ++k) {
+      const T* row = s + k * inner;
+      size_t j = 0;
+      for (; j + P <= inner; j += P) {
+        S::storeu(d + j, Op::template accumulate<T>(S::loadu(d + j), S::loadu(row + j)));
+      }
+      if (j < inner) {
+        const size_t remaining = inner - j;
+        S::mask_storeu(d + j, remaining,
+                       Op::template accumulate<T>(S::mask_loadu(d + j, remaining), S::mask_loadu(row + j, remaining)));
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+// ======================== 全局归约 ========================
+// 直接消费表达式 不生成中间数组 开始前prepare()一次
+// 例: double d = md::sum(a * b); float s = md::sum(x, md::kahan_sum);
+// 16位浮点存储类型以float累加并返回float
+// 64位以下整数的sum/prod/dot以int64_t累加并返回int64_t norm2以int64_t累加平方和 整数的mean返回double
+template <class E, class Policy, class Accum = plain_sum_t>
+detail::sum_type_t<typename E::value_type> sum(const TensorExpr<E, Policy>& x, Accum accum = {}) {
+  x.derived().prepare();
+  return detail::reduce_sum<SumReduceOp>(x.derived(), accum);
+}
+
+template <class E, class Policy>
+detail::sum_type_t<typename E::value_type> prod(const TensorExpr<E, Policy>& x) {
+  x.derived().prepare();
+  return detail::reduce_sum<ProdReduceOp>(x.derived(), plain_sum);
+}
+
+// 单参数为归约 双参数为逐元素min/max
+template <class E, class Policy>
+compute_type_t<typename E::value_type> min(const TensorExpr<E, Policy>& x) {
+  x.derived().prepare();
+  return detail::reduce_all<MinReduceOp, compute_type_t<typename E::value_type>>(x.derived());
+}
+
+template <class E, class Policy>
+compute_type_t<typename E::value_type> max(const TensorExpr<E, Policy>& x) {
+  x.derived().prepare();
+  return detail::reduce_all<MaxReduceOp, compute_type_t<typename E::value_type>>(x.derived());
+}
+
+template <class E, class Policy, class Accum = plain_sum_t>
+detail::mean_type_t<typename E::value_type> mean(const TensorExpr<E, Policy>& x, Accum accum = {}) {
+  using T = detail::mean_type_t<typename E::value_type>;
+  return static_cast<T>(sum(x, accum)) / static_cast<T>(x.size());
+}
+
+// 内积 plain/pairwise以fma累加 整数逐元素乘积按元素类型计算
+template <class L, class R, class PL, class PR, class Accum = plain_sum_t>
+detail::sum_type_t<operand_value_t<L, R>> dot(const TensorExpr<L, PL>& x, const TensorExpr<R, PR>& y,
+                                              Accum accum = {}) {
+  return sum(x * y, accum);
+}
+
+// 二范数 sqrt(sum(x * x))
+template <class E, class Policy, class Accum = plain_sum_t>
+compute_type_t<typename E::value_type> norm2(const TensorExpr<E, Policy>& x, Accum accum = {}) {
+  using T = compute_type_t<typename E::value_type>;
+  x.derived().prepare();
+  return static_cast<T>(std::sqrt(detail::reduce_sum<SumSqReduceOp>(x.derived(), accum)));
+}
+
+}  // namespace md
+
+#endif  // __MDVECTOR_REDUCTION_H__
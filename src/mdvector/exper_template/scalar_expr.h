@@ -1,6 +1,8 @@
 #ifndef __MDVECTOR_SCALAR_EXPR_H__
 #define __MDVECTOR_SCALAR_EXPR_H__
 
+#include <stdexcept>
+
 #include "tensor_expr.h"
 
 #if defined(__GNUC__) || defined(__clang__)
@@ -29,6 +31,8 @@ class ScalarWrapper : public TensorExpr<ScalarWrapper<T, Policy>, Policy> {
   }
 
  public:
+  using value_type = T;
+
 #if defined(__clang__)
   __attribute__((noinline, used))
 #endif
@@ -52,19 +56,149 @@ class ScalarWrapper : public TensorExpr<ScalarWrapper<T, Policy>, Policy> {
   // 允许拷贝
   ScalarWrapper(const ScalarWrapper&) = default;
 
+  // 计算类型与标量类型不同时(如int16向量 + 字面量1)按计算类型广播
   template <typename U>
   typename simd<U>::type eval_simd(size_t) const {
-    return simd_value_;
+    if constexpr (std::is_same_v<U, T>) {
+      return simd_value_;
+    } else {
+      return simd<U>::set1(static_cast<U>(value_));
+    }
   }
 
   template <typename U>
-  typename simd<U>::type eval_simd_mask(size_t) const {
-    return simd_value_;
+  typename simd<U>::type eval_simd_mask(size_t i) const {
+    return eval_simd<U>(i);
   }
 
+  const T& value() const { return value_; }
+
   size_t size() const { return 1; }
 
   std::array<size_t, 1> extents() const { return std::array<size_t, 1>{1}; }
+
+  // 标量不读取数组内存
+  md::detail::alias_kind alias(const md::detail::mem_range&) const { return md::detail::alias_kind::none; }
+
+  void prepare() const {}
+};
+
+// ======================== 标量识别 ========================
+template <class E>
+struct is_scalar_expr : std::false_type {};
+
+template <class T, class Policy>
+struct is_scalar_expr<ScalarWrapper<T, Policy>> : std::true_type {};
+
+template <class E>
+inline constexpr bool is_scalar_expr_v = is_scalar_expr<E>::value;
+
+// ======================== 操作数持有方式 ========================
+template <class T, size_t Rank, class Enable>
+class mdvector;
+
+template <class E>
+struct is_mdvector : std::false_type {};
+
+template <class T, size_t Rank, class Enable>
+struct is_mdvector<mdvector<T, Rank, Enable>> : std::true_type {};
+
+template <class E>
+inline constexpr bool is_mdvector_v = is_mdvector<E>::value;
+
+// 表达式节点持有操作数的方式 具名数组(mdvector, md::scratch)按引用 其余按值
+// 子表达式/标量包装/广播节点由运算符构造 为临时对象 subspan为轻量视图
+// 因此 auto e = a * 2.0 + b; 可保存后多次求值 只需a, b存活
+template <class E>
+struct held_by_ref : is_mdvector<E> {};
+
+template <class E>
+using expr_ref_t = std::conditional_t<held_by_ref<E>::value, const E&, const E>;
+
+// 两个元素类型的提升 相同类型保持不变(含16位浮点存储类型) 否则取计算类型的公共类型(如float与double为double)
+template <class A, class B>
+struct promote_value {
+  using type = std::conditional_t<std::is_same_v<A, B>, A, std::common_type_t<compute_type_t<A>, compute_type_t<B>>>;
+};
+
+template <class B>
+struct promote_value<void, B> {
+  using type = B;
 };
 
+template <class Acc, class... E>
+struct promote_operands {
+  using type = Acc;
+};
+
+// 标量操作数不参与提升
+template <class Acc, class E>
+using promote_operand_t =
+    std::conditional_t<is_scalar_expr_v<E>, Acc, typename promote_value<Acc, typename E::value_type>::type>;
+
+template <class Acc, class E, class... Rest>
+struct promote_operands<Acc, E, Rest...> : promote_operands<promote_operand_t<Acc, E>, Rest...> {};
+
+// 整数计算类型与浮点标量运算时按二者的公共类型计算(如int32_t * 0.5为double, int16_t * 0.5f为float)
+// 与C++算术转换一致 标量不被截断 同为整数或同为浮点时标量按计算类型广播
+template <class V, class S, bool = std::is_integral_v<compute_type_t<V>> && std::is_floating_point_v<S>>
+struct promote_scalar {
+  using type = V;
+};
+
+template <class V, class S>
+struct promote_scalar<V, S, true> {
+  using type = std::common_type_t<V, S>;
+};
+
+template <class V, class S>
+using promote_scalar_t = typename promote_scalar<V, S>::type;
+
+template <class V, class... E>
+struct promote_scalars {
+  using type = V;
+};
+
+template <class V, class E, class... Rest>
+struct promote_scalars<V, E, Rest...>
+    : promote_scalars<std::conditional_t<is_scalar_expr_v<E>, promote_scalar_t<V, typename E::value_type>, V>,
+                      Rest...> {};
+
+// 多元表达式的元素类型为非标量操作数元素类型的提升 全为标量时取首个标量类型 再与浮点标量提升
+template <class E, class... Rest>
+struct operand_value {
+  using promoted = typename promote_operands<void, E, Rest...>::type;
+  using operands = std::conditional_t<std::is_void_v<promoted>, typename E::value_type, promoted>;
+  using type = typename promote_scalars<operands, E, Rest...>::type;
+};
+
+template <class... E>
+using operand_value_t = typename operand_value<E...>::type;
+
+// 多元表达式的形状取自首个非标量操作数
+template <class E, class... Rest>
+const auto& shape_source(const E& e, const Rest&... rest) {
+  if constexpr (is_scalar_expr_v<E> && sizeof...(Rest) > 0) {
+    return shape_source(rest...);
+  } else {
+    return e;
+  }
+}
+
+// 不广播的多元表达式(where/clamp/掩码逻辑) 非标量操作数形状须与首个非标量操作数逐维相同 否则抛出std::invalid_argument
+template <class E, class... Rest>
+void require_same_shape(const E& e, const Rest&... rest) {
+  const auto shape = shape_source(e, rest...).extents();
+  auto check = [&shape](const auto& x) {
+    if constexpr (!is_scalar_expr_v<std::decay_t<decltype(x)>>) {
+      const auto other = x.extents();
+      if (!std::equal(shape.begin(), shape.end(), other.begin(), other.end())) {
+        throw std::invalid_argument("operand shapes do not match");
+      }
+    }
+  };
+  check(e);
+  (check(rest), ...);
+}
+
 #endif  // __MDVECTOR_SCALAR_EXPR_H__
\ No newline at end of file
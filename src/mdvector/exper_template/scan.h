@@ -0,0 +1,97 @@
+#ifndef __MDVECTOR_SCAN_H__
+#define __MDVECTOR_SCAN_H__
+
+#include <algorithm>
+#include <array>
+
+#include "../span/detail.h"
+#include "reduction.h"
+
+// ======================== 前缀扫描 ========================
+// Op复用归约运算 SumReduceOp -> cumsum ProdReduceOp -> cumprod
+namespace md {
+namespace detail {
+
+// 寄存器内log步扫描: v = v op shift_up<1>(v) op shift_up<2>(v) ...
+template <class Op, class T, int K = 1>
+typename simd<T>::type scan_pack(typename simd<T>::type v, typename simd<T>::type id) {
+  if constexpr (K < static_cast<int>(simd<T>::pack_size)) {
+    v = Op::template combine<T>(v, simd<T>::template shift_up<K>(v, id));
+    return scan_pack<Op, T, 2 * K>(v, id);
+  } else {
+    return v;
+  }
+}
+
+// 一段连续内存的前缀扫描 carry为前面各pack的累计值(广播到所有通道)
+template <class Op, class T>
+void scan_row(const T* src, T* dest, size_t n) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr size_t P = S::pack_size;
+  const V id = S::set1(Op::template identity<T>());
+
+  V carry = id;
+  size_t i = 0;
+  for (; i + P <= n; i += P) {
+    const V v = Op::template combine<T>(scan_pack<Op, T>(S::loadu(src + i), id), carry);
+    S::storeu(dest + i, v);
+    carry = S::broadcast_last(v);
+  }
+  // 尾部无效通道位于高位 不影响有效通道的前缀
+  if (i < n) {
+    const V v = Op::template combine<T>(scan_pack<Op, T>(S::mask_loadu(src + i, n - i), id), carry);
+    S::mask_storeu(dest + i, n - i, v);
+  }
+}
+
+// 沿axis扫描 src与dest形状相同 均为行主序连续存放 允许src == dest
+// 视为[outer, n, inner]三维:
+//   inner == 1 (最内维) 每行独立做寄存器内扫描并携带偏移
+//   inner > 1 (外层维) dest第k行 = dest第k-1行 op src第k行 逐行连续纵向累加
+template <class Op, class T, size_t Rank>
+void scan_axis(const T* src, const std::array<size_t, Rank>& extents, size_t axis, T* dest) {
+  using S = simd<T>;
+  constexpr size_t P = S::pack_size;
+  const auto strides = md::compute_strides(extents);
+  const size_t n = extents[axis];
+  const size_t inner = strides[axis];
+  size_t outer = 1;
+  for (size_t d = 0; d < axis; ++d) {
+    outer *= extents[d];
+  }
+
+  if (inner == 1) {
+    for (size_t o = 0; o < outer; ++o) {
+      scan_row<Op>(src + o * n, dest + o * n, n);
+    }
+    return;
+  }
+
+  for (size_t o = 0; o < outer && n > 0; ++o) {
+    const T* s = src + o * n * inner;
+    T* d = dest + o * n * inner;
+    if (s != d) {
+      std::copy(s, s + inner, d);
+    }
+    for (size_t k = 1; k < n; ++k) {
+      const T* prev = d + (k - 1) * inner;
+      const T* row = s + k * inner;
+      T* out = d + k * inner;
+      size_t j = 0;
+      for (; j + P <= inner; j += P) {
+        S::storeu(out + j, Op::template combine<T>(S::loadu(prev + j), S::loadu(row + j)));
+      }
+      if (j < inner) {
+        const size_t remaining = inner - j;
+        S::mask_storeu(out + j, remaining,
+                       Op::template combine<T>(S::mask_loadu(prev + j, remaining), S::mask_loadu(row + j, remaining)));
+      }
+    }
+  }
+}
+
+}  // namespace detail
+}  // namespace md
+
+#endif  // __MDVECTOR_SCAN_H__
@@ -1,9 +1,116 @@
 #ifndef __MDVECTOR_TENSOR_EXPR_H__
 #define __MDVECTOR_TENSOR_EXPR_H__
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../allocator/allocator.h"
 #include "../simd/simd.h"
 
+template <class E, class U, class Policy>
+class CastExpr;
+
+// ======================== 访存策略合并 ========================
+// 叶节点(mdvector/subspan)按各自的策略加载 节点的策略仅决定eval_to的默认写回方式
+// 操作数全部对齐时为AlignedPolicy 含非对齐操作数(如subspan)时为UnalignedPolicy
+template <class... P>
+using common_policy_t =
+    std::conditional_t<(std::is_same_v<P, AlignedPolicy> && ...), AlignedPolicy, UnalignedPolicy>;
+
+// ======================== 操作数与写回目标的内存关系 ========================
+namespace md {
+namespace detail {
+
+// none: 不相交
+// same: 起点与元素宽度相同 每个pack先读后写 可原位计算(如 a = a * 2 + b)
+// ahead: 操作数起点在目标之后 按下标正向求值时读取总在写回之前
+// behind: 操作数起点在目标之前(如 rows[1:4] = rows[0:3] + rows[1:4]) 需按下标反向求值
+// partial: 其余重叠(方向相反的操作数 广播读取 元素宽度不同) 需经临时缓冲区
+enum class alias_kind { none, same, ahead, behind, partial };
+
+// 目标的字节区间
+struct mem_range {
+  uintptr_t begin = 0;
+  uintptr_t end = 0;
+  size_t elem = 0;
+};
+
+template <class T>
+mem_range make_mem_range(const T* p, size_t n) {
+  const auto begin = reinterpret_cast<uintptr_t>(p);
+  return {begin, begin + n * sizeof(T), sizeof(T)};
+}
+
+// 按扁平下标逐元素读取的连续操作数[p, p + n)
+template <class T>
+alias_kind range_alias(const T* p, size_t n, const mem_range& dest) {
+  const mem_range r = make_mem_range(p, n);
+  if (r.begin == r.end || r.end <= dest.begin || dest.end <= r.begin) return alias_kind::none;
+  if (r.elem != dest.elem) return alias_kind::partial;
+  if (r.begin == dest.begin) return alias_kind::same;
+  return r.begin > dest.begin ? alias_kind::ahead : alias_kind::behind;
+}
+
+// 两个子节点的关系合并 same与任一方向相容 方向相反时只能经缓冲区
+inline alias_kind combine_alias(alias_kind a, alias_kind b) {
+  if (a == alias_kind::none || a == alias_kind::same) return b == alias_kind::none ? a : b;
+  if (b == alias_kind::none || b == alias_kind::same) return a;
+  return a == b ? a : alias_kind::partial;
+}
+
+template <class... A>
+alias_kind merge_alias(A... kinds) {
+  alias_kind result = alias_kind::none;
+  ((result = combine_alias(result, kinds)), ...);
+  return result;
+}
+
+// ======================== 按pack遍历 ========================
+// 正向遍历扁平下标[begin, end) body(i)处理从i开始的整pack tail(i, remaining)处理末尾不足一个pack的元素
+// 主循环每次处理unroll_factor个相互独立的pack eval_range与md::assign共用
+template <class C, class Body, class Tail>
+inline void for_each_pack(size_t begin, size_t end, Body body, Tail tail) {
+  constexpr size_t pack_size = simd<C>::pack_size;
+  constexpr size_t step = unroll_factor * pack_size;
+  size_t i = begin;
+
+  for (; i + step <= end; i += step) {
+    unroll<unroll_factor>([&](size_t k) { body(i + k * pack_size); });
+  }
+
+  for (; i + pack_size <= end; i += pack_size) {
+    body(i);
+  }
+
+  if (i < end) {
+    tail(i, end - i);
+  }
+}
+
+// 反向遍历[0, n) 先处理尾部 再逐个pack向前 已写回的高位元素不会再被读取
+template <class C, class Body, class Tail>
+inline void for_each_pack_reverse(size_t n, Body body, Tail tail) {
+  constexpr size_t pack_size = simd<C>::pack_size;
+  size_t i = n - n % pack_size;
+
+  if (i < n) {
+    tail(i, n - i);
+  }
+
+  while (i > 0) {
+    i -= pack_size;
+    body(i);
+  }
+}
+
+}  // namespace detail
+}  // namespace md
+
 // ======================== 表达式模板基类 ========================
+// 节点除eval_simd/eval_simd_mask/size/extents/alias外还提供prepare():
+// 每次求值开始前调用一次(eval_to/eval_to_reverse/归约/md::assign/md::blocked) 逐层转发到子节点
+// 持有缓冲区的节点(广播表达式操作数)在此按操作数当前内容刷新 其余节点为空操作 构造表达式不分配也不计算
 template <class Derived, class Policy>
 class TensorExpr {
  public:
@@ -16,21 +123,92 @@ class TensorExpr {
   // 左值
   auto eval_simd(size_t i) const { return static_cast<const Derived&>(*this).eval_simd(i); }
 
-  template <typename Dest>
+  // 16位浮点存储类型的目标以float计算 写回时收窄
+  // 表达式元素类型与目标不同时(如double表达式写入float) 按表达式类型计算后转换
+  // StorePolicy为目标的写回策略 由目标决定(mdvector对齐 subspan非对齐) 默认取表达式的策略
+  template <class StorePolicy = Policy, typename Dest>
   void eval_to(Dest* dest) const {
-    const size_t n = size();
-    constexpr size_t pack_size = simd<Dest>::pack_size;
-    size_t i = 0;
+    eval_to<StorePolicy>(dest, 0, size());
+  }
+
+  // 写回自身操作数所在内存时使用(mdvector/subspan的赋值与复合赋值)
+  // 不相交 起点相同或操作数在目标之后时与eval_to相同 操作数在目标之前时反向求值 其余重叠经临时缓冲区
+  // 对齐目标不相交且不小于md::stream_threshold字节时 按StreamPolicy流式写回
+  template <class StorePolicy = Policy, typename Dest>
+  void assign_to(Dest* dest) const {
+    using D = std::remove_const_t<Dest>;
+    switch (derived().alias(md::detail::make_mem_range(dest, size()))) {
+      case md::detail::alias_kind::none:
+        if constexpr (std::is_same_v<StorePolicy, AlignedPolicy>) {
+          if (size() * sizeof(D) >= md::stream_threshold) {
+            eval_to<StreamPolicy>(dest);
+            break;
+          }
+        }
+        eval_to<StorePolicy>(dest);
+        break;
+      case md::detail::alias_kind::behind:
+        eval_to_reverse<StorePolicy>(dest);
+        break;
+      case md::detail::alias_kind::partial: {
+        std::vector<D, AutoAllocator<D>> buffer(size());
+        eval_to<AlignedPolicy>(buffer.data());
+        std::copy(buffer.begin(), buffer.end(), dest);
+        break;
+      }
+      default:
+        eval_to<StorePolicy>(dest);
+    }
+  }
 
-    for (; i + pack_size <= n; i += pack_size) {
-      auto simd_val = derived().template eval_simd<std::remove_const_t<Dest>>(i);
-      Policy::template store<std::remove_const_t<Dest>>(dest + i, simd_val);
+  // 按下标从后向前求值 先处理尾部 再逐个pack向前 已写回的高位元素不会再被读取
+  template <class StorePolicy = Policy, typename Dest>
+  void eval_to_reverse(Dest* dest) const {
+    using C = compute_type_t<std::remove_const_t<Dest>>;
+    if constexpr (!std::is_same_v<compute_type_t<typename Derived::value_type>, C>) {
+      CastExpr<Derived, std::remove_const_t<Dest>, Policy>(derived()).template eval_to_reverse<StorePolicy>(dest);
+    } else {
+      using D = std::remove_const_t<Dest>;
+      derived().prepare();
+      md::detail::for_each_pack_reverse<C>(
+          size(),
+          [&](size_t i) { StorePolicy::template store<D>(dest + i, derived().template eval_simd<C>(i)); },
+          [&](size_t i, size_t remaining) {
+            StorePolicy::template mask_store<D>(dest + i, remaining, derived().template eval_simd_mask<C>(i));
+          });
+      StorePolicy::fence();
     }
+  }
+
+  // 仅求值扁平下标[begin, end)的元素 第i个元素写入dest[i - begin]
+  // begin须为pack_size的整数倍 end为pack_size的整数倍或size() 末尾不足一个pack时使用掩码
+  template <class StorePolicy = Policy, typename Dest>
+  void eval_to(Dest* dest, size_t begin, size_t end) const {
+    derived().prepare();
+    eval_range<StorePolicy>(dest, begin, end);
+  }
 
-    // 使用掩码处理尾部元素
-    const size_t remaining = n - i;
-    auto simd_val = derived().template eval_simd_mask<std::remove_const_t<Dest>>(i);
-    Policy::template mask_store<std::remove_const_t<Dest>>(dest + i, remaining, simd_val);
+  // 同eval_to的区间形式 但不调用prepare() 用于分块求值: 整个序列开始前prepare()一次 再逐块求值
+  template <class StorePolicy = Policy, typename Dest>
+  void eval_range(Dest* dest, size_t begin, size_t end) const {
+    using C = compute_type_t<std::remove_const_t<Dest>>;
+    if constexpr (!std::is_same_v<compute_type_t<typename Derived::value_type>, C>) {
+      CastExpr<Derived, std::remove_const_t<Dest>, Policy>(derived()).template eval_range<StorePolicy>(dest, begin, end);
+    } else {
+      using D = std::remove_const_t<Dest>;
+      md::detail::for_each_pack<C>(
+          begin, end,
+          [&](size_t i) {
+            auto simd_val = derived().template eval_simd<C>(i);
+            StorePolicy::template store<D>(dest + (i - begin), simd_val);
+          },
+          [&](size_t i, size_t remaining) {
+            // 使用掩码处理尾部元素
+            auto simd_val = derived().template eval_simd_mask<C>(i);
+            StorePolicy::template mask_store<D>(dest + (i - begin), remaining, simd_val);
+          });
+      StorePolicy::fence();
+    }
   }
 };
 
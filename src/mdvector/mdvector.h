@@ -4,7 +4,7 @@
 #include "engine/md_engine.h"
 
 // =================================================
-// 针对非浮点类型 具备多维索引功能 不具备表达式计算功能
+// 针对无simd特化的类型 具备多维索引功能 不具备表达式计算功能
 template <class T, size_t Rank, class Enable = void>
 class mdvector : private MDEngine<T, Rank> {
   using Impl = MDEngine<T, Rank>;
@@ -60,15 +60,17 @@ class mdvector : private MDEngine<T, Rank> {
   using Impl::set_value;
 };
 
-// ================  浮点类型 支持元素级计算 (simd + ET)  ====================
-//
+// ================  浮点与整数类型 支持元素级计算 (simd + ET)  ====================
+// 整数: int32_t/int64_t/int16_t/uint8_t 额外支持位运算与移位 数学函数仅限浮点
 template <class T, size_t Rank>
-class mdvector<T, Rank, std::enable_if_t<std::is_floating_point_v<T>>>
+class mdvector<T, Rank, std::enable_if_t<has_simd_v<T>>>
     : public TensorExpr<mdvector<T, Rank>, AlignedPolicy>, private MDEngine<T, Rank> {
   using Impl = MDEngine<T, Rank>;
   using Policy = AlignedPolicy;
 
  public:
+  using value_type = T;
+
   // 默认构造
   using Impl::Impl;
 
@@ -118,57 +120,90 @@ class mdvector<T, Rank, std::enable_if_t<std::is_floating_point_v<T>>>
   using Impl::reset_shape;
   using Impl::set_value;
 
-  // ======================= 浮点类型特有功能 ======================
+  // ======================= simd类型特有功能 ======================
 
   // =================== 表达式模板 ============================
-  // 表达式构造
-  template <class E>
-  mdvector(const TensorExpr<E, AlignedPolicy>& expr) {
+  // 表达式构造 表达式可含subspan等非对齐操作数 各叶节点按自身策略加载 写回按对齐存储
+  // 新分配的内存不与操作数重叠 超过md::stream_threshold时流式写回
+  template <class E, class P>
+  mdvector(const TensorExpr<E, P>& expr) {
     this->reset_shape(expr.extents());
-    expr.eval_to(this->data());  // 直接计算到目标内存
+    expr.template assign_to<Policy>(this->data());  // 直接计算到目标内存
   }
 
-  // 表达式赋值
-  template <class E>
-  mdvector& operator=(const TensorExpr<E, AlignedPolicy>& expr) {
-    expr.eval_to(this->data());  // 直接计算到目标内存
+  // 表达式赋值 表达式含与自身部分重叠的subspan(如按行广播自身的一行)时经临时缓冲区写回
+  template <class E, class P>
+  mdvector& operator=(const TensorExpr<E, P>& expr) {
+    expr.template assign_to<Policy>(this->data());  // 直接计算到目标内存
     return *this;
   }
 
-  // 取值
+  // 取值 T2为计算类型 与元素类型不同时加载后转换
   template <class T2>
   typename simd<T2>::type eval_simd(size_t i) const {
-    return simd<T2>::load(this->data() + i);
+    return Policy::template load<T, T2>(this->data() + i);
   }
 
   // 取值
   template <class T2>
   typename simd<T2>::type eval_simd_mask(size_t i) const {
-    return simd<T2>::mask_load(this->data() + i, size() - i);
+    return Policy::template mask_load<T, T2>(this->data() + i, size() - i);
   }
 
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::range_alias(this->data(), size(), dest);
+  }
+
+  void prepare() const {}
+
   // ======================= ?= 操作符重载 ============================
-  // b ?= a
+  // b ?= a 形状不同时按表达式复合赋值处理(广播a)
   mdvector& operator+=(const mdvector& other) {
+    if (other.extents() != this->extents()) return compound_assign(*this + other);
     simd_add_inplace<T, Policy>(this->data(), other.data(), this->size());
     return *this;
   }
 
   mdvector& operator-=(const mdvector& other) {
+    if (other.extents() != this->extents()) return compound_assign(*this - other);
     simd_sub_inplace<T, Policy>(this->data(), other.data(), this->size());
     return *this;
   }
 
   mdvector& operator*=(const mdvector& other) {
+    if (other.extents() != this->extents()) return compound_assign(*this * other);
     simd_mul_inplace<T, Policy>(this->data(), other.data(), this->size());
     return *this;
   }
 
   mdvector& operator/=(const mdvector& other) {
+    if (other.extents() != this->extents()) return compound_assign(*this / other);
     simd_div_inplace<T, Policy>(this->data(), other.data(), this->size());
     return *this;
   }
 
+  // 表达式复合赋值 b ?= expr 即 b = b ? expr 单次遍历读-改-写 不生成中间数组
+  // 如 a += b * c 为每个pack一次fmadd 低秩表达式按广播规则扩展到b的形状
+  template <class E, class P>
+  mdvector& operator+=(const TensorExpr<E, P>& expr) {
+    return compound_assign(*this + expr.derived());
+  }
+
+  template <class E, class P>
+  mdvector& operator-=(const TensorExpr<E, P>& expr) {
+    return compound_assign(*this - expr.derived());
+  }
+
+  template <class E, class P>
+  mdvector& operator*=(const TensorExpr<E, P>& expr) {
+    return compound_assign(*this * expr.derived());
+  }
+
+  template <class E, class P>
+  mdvector& operator/=(const TensorExpr<E, P>& expr) {
+    return compound_assign(*this / expr.derived());
+  }
+
   // ====================== 标量表达式模板 ===========================
   // 添加标量eval_scalar方法
   template <class T2>
@@ -197,10 +232,31 @@ class mdvector<T, Rank, std::enable_if_t<std::is_floating_point_v<T>>>
     return *this;
   }
 
+  // 整数数组与浮点标量 按浮点计算后转换写回(同int x; x *= 0.5) 标量不先截断为整数
+  template <class U, typename = std::enable_if_t<std::is_integral_v<T> && std::is_floating_point_v<U>>>
+  mdvector& operator+=(U scalar) {
+    return compound_assign(*this + scalar);
+  }
+
+  template <class U, typename = std::enable_if_t<std::is_integral_v<T> && std::is_floating_point_v<U>>>
+  mdvector& operator-=(U scalar) {
+    return compound_assign(*this - scalar);
+  }
+
+  template <class U, typename = std::enable_if_t<std::is_integral_v<T> && std::is_floating_point_v<U>>>
+  mdvector& operator*=(U scalar) {
+    return compound_assign(*this * scalar);
+  }
+
+  template <class U, typename = std::enable_if_t<std::is_integral_v<T> && std::is_floating_point_v<U>>>
+  mdvector& operator/=(U scalar) {
+    return compound_assign(*this / scalar);
+  }
+
   // 变量打印
   void show_data_array_style() {
     for (const auto& it : this->data_) {
-      std::cout << it << " ";
+      std::cout << +it << " ";
     }
     std::cout << "\n";
   }
@@ -214,11 +270,24 @@ class mdvector<T, Rank, std::enable_if_t<std::is_floating_point_v<T>>>
     for (size_t i = 0; i < rows; ++i) {
       const T* row_start = this->data() + i * cols;
       for (size_t j = 0; j < cols; ++j) {
-        std::cout << row_start[j] << " ";
+        std::cout << +row_start[j] << " ";
       }
       std::cout << "\n";
     }
   }
+
+ private:
+  // 复合赋值的结果表达式逐元素写回自身 形状须与自身相同(操作数可广播到自身 自身不随操作数扩展)
+  template <class E>
+  mdvector& compound_assign(const E& expr) {
+    static_assert(md::detail::expr_rank_v<E> == Rank,
+                  "compound assignment cannot broadcast the target to a higher rank");
+    if (expr.extents() != this->extents()) {
+      throw std::invalid_argument("compound assignment cannot broadcast the target to a larger shape");
+    }
+    expr.template assign_to<Policy>(this->data());
+    return *this;
+  }
 };
 
 // ======================= 常用维度别名 1D~6D ============================
@@ -244,4 +313,112 @@ using mdvector_5d = mdvector<T, 5>;
 template <class T>
 using mdvector_6d = mdvector<T, 6>;
 
+// ======================= 按轴归约 ============================
+// 例: mdvector_2d<double> r = md::reduce<1>(field_3d); 或 md::max<0>(field_3d)
+namespace md {
+
+// 去掉第Axis维后的形状
+template <size_t Axis, size_t Rank>
+std::array<size_t, Rank - 1> drop_axis(const std::array<size_t, Rank>& extents) {
+  std::array<size_t, Rank - 1> result;
+  for (size_t d = 0, k = 0; d < Rank; ++d) {
+    if (d != Axis) result[k++] = extents[d];
+  }
+  return result;
+}
+
+template <size_t Axis, class Op = SumReduceOp, class T, size_t Rank>
+mdvector<T, Rank - 1> reduce(const mdvector<T, Rank>& x) {
+  static_assert(Rank >= 2 && Axis < Rank, "axis reduction requires Rank >= 2 and Axis < Rank");
+  mdvector<T, Rank - 1> result(drop_axis<Axis>(x.extents()));
+  detail::reduce_axis<Op>(x.begin(), x.extents(), Axis, result.begin());
+  return result;
+}
+
+// 连续子视图
+template <size_t Axis, class Op = SumReduceOp, class T, size_t Rank>
+mdvector<T, Rank - 1> reduce(const subspan<T, Rank>& x) {
+  static_assert(Rank >= 2 && Axis < Rank, "axis reduction requires Rank >= 2 and Axis < Rank");
+  mdvector<T, Rank - 1> result(drop_axis<Axis>(x.shapes()));
+  detail::reduce_axis<Op>(x.cbegin(), x.shapes(), Axis, result.begin());
+  return result;
+}
+
+template <size_t Axis, class V>
+auto sum(const V& x) {
+  return reduce<Axis, SumReduceOp>(x);
+}
+
+template <size_t Axis, class V>
+auto prod(const V& x) {
+  return reduce<Axis, ProdReduceOp>(x);
+}
+
+template <size_t Axis, class V>
+auto min(const V& x) {
+  return reduce<Axis, MinReduceOp>(x);
+}
+
+template <size_t Axis, class V>
+auto max(const V& x) {
+  return reduce<Axis, MaxReduceOp>(x);
+}
+
+// 整数同numpy返回double 先转换为double再归约 窄整数累加不回绕
+template <size_t Axis, class V>
+auto mean(const V& x) {
+  using T = typename V::value_type;
+  if constexpr (std::is_integral_v<compute_type_t<T>>) {
+    const mdvector<double, md::detail::expr_rank_v<V>> wide = md::cast<double>(x);
+    return mean<Axis>(wide);
+  } else {
+    auto result = reduce<Axis, SumReduceOp>(x);
+    result /= static_cast<T>(x.shapes()[Axis]);
+    return result;
+  }
+}
+
+}  // namespace md
+
+// ======================= 前缀扫描 ============================
+// 最内维为寄存器内log步扫描并携带偏移 外层维按连续行纵向累加
+// 例: auto c = md::cumsum<1>(field); 或写入已分配的目标(可与x相同): md::cumsum<1>(field, dest);
+namespace md {
+
+template <size_t Axis, class Op, class V, class D>
+void scan(const V& x, D& dest) {
+  constexpr size_t Rank = std::tuple_size_v<decltype(x.shapes())>;
+  static_assert(Axis < Rank, "scan axis out of range");
+  if (x.shapes() != dest.shapes()) {
+    throw std::runtime_error("scan destination shape mismatch");
+  }
+  detail::scan_axis<Op>(x.cbegin(), x.shapes(), Axis, dest.begin());
+}
+
+template <size_t Axis, class V, class D>
+void cumsum(const V& x, D& dest) {
+  scan<Axis, SumReduceOp>(x, dest);
+}
+
+template <size_t Axis, class V, class D>
+void cumprod(const V& x, D& dest) {
+  scan<Axis, ProdReduceOp>(x, dest);
+}
+
+template <size_t Axis, class V>
+auto cumsum(const V& x) {
+  mdvector<typename V::value_type, std::tuple_size_v<decltype(x.shapes())>> result(x.shapes());
+  scan<Axis, SumReduceOp>(x, result);
+  return result;
+}
+
+template <size_t Axis, class V>
+auto cumprod(const V& x) {
+  mdvector<typename V::value_type, std::tuple_size_v<decltype(x.shapes())>> result(x.shapes());
+  scan<Axis, ProdReduceOp>(x, result);
+  return result;
+}
+
+}  // namespace md
+
 #endif  // HEADER_MDVECTOR_HPP_
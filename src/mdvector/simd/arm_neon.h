@@ -1,11 +1,34 @@
 #ifndef __MDVECTOR_ARM_NEON_H__
 #define __MDVECTOR_ARM_NEON_H__
 
+#include <cstdint>
+
 #include "simd_base.h"
 
 // ======================== NEON ========================
 #include <arm_neon.h>
 
+namespace md {
+namespace detail {
+
+// NEON没有非临时存储的intrinsic clang经__builtin_nontemporal_store生成STNP 其余编译器退化为普通存储
+template <class T, class V>
+inline void neon_stream(T* p, V v) {
+#if defined(__clang__)
+  __builtin_nontemporal_store(v, reinterpret_cast<V*>(p));
+#else
+  std::memcpy(p, &v, sizeof(V));
+#endif
+}
+
+inline void stream_fence() {}
+
+// 逐元素求值主循环每次处理的pack数
+inline constexpr size_t unroll_factor = 4;
+
+}  // namespace detail
+}  // namespace md
+
 template <>
 struct simd<float> {
   static constexpr size_t alignment = 16;
@@ -15,6 +38,7 @@ struct simd<float> {
   // 对齐操作
   static inline type load(const float* p) { return vld1q_f32(p); }
   static inline void store(float* p, type v) { vst1q_f32(p, v); }
+  static inline void stream(float* p, type v) { md::detail::neon_stream(p, v); }
 
   // 非对齐操作
   static inline type loadu(const float* p) {
@@ -35,6 +59,11 @@ struct simd<float> {
     return vmulq_f32(a, recp);
   }
 
+  // 融合乘加 a * b + c / a * b - c / c - a * b
+  static inline type fmadd(type a, type b, type c) { return vfmaq_f32(c, a, b); }
+  static inline type fmsub(type a, type b, type c) { return vnegq_f32(vfmsq_f32(c, a, b)); }
+  static inline type fnmadd(type a, type b, type c) { return vfmsq_f32(c, a, b); }
+
   // 对齐掩码操作
   static inline type mask_load(const float* p, const size_t& remaining) {
     static const uint32_t mask_pattern[4] = {0, 0, 0, 0};
@@ -64,6 +93,55 @@ struct simd<float> {
   }
 
   static inline type set1(float val) { return vdupq_n_f32(val); }
+
+  // 最值与取整
+  static inline type min(type a, type b) { return vminq_f32(a, b); }
+  static inline type max(type a, type b) { return vmaxq_f32(a, b); }
+  static inline type round(type a) { return vrndnq_f32(a); }
+  static inline type floor(type a) { return vrndmq_f32(a); }
+  static inline type ceil(type a) { return vrndpq_f32(a); }
+
+  // 开方 绝对值 取负
+  static inline type sqrt(type a) { return vsqrtq_f32(a); }
+  // 近似倒数 约8位精度 供快速除法牛顿迭代使用
+  static constexpr int rcp_bits = 8;
+  static inline type rcp(type a) { return vrecpeq_f32(a); }
+  static inline type abs(type a) { return vabsq_f32(a); }
+  static inline type neg(type a) { return vnegq_f32(a); }
+
+  // 通道整体向高位移动K个 低K个通道取自fill 用于前缀扫描
+  template <int K>
+  static inline type shift_up(type v, type fill) {
+    return vextq_f32(fill, v, 4 - K);
+  }
+  static inline type broadcast_last(type v) { return vdupq_laneq_f32(v, 3); }
+
+  // 比较与选择
+  using mask_type = uint32x4_t;
+  static inline mask_type cmp_lt(type a, type b) { return vcltq_f32(a, b); }
+  static inline mask_type cmp_le(type a, type b) { return vcleq_f32(a, b); }
+  static inline mask_type cmp_eq(type a, type b) { return vceqq_f32(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return vmvnq_u32(vceqq_f32(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vandq_u32(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vorrq_u32(a, b); }
+  static inline mask_type mask_not(mask_type a) { return vmvnq_u32(a); }
+  static inline type select(mask_type m, type a, type b) { return vbslq_f32(m, a, b); }
+
+  // 指数位操作 n为整数值 返回2^n
+  static inline type pow2n(type n) {
+    const auto e = vaddq_s32(vcvtnq_s32_f32(n), vdupq_n_s32(127));
+    return vreinterpretq_f32_s32(vshlq_n_s32(e, 23));
+  }
+  // 正规正数的指数 floor(log2(x))
+  static inline type get_exp(type x) {
+    const auto e = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_f32(x), 23));
+    return vcvtq_f32_s32(vsubq_s32(e, vdupq_n_s32(127)));
+  }
+  // 正规正数的尾数 [1, 2)
+  static inline type get_mant(type x) {
+    const auto m = vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x007FFFFF));
+    return vreinterpretq_f32_u32(vorrq_u32(m, vdupq_n_u32(0x3F800000)));
+  }
 };
 
 template <>
@@ -75,6 +153,7 @@ struct simd<double> {
   // 对齐操作
   static inline type load(const double* p) { return vld1q_f64(p); }
   static inline void store(double* p, type v) { vst1q_f64(p, v); }
+  static inline void stream(double* p, type v) { md::detail::neon_stream(p, v); }
 
   // 非对齐操作
   static inline type loadu(const double* p) {
@@ -95,6 +174,11 @@ struct simd<double> {
     return vmulq_f64(a, recp);
   }
 
+  // 融合乘加 a * b + c / a * b - c / c - a * b
+  static inline type fmadd(type a, type b, type c) { return vfmaq_f64(c, a, b); }
+  static inline type fmsub(type a, type b, type c) { return vnegq_f64(vfmsq_f64(c, a, b)); }
+  static inline type fnmadd(type a, type b, type c) { return vfmsq_f64(c, a, b); }
+
   // 对齐掩码操作
   static inline type mask_load(const double* p, const size_t& remaining) {
     static const uint64_t mask_pattern[2] = {0, 0};
@@ -124,5 +208,419 @@ struct simd<double> {
   }
 
   static inline type set1(double val) { return vdupq_n_f64(val); }
+
+  // 最值与取整
+  static inline type min(type a, type b) { return vminq_f64(a, b); }
+  static inline type max(type a, type b) { return vmaxq_f64(a, b); }
+  static inline type round(type a) { return vrndnq_f64(a); }
+  static inline type floor(type a) { return vrndmq_f64(a); }
+  static inline type ceil(type a) { return vrndpq_f64(a); }
+
+  // 开方 绝对值 取负
+  static inline type sqrt(type a) { return vsqrtq_f64(a); }
+  static constexpr int rcp_bits = 8;
+  static inline type rcp(type a) { return vrecpeq_f64(a); }
+  static inline type abs(type a) { return vabsq_f64(a); }
+  static inline type neg(type a) { return vnegq_f64(a); }
+
+  // 通道整体向高位移动K个 低K个通道取自fill 用于前缀扫描
+  template <int K>
+  static inline type shift_up(type v, type fill) {
+    return vextq_f64(fill, v, 2 - K);
+  }
+  static inline type broadcast_last(type v) { return vdupq_laneq_f64(v, 1); }
+
+  // 比较与选择
+  using mask_type = uint64x2_t;
+  static inline mask_type cmp_lt(type a, type b) { return vcltq_f64(a, b); }
+  static inline mask_type cmp_le(type a, type b) { return vcleq_f64(a, b); }
+  static inline mask_type cmp_eq(type a, type b) { return vceqq_f64(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(vceqq_f64(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vandq_u64(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vorrq_u64(a, b); }
+  static inline mask_type mask_not(mask_type a) { return veorq_u64(a, vdupq_n_u64(~0ULL)); }
+  static inline type select(mask_type m, type a, type b) { return vbslq_f64(m, a, b); }
+
+  // 指数位操作 n为整数值 返回2^n
+  static inline type pow2n(type n) {
+    const auto e = vaddq_s64(vcvtnq_s64_f64(n), vdupq_n_s64(1023));
+    return vreinterpretq_f64_s64(vshlq_n_s64(e, 52));
+  }
+  // 正规正数的指数 floor(log2(x))
+  static inline type get_exp(type x) {
+    const auto e = vreinterpretq_s64_u64(vshrq_n_u64(vreinterpretq_u64_f64(x), 52));
+    return vcvtq_f64_s64(vsubq_s64(e, vdupq_n_s64(1023)));
+  }
+  // 正规正数的尾数 [1, 2)
+  static inline type get_mant(type x) {
+    const auto m = vandq_u64(vreinterpretq_u64_f64(x), vdupq_n_u64(0x000FFFFFFFFFFFFF));
+    return vreinterpretq_f64_u64(vorrq_u64(m, vdupq_n_u64(0x3FF0000000000000)));
+  }
+};
+
+// ======================== NEON 整数 ========================
+// 掩码访存使用缓冲区 避免越界读取 除法与64位乘法逐通道回退
+// 移位以vshlq实现 负位数为右移 有符号类型为算术右移
+
+template <>
+struct simd<int32_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 4;
+  using type = int32x4_t;
+
+  // NEON访存不区分对齐
+  static inline type load(const int32_t* p) { return vld1q_s32(p); }
+  static inline void store(int32_t* p, type v) { vst1q_s32(p, v); }
+  static inline void stream(int32_t* p, type v) { md::detail::neon_stream(p, v); }
+  static inline type loadu(const int32_t* p) { return vld1q_s32(p); }
+  static inline void storeu(int32_t* p, type v) { vst1q_s32(p, v); }
+
+  // 算术运算
+  static inline type add(type a, type b) { return vaddq_s32(a, b); }
+  static inline type sub(type a, type b) { return vsubq_s32(a, b); }
+  static inline type mul(type a, type b) { return vmulq_s32(a, b); }
+  static inline type div(type a, type b) { return md::detail::int_div<int32_t>(a, b); }
+
+  // 乘加 a * b + c / a * b - c / c - a * b
+  static inline type fmadd(type a, type b, type c) { return vmlaq_s32(c, a, b); }
+  static inline type fmsub(type a, type b, type c) { return vsubq_s32(vmulq_s32(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return vmlsq_s32(c, a, b); }
+
+  // 掩码操作
+  static inline type mask_load(const int32_t* p, const size_t& remaining) {
+    return md::detail::partial_load<int32_t, type>(p, remaining);
+  }
+  static inline void mask_store(int32_t* p, const size_t& remaining, type v) {
+    md::detail::partial_store(p, remaining, v);
+  }
+  static inline type mask_loadu(const int32_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int32_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int32_t val) { return vdupq_n_s32(val); }
+
+  static inline type min(type a, type b) { return vminq_s32(a, b); }
+  static inline type max(type a, type b) { return vmaxq_s32(a, b); }
+  static inline type abs(type a) { return vabsq_s32(a); }
+  static inline type neg(type a) { return vnegq_s32(a); }
+
+  // 位运算与移位
+  static inline type bit_and(type a, type b) { return vandq_s32(a, b); }
+  static inline type bit_or(type a, type b) { return vorrq_s32(a, b); }
+  static inline type bit_xor(type a, type b) { return veorq_s32(a, b); }
+  static inline type bit_not(type a) { return vmvnq_s32(a); }
+  static inline type shl(type a, int n) { return vshlq_s32(a, vdupq_n_s32(static_cast<int32_t>(n))); }
+  static inline type shr(type a, int n) { return vshlq_s32(a, vdupq_n_s32(static_cast<int32_t>(-n))); }
+
+  // 比较与选择
+  using mask_type = uint32x4_t;
+  static inline mask_type cmp_lt(type a, type b) { return vcltq_s32(a, b); }
+  static inline mask_type cmp_le(type a, type b) { return vcleq_s32(a, b); }
+  static inline mask_type cmp_eq(type a, type b) { return vceqq_s32(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(vceqq_s32(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vandq_u32(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vorrq_u32(a, b); }
+  static inline mask_type mask_not(mask_type a) { return vmvnq_u32(a); }
+  static inline type select(mask_type m, type a, type b) { return vbslq_s32(m, a, b); }
+};
+
+template <>
+struct simd<int64_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 2;
+  using type = int64x2_t;
+
+  // NEON访存不区分对齐
+  static inline type load(const int64_t* p) { return vld1q_s64(p); }
+  static inline void store(int64_t* p, type v) { vst1q_s64(p, v); }
+  static inline void stream(int64_t* p, type v) { md::detail::neon_stream(p, v); }
+  static inline type loadu(const int64_t* p) { return vld1q_s64(p); }
+  static inline void storeu(int64_t* p, type v) { vst1q_s64(p, v); }
+
+  // 算术运算
+  static inline type add(type a, type b) { return vaddq_s64(a, b); }
+  static inline type sub(type a, type b) { return vsubq_s64(a, b); }
+  static inline type mul(type a, type b) {
+    return md::detail::lanewise<int64_t>(a, b, [](int64_t x, int64_t y) { return x * y; });
+  }
+  static inline type div(type a, type b) { return md::detail::int_div<int64_t>(a, b); }
+
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  // 掩码操作
+  static inline type mask_load(const int64_t* p, const size_t& remaining) {
+    return md::detail::partial_load<int64_t, type>(p, remaining);
+  }
+  static inline void mask_store(int64_t* p, const size_t& remaining, type v) {
+    md::detail::partial_store(p, remaining, v);
+  }
+  static inline type mask_loadu(const int64_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int64_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int64_t val) { return vdupq_n_s64(val); }
+
+  static inline type min(type a, type b) { return vbslq_s64(vcltq_s64(a, b), a, b); }
+  static inline type max(type a, type b) { return vbslq_s64(vcltq_s64(a, b), b, a); }
+  static inline type abs(type a) { return vabsq_s64(a); }
+  static inline type neg(type a) { return vnegq_s64(a); }
+
+  // 位运算与移位
+  static inline type bit_and(type a, type b) { return vandq_s64(a, b); }
+  static inline type bit_or(type a, type b) { return vorrq_s64(a, b); }
+  static inline type bit_xor(type a, type b) { return veorq_s64(a, b); }
+  static inline type bit_not(type a) { return veorq_s64(a, vdupq_n_s64(-1)); }
+  static inline type shl(type a, int n) { return vshlq_s64(a, vdupq_n_s64(static_cast<int64_t>(n))); }
+  static inline type shr(type a, int n) { return vshlq_s64(a, vdupq_n_s64(static_cast<int64_t>(-n))); }
+
+  // 比较与选择
+  using mask_type = uint64x2_t;
+  static inline mask_type cmp_lt(type a, type b) { return vcltq_s64(a, b); }
+  static inline mask_type cmp_le(type a, type b) { return vcleq_s64(a, b); }
+  static inline mask_type cmp_eq(type a, type b) { return vceqq_s64(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(vceqq_s64(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vandq_u64(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vorrq_u64(a, b); }
+  static inline mask_type mask_not(mask_type a) { return veorq_u64(a, vdupq_n_u64(~0ull)); }
+  static inline type select(mask_type m, type a, type b) { return vbslq_s64(m, a, b); }
+};
+
+template <>
+struct simd<int16_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 8;
+  using type = int16x8_t;
+
+  // NEON访存不区分对齐
+  static inline type load(const int16_t* p) { return vld1q_s16(p); }
+  static inline void store(int16_t* p, type v) { vst1q_s16(p, v); }
+  static inline void stream(int16_t* p, type v) { md::detail::neon_stream(p, v); }
+  static inline type loadu(const int16_t* p) { return vld1q_s16(p); }
+  static inline void storeu(int16_t* p, type v) { vst1q_s16(p, v); }
+
+  // 算术运算
+  static inline type add(type a, type b) { return vaddq_s16(a, b); }
+  static inline type sub(type a, type b) { return vsubq_s16(a, b); }
+  static inline type mul(type a, type b) { return vmulq_s16(a, b); }
+  static inline type div(type a, type b) { return md::detail::int_div<int16_t>(a, b); }
+
+  // 乘加 a * b + c / a * b - c / c - a * b
+  static inline type fmadd(type a, type b, type c) { return vmlaq_s16(c, a, b); }
+  static inline type fmsub(type a, type b, type c) { return vsubq_s16(vmulq_s16(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return vmlsq_s16(c, a, b); }
+
+  // 掩码操作
+  static inline type mask_load(const int16_t* p, const size_t& remaining) {
+    return md::detail::partial_load<int16_t, type>(p, remaining);
+  }
+  static inline void mask_store(int16_t* p, const size_t& remaining, type v) {
+    md::detail::partial_store(p, remaining, v);
+  }
+  static inline type mask_loadu(const int16_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int16_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int16_t val) { return vdupq_n_s16(val); }
+
+  static inline type min(type a, type b) { return vminq_s16(a, b); }
+  static inline type max(type a, type b) { return vmaxq_s16(a, b); }
+  static inline type abs(type a) { return vabsq_s16(a); }
+  static inline type neg(type a) { return vnegq_s16(a); }
+
+  // 位运算与移位
+  static inline type bit_and(type a, type b) { return vandq_s16(a, b); }
+  static inline type bit_or(type a, type b) { return vorrq_s16(a, b); }
+  static inline type bit_xor(type a, type b) { return veorq_s16(a, b); }
+  static inline type bit_not(type a) { return vmvnq_s16(a); }
+  static inline type shl(type a, int n) { return vshlq_s16(a, vdupq_n_s16(static_cast<int16_t>(n))); }
+  static inline type shr(type a, int n) { return vshlq_s16(a, vdupq_n_s16(static_cast<int16_t>(-n))); }
+
+  // 比较与选择
+  using mask_type = uint16x8_t;
+  static inline mask_type cmp_lt(type a, type b) { return vcltq_s16(a, b); }
+  static inline mask_type cmp_le(type a, type b) { return vcleq_s16(a, b); }
+  static inline mask_type cmp_eq(type a, type b) { return vceqq_s16(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(vceqq_s16(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vandq_u16(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vorrq_u16(a, b); }
+  static inline mask_type mask_not(mask_type a) { return vmvnq_u16(a); }
+  static inline type select(mask_type m, type a, type b) { return vbslq_s16(m, a, b); }
+};
+
+template <>
+struct simd<uint8_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 16;
+  using type = uint8x16_t;
+
+  // NEON访存不区分对齐
+  static inline type load(const uint8_t* p) { return vld1q_u8(p); }
+  static inline void store(uint8_t* p, type v) { vst1q_u8(p, v); }
+  static inline void stream(uint8_t* p, type v) { md::detail::neon_stream(p, v); }
+  static inline type loadu(const uint8_t* p) { return vld1q_u8(p); }
+  static inline void storeu(uint8_t* p, type v) { vst1q_u8(p, v); }
+
+  // 算术运算
+  static inline type add(type a, type b) { return vaddq_u8(a, b); }
+  static inline type sub(type a, type b) { return vsubq_u8(a, b); }
+  static inline type mul(type a, type b) { return vmulq_u8(a, b); }
+  static inline type div(type a, type b) { return md::detail::int_div<uint8_t>(a, b); }
+
+  // 乘加 a * b + c / a * b - c / c - a * b
+  static inline type fmadd(type a, type b, type c) { return vmlaq_u8(c, a, b); }
+  static inline type fmsub(type a, type b, type c) { return vsubq_u8(vmulq_u8(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return vmlsq_u8(c, a, b); }
+
+  // 掩码操作
+  static inline type mask_load(const uint8_t* p, const size_t& remaining) {
+    return md::detail::partial_load<uint8_t, type>(p, remaining);
+  }
+  static inline void mask_store(uint8_t* p, const size_t& remaining, type v) {
+    md::detail::partial_store(p, remaining, v);
+  }
+  static inline type mask_loadu(const uint8_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(uint8_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(uint8_t val) { return vdupq_n_u8(val); }
+
+  // 取负按256取模
+  static inline type min(type a, type b) { return vminq_u8(a, b); }
+  static inline type max(type a, type b) { return vmaxq_u8(a, b); }
+  static inline type abs(type a) { return a; }
+  static inline type neg(type a) { return vsubq_u8(vdupq_n_u8(0), a); }
+
+  // 位运算与移位
+  static inline type bit_and(type a, type b) { return vandq_u8(a, b); }
+  static inline type bit_or(type a, type b) { return vorrq_u8(a, b); }
+  static inline type bit_xor(type a, type b) { return veorq_u8(a, b); }
+  static inline type bit_not(type a) { return vmvnq_u8(a); }
+  static inline type shl(type a, int n) { return vshlq_u8(a, vdupq_n_s8(static_cast<int8_t>(n))); }
+  static inline type shr(type a, int n) { return vshlq_u8(a, vdupq_n_s8(static_cast<int8_t>(-n))); }
+
+  // 比较与选择
+  using mask_type = uint8x16_t;
+  static inline mask_type cmp_lt(type a, type b) { return vcltq_u8(a, b); }
+  static inline mask_type cmp_le(type a, type b) { return vcleq_u8(a, b); }
+  static inline mask_type cmp_eq(type a, type b) { return vceqq_u8(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(vceqq_u8(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vandq_u8(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vorrq_u8(a, b); }
+  static inline mask_type mask_not(mask_type a) { return vmvnq_u8(a); }
+  static inline type select(mask_type m, type a, type b) { return vbslq_u8(m, a, b); }
+};
+
+
+// ======================== 16位浮点存储 ========================
+// 存储为16位 寄存器内扩展为simd<float>计算 尾部经栈缓冲处理
+template <>
+struct simd_storage<md::half> {
+  static constexpr size_t pack_size = simd<float>::pack_size;
+  using type = simd<float>::type;
+
+  static inline type loadu(const md::half* p) {
+    return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(reinterpret_cast<const uint16_t*>(p))));
+  }
+  static inline void storeu(md::half* p, type v) {
+    vst1_u16(reinterpret_cast<uint16_t*>(p), vreinterpret_u16_f16(vcvt_f16_f32(v)));
+  }
+
+  static inline type load(const md::half* p) { return loadu(p); }
+  static inline void store(md::half* p, type v) { storeu(p, v); }
+  static inline type mask_load(const md::half* p, const size_t& remaining) { return mask_loadu(p, remaining); }
+  static inline void mask_store(md::half* p, const size_t& remaining, type v) { mask_storeu(p, remaining, v); }
+  static inline type mask_loadu(const md::half* p, const size_t& remaining) {
+    return md::detail::storage_partial_load<simd_storage>(p, remaining);
+  }
+  static inline void mask_storeu(md::half* p, const size_t& remaining, type v) {
+    md::detail::storage_partial_store<simd_storage>(p, remaining, v);
+  }
+};
+
+// bfloat16为float的高16位 扩展为移位 收窄按就近舍入(偶数) NaN保持为静默NaN
+template <>
+struct simd_storage<md::bfloat16> {
+  static constexpr size_t pack_size = simd<float>::pack_size;
+  using type = simd<float>::type;
+
+  static inline type loadu(const md::bfloat16* p) {
+    return vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(reinterpret_cast<const uint16_t*>(p)), 16));
+  }
+  static inline void storeu(md::bfloat16* p, type v) {
+    const uint32x4_t x = vreinterpretq_u32_f32(v);
+    const uint32x4_t lsb = vandq_u32(vshrq_n_u32(x, 16), vdupq_n_u32(1));
+    const uint32x4_t r = vshrq_n_u32(vaddq_u32(x, vaddq_u32(lsb, vdupq_n_u32(0x7FFF))), 16);
+    const uint32x4_t nan = vorrq_u32(vshrq_n_u32(x, 16), vdupq_n_u32(0x40));
+    const uint32x4_t ordered = vceqq_f32(v, v);
+    vst1_u16(reinterpret_cast<uint16_t*>(p), vmovn_u32(vbslq_u32(ordered, r, nan)));
+  }
+
+  static inline type load(const md::bfloat16* p) { return loadu(p); }
+  static inline void store(md::bfloat16* p, type v) { storeu(p, v); }
+  static inline type mask_load(const md::bfloat16* p, const size_t& remaining) { return mask_loadu(p, remaining); }
+  static inline void mask_store(md::bfloat16* p, const size_t& remaining, type v) { mask_storeu(p, remaining, v); }
+  static inline type mask_loadu(const md::bfloat16* p, const size_t& remaining) {
+    return md::detail::storage_partial_load<simd_storage>(p, remaining);
+  }
+  static inline void mask_storeu(md::bfloat16* p, const size_t& remaining, type v) {
+    md::detail::storage_partial_store<simd_storage>(p, remaining, v);
+  }
+};
+
+// ======================== 元素类型转换 ========================
+// float -> double 加载2个float扩展
+template <>
+struct simd_convert<float, double> {
+  static inline simd<double>::type loadu(const float* p) { return vcvt_f64_f32(vld1_f32(p)); }
+  static inline simd<double>::type mask_loadu(const float* p, const size_t& remaining) {
+    return remaining == 0 ? vdupq_n_f64(0.0) : vcvt_f64_f32(vset_lane_f32(p[0], vdup_n_f32(0.0f), 0));
+  }
+};
+
+// double -> float 两个float64x2_t收窄为一个float32x4_t
+template <>
+struct simd_convert<double, float> {
+  static inline simd<float>::type narrow(simd<double>::type lo, simd<double>::type hi) {
+    return vcvt_high_f32_f64(vcvt_f32_f64(lo), hi);
+  }
+  static inline simd<float>::type loadu(const double* p) { return narrow(vld1q_f64(p), vld1q_f64(p + 2)); }
+  static inline simd<float>::type mask_loadu(const double* p, const size_t& remaining) {
+    return md::detail::narrow_mask_loadu<simd_convert>(p, remaining);
+  }
+};
+
+template <>
+struct simd_convert<int32_t, float> {
+  static inline simd<float>::type apply(simd<int32_t>::type v) { return vcvtq_f32_s32(v); }
+  static inline simd<float>::type loadu(const int32_t* p) { return apply(simd<int32_t>::loadu(p)); }
+  static inline simd<float>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return apply(simd<int32_t>::mask_loadu(p, remaining));
+  }
+};
+
+// int32_t -> double/int64_t 加载2个int32_t扩展 结果精确 用于整数表达式的扩展转换与按更宽类型加载
+template <>
+struct simd_convert<int32_t, double> {
+  static inline simd<double>::type loadu(const int32_t* p) { return vcvtq_f64_s64(vmovl_s32(vld1_s32(p))); }
+  static inline simd<double>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return vcvtq_f64_s64(vmovl_s32(vget_low_s32(simd<int32_t>::mask_loadu(p, remaining))));
+  }
+};
+
+template <>
+struct simd_convert<int32_t, int64_t> {
+  static inline simd<int64_t>::type loadu(const int32_t* p) { return vmovl_s32(vld1_s32(p)); }
+  static inline simd<int64_t>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return vmovl_s32(vget_low_s32(simd<int32_t>::mask_loadu(p, remaining)));
+  }
+};
+
+// 向零截断 与static_cast一致
+template <>
+struct simd_convert<float, int32_t> {
+  static inline simd<int32_t>::type apply(simd<float>::type v) { return vcvtq_s32_f32(v); }
+  static inline simd<int32_t>::type loadu(const float* p) { return apply(simd<float>::loadu(p)); }
+  static inline simd<int32_t>::type mask_loadu(const float* p, const size_t& remaining) {
+    return apply(simd<float>::mask_loadu(p, remaining));
+  }
 };
 #endif  // __ARM_NEON_H__
\ No newline at end of file
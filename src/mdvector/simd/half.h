@@ -0,0 +1,127 @@
+#ifndef __MDVECTOR_HALF_H__
+#define __MDVECTOR_HALF_H__
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// ======================== 16位浮点存储类型 ========================
+// 只用于存储 表达式计算时扩展为float 写回时按就近舍入(偶数)收窄
+// 内存流量减半 适用于带宽受限且寄存器内float精度足够的场景
+namespace md {
+namespace detail {
+
+inline uint32_t float_bits(float f) {
+  uint32_t x;
+  std::memcpy(&x, &f, sizeof(x));
+  return x;
+}
+
+inline float bits_float(uint32_t x) {
+  float f;
+  std::memcpy(&f, &x, sizeof(f));
+  return f;
+}
+
+// float -> IEEE 754 binary16 就近舍入到偶数 溢出为inf 支持非规格化数
+inline uint16_t float_to_half_bits(float f) {
+  uint32_t x = float_bits(f);
+  const uint32_t sign = (x >> 16) & 0x8000;
+  x &= 0x7FFFFFFF;
+  if (x >= 0x7F800000) {
+    return static_cast<uint16_t>(sign | (x > 0x7F800000 ? 0x7E00 : 0x7C00));  // NaN / inf
+  }
+  if (x >= 0x477FF000) {
+    return static_cast<uint16_t>(sign | 0x7C00);  // >= 65520 舍入为inf
+  }
+  if (x < 0x38800000) {
+    // 非规格化数 单位2^-24
+    if (x < 0x33000000) {
+      return static_cast<uint16_t>(sign);
+    }
+    const uint32_t shift = 126 - (x >> 23);
+    const uint32_t m = (x & 0x007FFFFF) | 0x00800000;
+    uint32_t r = m >> shift;
+    const uint32_t rem = m & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (rem > halfway || (rem == halfway && (r & 1))) ++r;
+    return static_cast<uint16_t>(sign | r);
+  }
+  // 规格化数 指数偏置127 -> 15 舍入进位可直接进入指数位
+  const uint32_t r = x - 0x38000000;
+  return static_cast<uint16_t>(sign | ((r + 0x0FFF + ((r >> 13) & 1)) >> 13));
+}
+
+inline float half_bits_to_float(uint16_t h) {
+  const uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+  const uint32_t e = (h >> 10) & 0x1F;
+  const uint32_t m = h & 0x03FF;
+  if (e == 0x1F) {
+    return bits_float(sign | 0x7F800000 | (m << 13));
+  }
+  if (e == 0) {
+    const float f = static_cast<float>(m) * 5.9604644775390625e-8f;  // m * 2^-24
+    return sign ? -f : f;
+  }
+  return bits_float(sign | ((e + 112) << 23) | (m << 13));
+}
+
+// float -> bfloat16 取高16位 就近舍入到偶数 NaN保持为静默NaN
+inline uint16_t float_to_bfloat16_bits(float f) {
+  const uint32_t x = float_bits(f);
+  if ((x & 0x7FFFFFFF) > 0x7F800000) {
+    return static_cast<uint16_t>((x >> 16) | 0x40);
+  }
+  return static_cast<uint16_t>((x + 0x7FFF + ((x >> 16) & 1)) >> 16);
+}
+
+inline float bfloat16_bits_to_float(uint16_t b) { return bits_float(static_cast<uint32_t>(b) << 16); }
+
+}  // namespace detail
+
+// IEEE 754 半精度 1位符号 5位指数 10位尾数
+struct half {
+  uint16_t bits;
+
+  half() = default;
+  half(float f) : bits(detail::float_to_half_bits(f)) {}
+  operator float() const { return detail::half_bits_to_float(bits); }
+};
+
+// bfloat16 1位符号 8位指数 7位尾数 与float指数范围相同
+struct bfloat16 {
+  uint16_t bits;
+
+  bfloat16() = default;
+  bfloat16(float f) : bits(detail::float_to_bfloat16_bits(f)) {}
+  operator float() const { return detail::bfloat16_bits_to_float(bits); }
+};
+
+static_assert(sizeof(half) == 2 && sizeof(bfloat16) == 2, "16-bit storage types must be 2 bytes");
+
+}  // namespace md
+
+// 存储类型 -> 计算类型
+template <class T>
+struct compute_type {
+  using type = T;
+};
+
+template <>
+struct compute_type<md::half> {
+  using type = float;
+};
+
+template <>
+struct compute_type<md::bfloat16> {
+  using type = float;
+};
+
+template <class T>
+using compute_type_t = typename compute_type<T>::type;
+
+// 存储类型与计算类型不同 访存时需要转换
+template <class T>
+inline constexpr bool is_storage_type_v = !std::is_same_v<compute_type_t<T>, T>;
+
+#endif  // __MDVECTOR_HALF_H__
@@ -1,11 +1,25 @@
 #ifndef __MDVECTOR_RISC_V_H__
 #define __MDVECTOR_RISC_V_H__
 
+#include <cstdint>
+
 #include "simd_base.h"
 
 // ======================== RISC-V Vector ========================
 #include <riscv_vector.h>  // 需要支持RVV 1.0的编译器
 
+namespace md {
+namespace detail {
+
+// RVV intrinsic不提供非临时提示 stream即普通存储 无需屏障
+inline void stream_fence() {}
+
+// 逐元素求值主循环每次处理的pack数
+inline constexpr size_t unroll_factor = 2;
+
+}  // namespace detail
+}  // namespace md
+
 template <>
 struct simd<float> {
   static constexpr size_t alignment = 16;
@@ -14,10 +28,14 @@ struct simd<float> {
 
   static inline type load(const float* p) { return vle32_v_f32m1(p, pack_size); }
   static inline void store(float* p, type v) { vse32_v_f32m1(p, v, pack_size); }
+  static inline void stream(float* p, type v) { store(p, v); }
   static inline type add(type a, type b) { return vfadd_vv_f32m1(a, b, pack_size); }
   static inline type sub(type a, type b) { return vfsub_vv_f32m1(a, b, pack_size); }
   static inline type mul(type a, type b) { return vfmul_vv_f32m1(a, b, pack_size); }
   static inline type div(type a, type b) { return vfdiv_vv_f32m1(a, b, pack_size); }
+  static inline type fmadd(type a, type b, type c) { return vfmacc_vv_f32m1(c, a, b, pack_size); }
+  static inline type fmsub(type a, type b, type c) { return vfmsac_vv_f32m1(c, a, b, pack_size); }
+  static inline type fnmadd(type a, type b, type c) { return vfnmsac_vv_f32m1(c, a, b, pack_size); }
 
   static inline type mask_load(const float* p, const size_t& remaining) {
     vbool32_t mask = vmset_m_b32(remaining, pack_size);
@@ -27,8 +45,63 @@ struct simd<float> {
     vbool32_t mask = vmset_m_b32(remaining, pack_size);
     vse32_v_f32m1_m(mask, p, v, pack_size);
   }
+  // RVV访存只要求元素对齐 非对齐版本直接复用
+  static inline type loadu(const float* p) { return load(p); }
+  static inline void storeu(float* p, type v) { store(p, v); }
+  static inline type mask_loadu(const float* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(float* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
 
   static inline type set1(float val) { return vfmv_v_f_f32m1(val, pack_size); }
+
+  static inline type min(type a, type b) { return vfmin_vv_f32m1(a, b, pack_size); }
+  static inline type max(type a, type b) { return vfmax_vv_f32m1(a, b, pack_size); }
+  static inline type round(type a) { return vfcvt_f_x_v_f32m1(vfcvt_x_f_v_i32m1(a, pack_size), pack_size); }
+  // 向下/向上取整 由就近取整结果修正
+  static inline type floor(type a) {
+    const type r = round(a);
+    return select(vmflt_vv_f32m1_b32(a, r, pack_size), vfsub_vf_f32m1(r, 1, pack_size), r);
+  }
+  static inline type ceil(type a) {
+    const type r = round(a);
+    return select(vmflt_vv_f32m1_b32(r, a, pack_size), vfadd_vf_f32m1(r, 1, pack_size), r);
+  }
+
+  static inline type sqrt(type a) { return vfsqrt_v_f32m1(a, pack_size); }
+  // 近似倒数 7位精度 供快速除法牛顿迭代使用
+  static constexpr int rcp_bits = 7;
+  static inline type rcp(type a) { return vfrec7_v_f32m1(a, pack_size); }
+  static inline type abs(type a) { return vfabs_v_f32m1(a, pack_size); }
+  static inline type neg(type a) { return vfneg_v_f32m1(a, pack_size); }
+
+  // 通道整体向高位移动K个 低K个通道取自fill 用于前缀扫描
+  template <int K>
+  static inline type shift_up(type v, type fill) {
+    return vslideup_vx_f32m1(fill, v, K, pack_size);
+  }
+  static inline type broadcast_last(type v) { return vrgather_vx_f32m1(v, pack_size - 1, pack_size); }
+
+  using mask_type = vbool32_t;
+  static inline mask_type cmp_lt(type a, type b) { return vmflt_vv_f32m1_b32(a, b, pack_size); }
+  static inline mask_type cmp_le(type a, type b) { return vmfle_vv_f32m1_b32(a, b, pack_size); }
+  static inline mask_type cmp_eq(type a, type b) { return vmfeq_vv_f32m1_b32(a, b, pack_size); }
+  static inline mask_type cmp_ne(type a, type b) { return vmfne_vv_f32m1_b32(a, b, pack_size); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vmand_mm_b32(a, b, pack_size); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vmor_mm_b32(a, b, pack_size); }
+  static inline mask_type mask_not(mask_type a) { return vmnot_m_b32(a, pack_size); }
+  static inline type select(mask_type m, type a, type b) { return vmerge_vvm_f32m1(m, b, a, pack_size); }
+
+  static inline type pow2n(type n) {
+    auto e = vadd_vx_i32m1(vfcvt_x_f_v_i32m1(n, pack_size), 127, pack_size);
+    return vreinterpret_v_i32m1_f32m1(vsll_vx_i32m1(e, 23, pack_size));
+  }
+  static inline type get_exp(type x) {
+    auto e = vreinterpret_v_u32m1_i32m1(vsrl_vx_u32m1(vreinterpret_v_f32m1_u32m1(x), 23, pack_size));
+    return vfcvt_f_x_v_f32m1(vsub_vx_i32m1(e, 127, pack_size), pack_size);
+  }
+  static inline type get_mant(type x) {
+    auto m = vand_vx_u32m1(vreinterpret_v_f32m1_u32m1(x), 0x007FFFFF, pack_size);
+    return vreinterpret_v_u32m1_f32m1(vor_vx_u32m1(m, 0x3F800000, pack_size));
+  }
 };
 
 template <>
@@ -39,10 +112,14 @@ struct simd<double> {
 
   static inline type load(const double* p) { return vle64_v_f64m1(p, pack_size); }
   static inline void store(double* p, type v) { vse64_v_f64m1(p, v, pack_size); }
+  static inline void stream(double* p, type v) { store(p, v); }
   static inline type add(type a, type b) { return vfadd_vv_f64m1(a, b, pack_size); }
   static inline type sub(type a, type b) { return vfsub_vv_f64m1(a, b, pack_size); }
   static inline type mul(type a, type b) { return vfmul_vv_f64m1(a, b, pack_size); }
   static inline type div(type a, type b) { return vfdiv_vv_f64m1(a, b, pack_size); }
+  static inline type fmadd(type a, type b, type c) { return vfmacc_vv_f64m1(c, a, b, pack_size); }
+  static inline type fmsub(type a, type b, type c) { return vfmsac_vv_f64m1(c, a, b, pack_size); }
+  static inline type fnmadd(type a, type b, type c) { return vfnmsac_vv_f64m1(c, a, b, pack_size); }
 
   static inline type mask_load(const double* p, const size_t& remaining) {
     vbool64_t mask = vmset_m_b64(remaining, pack_size);
@@ -52,7 +129,326 @@ struct simd<double> {
     vbool64_t mask = vmset_m_b64(remaining, pack_size);
     vse64_v_f64m1_m(mask, p, v, pack_size);
   }
+  // RVV访存只要求元素对齐 非对齐版本直接复用
+  static inline type loadu(const double* p) { return load(p); }
+  static inline void storeu(double* p, type v) { store(p, v); }
+  static inline type mask_loadu(const double* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(double* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
 
   static inline type set1(double val) { return vfmv_v_f_f64m1(val, pack_size); }
+
+  static inline type min(type a, type b) { return vfmin_vv_f64m1(a, b, pack_size); }
+  static inline type max(type a, type b) { return vfmax_vv_f64m1(a, b, pack_size); }
+  static inline type round(type a) { return vfcvt_f_x_v_f64m1(vfcvt_x_f_v_i64m1(a, pack_size), pack_size); }
+  // 向下/向上取整 由就近取整结果修正
+  static inline type floor(type a) {
+    const type r = round(a);
+    return select(vmflt_vv_f64m1_b64(a, r, pack_size), vfsub_vf_f64m1(r, 1, pack_size), r);
+  }
+  static inline type ceil(type a) {
+    const type r = round(a);
+    return select(vmflt_vv_f64m1_b64(r, a, pack_size), vfadd_vf_f64m1(r, 1, pack_size), r);
+  }
+
+  static inline type sqrt(type a) { return vfsqrt_v_f64m1(a, pack_size); }
+  static constexpr int rcp_bits = 7;
+  static inline type rcp(type a) { return vfrec7_v_f64m1(a, pack_size); }
+  static inline type abs(type a) { return vfabs_v_f64m1(a, pack_size); }
+  static inline type neg(type a) { return vfneg_v_f64m1(a, pack_size); }
+
+  // 通道整体向高位移动K个 低K个通道取自fill 用于前缀扫描
+  template <int K>
+  static inline type shift_up(type v, type fill) {
+    return vslideup_vx_f64m1(fill, v, K, pack_size);
+  }
+  static inline type broadcast_last(type v) { return vrgather_vx_f64m1(v, pack_size - 1, pack_size); }
+
+  using mask_type = vbool64_t;
+  static inline mask_type cmp_lt(type a, type b) { return vmflt_vv_f64m1_b64(a, b, pack_size); }
+  static inline mask_type cmp_le(type a, type b) { return vmfle_vv_f64m1_b64(a, b, pack_size); }
+  static inline mask_type cmp_eq(type a, type b) { return vmfeq_vv_f64m1_b64(a, b, pack_size); }
+  static inline mask_type cmp_ne(type a, type b) { return vmfne_vv_f64m1_b64(a, b, pack_size); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vmand_mm_b64(a, b, pack_size); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vmor_mm_b64(a, b, pack_size); }
+  static inline mask_type mask_not(mask_type a) { return vmnot_m_b64(a, pack_size); }
+  static inline type select(mask_type m, type a, type b) { return vmerge_vvm_f64m1(m, b, a, pack_size); }
+
+  static inline type pow2n(type n) {
+    auto e = vadd_vx_i64m1(vfcvt_x_f_v_i64m1(n, pack_size), 1023, pack_size);
+    return vreinterpret_v_i64m1_f64m1(vsll_vx_i64m1(e, 52, pack_size));
+  }
+  static inline type get_exp(type x) {
+    auto e = vreinterpret_v_u64m1_i64m1(vsrl_vx_u64m1(vreinterpret_v_f64m1_u64m1(x), 52, pack_size));
+    return vfcvt_f_x_v_f64m1(vsub_vx_i64m1(e, 1023, pack_size), pack_size);
+  }
+  static inline type get_mant(type x) {
+    auto m = vand_vx_u64m1(vreinterpret_v_f64m1_u64m1(x), 0x000FFFFFFFFFFFFF, pack_size);
+    return vreinterpret_v_u64m1_f64m1(vor_vx_u64m1(m, 0x3FF0000000000000, pack_size));
+  }
+};
+
+// ======================== RISC-V Vector 整数 ========================
+// 除法为原生指令 除数为0时结果全1 不触发异常
+// 移位位数只取低log2(SEW)位
+
+template <>
+struct simd<int32_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 4;  // 假设VLEN=128位
+  using type = vint32m1_t;
+
+  static inline type load(const int32_t* p) { return vle32_v_i32m1(p, pack_size); }
+  static inline void store(int32_t* p, type v) { vse32_v_i32m1(p, v, pack_size); }
+  static inline void stream(int32_t* p, type v) { store(p, v); }
+  static inline type add(type a, type b) { return vadd_vv_i32m1(a, b, pack_size); }
+  static inline type sub(type a, type b) { return vsub_vv_i32m1(a, b, pack_size); }
+  static inline type mul(type a, type b) { return vmul_vv_i32m1(a, b, pack_size); }
+  static inline type div(type a, type b) { return vdiv_vv_i32m1(a, b, pack_size); }
+  static inline type fmadd(type a, type b, type c) { return vmacc_vv_i32m1(c, a, b, pack_size); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return vnmsac_vv_i32m1(c, a, b, pack_size); }
+
+  // 通道序号 < remaining 无效通道以0填充
+  static inline vbool32_t mask(const size_t& remaining) {
+    return vmsltu_vx_u32m1_b32(vid_v_u32m1(pack_size), remaining, pack_size);
+  }
+  static inline type mask_load(const int32_t* p, const size_t& remaining) {
+    return vle32_v_i32m1_m(mask(remaining), set1(0), p, pack_size);
+  }
+  static inline void mask_store(int32_t* p, const size_t& remaining, type v) {
+    vse32_v_i32m1_m(mask(remaining), p, v, pack_size);
+  }
+  // RVV访存只要求元素对齐 非对齐版本直接复用
+  static inline type loadu(const int32_t* p) { return load(p); }
+  static inline void storeu(int32_t* p, type v) { store(p, v); }
+  static inline type mask_loadu(const int32_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int32_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int32_t val) { return vmv_v_x_i32m1(val, pack_size); }
+
+  static inline type min(type a, type b) { return vmin_vv_i32m1(a, b, pack_size); }
+  static inline type max(type a, type b) { return vmax_vv_i32m1(a, b, pack_size); }
+  static inline type abs(type a) { return select(vmslt_vx_i32m1_b32(a, 0, pack_size), neg(a), a); }
+  static inline type neg(type a) { return vneg_v_i32m1(a, pack_size); }
+
+  static inline type bit_and(type a, type b) { return vand_vv_i32m1(a, b, pack_size); }
+  static inline type bit_or(type a, type b) { return vor_vv_i32m1(a, b, pack_size); }
+  static inline type bit_xor(type a, type b) { return vxor_vv_i32m1(a, b, pack_size); }
+  static inline type bit_not(type a) { return vnot_v_i32m1(a, pack_size); }
+  static inline type shl(type a, int n) { return vsll_vx_i32m1(a, n, pack_size); }
+  static inline type shr(type a, int n) { return vsra_vx_i32m1(a, n, pack_size); }
+
+  using mask_type = vbool32_t;
+  static inline mask_type cmp_lt(type a, type b) { return vmslt_vv_i32m1_b32(a, b, pack_size); }
+  static inline mask_type cmp_le(type a, type b) { return vmsle_vv_i32m1_b32(a, b, pack_size); }
+  static inline mask_type cmp_eq(type a, type b) { return vmseq_vv_i32m1_b32(a, b, pack_size); }
+  static inline mask_type cmp_ne(type a, type b) { return vmsne_vv_i32m1_b32(a, b, pack_size); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vmand_mm_b32(a, b, pack_size); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vmor_mm_b32(a, b, pack_size); }
+  static inline mask_type mask_not(mask_type a) { return vmnot_m_b32(a, pack_size); }
+  static inline type select(mask_type m, type a, type b) { return vmerge_vvm_i32m1(m, b, a, pack_size); }
+};
+
+template <>
+struct simd<int64_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 2;  // 假设VLEN=128位
+  using type = vint64m1_t;
+
+  static inline type load(const int64_t* p) { return vle64_v_i64m1(p, pack_size); }
+  static inline void store(int64_t* p, type v) { vse64_v_i64m1(p, v, pack_size); }
+  static inline void stream(int64_t* p, type v) { store(p, v); }
+  static inline type add(type a, type b) { return vadd_vv_i64m1(a, b, pack_size); }
+  static inline type sub(type a, type b) { return vsub_vv_i64m1(a, b, pack_size); }
+  static inline type mul(type a, type b) { return vmul_vv_i64m1(a, b, pack_size); }
+  static inline type div(type a, type b) { return vdiv_vv_i64m1(a, b, pack_size); }
+  static inline type fmadd(type a, type b, type c) { return vmacc_vv_i64m1(c, a, b, pack_size); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return vnmsac_vv_i64m1(c, a, b, pack_size); }
+
+  // 通道序号 < remaining 无效通道以0填充
+  static inline vbool64_t mask(const size_t& remaining) {
+    return vmsltu_vx_u64m1_b64(vid_v_u64m1(pack_size), remaining, pack_size);
+  }
+  static inline type mask_load(const int64_t* p, const size_t& remaining) {
+    return vle64_v_i64m1_m(mask(remaining), set1(0), p, pack_size);
+  }
+  static inline void mask_store(int64_t* p, const size_t& remaining, type v) {
+    vse64_v_i64m1_m(mask(remaining), p, v, pack_size);
+  }
+  // RVV访存只要求元素对齐 非对齐版本直接复用
+  static inline type loadu(const int64_t* p) { return load(p); }
+  static inline void storeu(int64_t* p, type v) { store(p, v); }
+  static inline type mask_loadu(const int64_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int64_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int64_t val) { return vmv_v_x_i64m1(val, pack_size); }
+
+  static inline type min(type a, type b) { return vmin_vv_i64m1(a, b, pack_size); }
+  static inline type max(type a, type b) { return vmax_vv_i64m1(a, b, pack_size); }
+  static inline type abs(type a) { return select(vmslt_vx_i64m1_b64(a, 0, pack_size), neg(a), a); }
+  static inline type neg(type a) { return vneg_v_i64m1(a, pack_size); }
+
+  static inline type bit_and(type a, type b) { return vand_vv_i64m1(a, b, pack_size); }
+  static inline type bit_or(type a, type b) { return vor_vv_i64m1(a, b, pack_size); }
+  static inline type bit_xor(type a, type b) { return vxor_vv_i64m1(a, b, pack_size); }
+  static inline type bit_not(type a) { return vnot_v_i64m1(a, pack_size); }
+  static inline type shl(type a, int n) { return vsll_vx_i64m1(a, n, pack_size); }
+  static inline type shr(type a, int n) { return vsra_vx_i64m1(a, n, pack_size); }
+
+  using mask_type = vbool64_t;
+  static inline mask_type cmp_lt(type a, type b) { return vmslt_vv_i64m1_b64(a, b, pack_size); }
+  static inline mask_type cmp_le(type a, type b) { return vmsle_vv_i64m1_b64(a, b, pack_size); }
+  static inline mask_type cmp_eq(type a, type b) { return vmseq_vv_i64m1_b64(a, b, pack_size); }
+  static inline mask_type cmp_ne(type a, type b) { return vmsne_vv_i64m1_b64(a, b, pack_size); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vmand_mm_b64(a, b, pack_size); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vmor_mm_b64(a, b, pack_size); }
+  static inline mask_type mask_not(mask_type a) { return vmnot_m_b64(a, pack_size); }
+  static inline type select(mask_type m, type a, type b) { return vmerge_vvm_i64m1(m, b, a, pack_size); }
+};
+
+template <>
+struct simd<int16_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 8;  // 假设VLEN=128位
+  using type = vint16m1_t;
+
+  static inline type load(const int16_t* p) { return vle16_v_i16m1(p, pack_size); }
+  static inline void store(int16_t* p, type v) { vse16_v_i16m1(p, v, pack_size); }
+  static inline void stream(int16_t* p, type v) { store(p, v); }
+  static inline type add(type a, type b) { return vadd_vv_i16m1(a, b, pack_size); }
+  static inline type sub(type a, type b) { return vsub_vv_i16m1(a, b, pack_size); }
+  static inline type mul(type a, type b) { return vmul_vv_i16m1(a, b, pack_size); }
+  static inline type div(type a, type b) { return vdiv_vv_i16m1(a, b, pack_size); }
+  static inline type fmadd(type a, type b, type c) { return vmacc_vv_i16m1(c, a, b, pack_size); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return vnmsac_vv_i16m1(c, a, b, pack_size); }
+
+  // 通道序号 < remaining 无效通道以0填充
+  static inline vbool16_t mask(const size_t& remaining) {
+    return vmsltu_vx_u16m1_b16(vid_v_u16m1(pack_size), remaining, pack_size);
+  }
+  static inline type mask_load(const int16_t* p, const size_t& remaining) {
+    return vle16_v_i16m1_m(mask(remaining), set1(0), p, pack_size);
+  }
+  static inline void mask_store(int16_t* p, const size_t& remaining, type v) {
+    vse16_v_i16m1_m(mask(remaining), p, v, pack_size);
+  }
+  // RVV访存只要求元素对齐 非对齐版本直接复用
+  static inline type loadu(const int16_t* p) { return load(p); }
+  static inline void storeu(int16_t* p, type v) { store(p, v); }
+  static inline type mask_loadu(const int16_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int16_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int16_t val) { return vmv_v_x_i16m1(val, pack_size); }
+
+  static inline type min(type a, type b) { return vmin_vv_i16m1(a, b, pack_size); }
+  static inline type max(type a, type b) { return vmax_vv_i16m1(a, b, pack_size); }
+  static inline type abs(type a) { return select(vmslt_vx_i16m1_b16(a, 0, pack_size), neg(a), a); }
+  static inline type neg(type a) { return vneg_v_i16m1(a, pack_size); }
+
+  static inline type bit_and(type a, type b) { return vand_vv_i16m1(a, b, pack_size); }
+  static inline type bit_or(type a, type b) { return vor_vv_i16m1(a, b, pack_size); }
+  static inline type bit_xor(type a, type b) { return vxor_vv_i16m1(a, b, pack_size); }
+  static inline type bit_not(type a) { return vnot_v_i16m1(a, pack_size); }
+  static inline type shl(type a, int n) { return vsll_vx_i16m1(a, n, pack_size); }
+  static inline type shr(type a, int n) { return vsra_vx_i16m1(a, n, pack_size); }
+
+  using mask_type = vbool16_t;
+  static inline mask_type cmp_lt(type a, type b) { return vmslt_vv_i16m1_b16(a, b, pack_size); }
+  static inline mask_type cmp_le(type a, type b) { return vmsle_vv_i16m1_b16(a, b, pack_size); }
+  static inline mask_type cmp_eq(type a, type b) { return vmseq_vv_i16m1_b16(a, b, pack_size); }
+  static inline mask_type cmp_ne(type a, type b) { return vmsne_vv_i16m1_b16(a, b, pack_size); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vmand_mm_b16(a, b, pack_size); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vmor_mm_b16(a, b, pack_size); }
+  static inline mask_type mask_not(mask_type a) { return vmnot_m_b16(a, pack_size); }
+  static inline type select(mask_type m, type a, type b) { return vmerge_vvm_i16m1(m, b, a, pack_size); }
 };
+
+template <>
+struct simd<uint8_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 16;  // 假设VLEN=128位
+  using type = vuint8m1_t;
+
+  static inline type load(const uint8_t* p) { return vle8_v_u8m1(p, pack_size); }
+  static inline void store(uint8_t* p, type v) { vse8_v_u8m1(p, v, pack_size); }
+  static inline void stream(uint8_t* p, type v) { store(p, v); }
+  static inline type add(type a, type b) { return vadd_vv_u8m1(a, b, pack_size); }
+  static inline type sub(type a, type b) { return vsub_vv_u8m1(a, b, pack_size); }
+  static inline type mul(type a, type b) { return vmul_vv_u8m1(a, b, pack_size); }
+  static inline type div(type a, type b) { return vdivu_vv_u8m1(a, b, pack_size); }
+  static inline type fmadd(type a, type b, type c) { return vmacc_vv_u8m1(c, a, b, pack_size); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return vnmsac_vv_u8m1(c, a, b, pack_size); }
+
+  // 通道序号 < remaining 无效通道以0填充
+  static inline vbool8_t mask(const size_t& remaining) {
+    return vmsltu_vx_u8m1_b8(vid_v_u8m1(pack_size), remaining, pack_size);
+  }
+  static inline type mask_load(const uint8_t* p, const size_t& remaining) {
+    return vle8_v_u8m1_m(mask(remaining), set1(0), p, pack_size);
+  }
+  static inline void mask_store(uint8_t* p, const size_t& remaining, type v) {
+    vse8_v_u8m1_m(mask(remaining), p, v, pack_size);
+  }
+  // RVV访存只要求元素对齐 非对齐版本直接复用
+  static inline type loadu(const uint8_t* p) { return load(p); }
+  static inline void storeu(uint8_t* p, type v) { store(p, v); }
+  static inline type mask_loadu(const uint8_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(uint8_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(uint8_t val) { return vmv_v_x_u8m1(val, pack_size); }
+
+  static inline type min(type a, type b) { return vminu_vv_u8m1(a, b, pack_size); }
+  static inline type max(type a, type b) { return vmaxu_vv_u8m1(a, b, pack_size); }
+  // 取负按256取模
+  static inline type abs(type a) { return a; }
+  static inline type neg(type a) { return vrsub_vx_u8m1(a, 0, pack_size); }
+
+  static inline type bit_and(type a, type b) { return vand_vv_u8m1(a, b, pack_size); }
+  static inline type bit_or(type a, type b) { return vor_vv_u8m1(a, b, pack_size); }
+  static inline type bit_xor(type a, type b) { return vxor_vv_u8m1(a, b, pack_size); }
+  static inline type bit_not(type a) { return vnot_v_u8m1(a, pack_size); }
+  static inline type shl(type a, int n) { return vsll_vx_u8m1(a, n, pack_size); }
+  static inline type shr(type a, int n) { return vsrl_vx_u8m1(a, n, pack_size); }
+
+  using mask_type = vbool8_t;
+  static inline mask_type cmp_lt(type a, type b) { return vmsltu_vv_u8m1_b8(a, b, pack_size); }
+  static inline mask_type cmp_le(type a, type b) { return vmsleu_vv_u8m1_b8(a, b, pack_size); }
+  static inline mask_type cmp_eq(type a, type b) { return vmseq_vv_u8m1_b8(a, b, pack_size); }
+  static inline mask_type cmp_ne(type a, type b) { return vmsne_vv_u8m1_b8(a, b, pack_size); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return vmand_mm_b8(a, b, pack_size); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return vmor_mm_b8(a, b, pack_size); }
+  static inline mask_type mask_not(mask_type a) { return vmnot_m_b8(a, pack_size); }
+  static inline type select(mask_type m, type a, type b) { return vmerge_vvm_u8m1(m, b, a, pack_size); }
+};
+
+
+// ======================== 16位浮点存储 ========================
+// 存储为16位 寄存器内扩展为simd<float>计算 逐元素转换
+template <class S>
+struct rvv_storage16 {
+  static constexpr size_t pack_size = simd<float>::pack_size;
+  using type = simd<float>::type;
+
+  static inline type loadu(const S* p) { return md::detail::widen_lanes<simd<float>>(p); }
+  static inline void storeu(S* p, type v) { md::detail::narrow_lanes<simd<float>>(p, v); }
+  static inline type load(const S* p) { return loadu(p); }
+  static inline void store(S* p, type v) { storeu(p, v); }
+  static inline type mask_load(const S* p, const size_t& remaining) { return mask_loadu(p, remaining); }
+  static inline void mask_store(S* p, const size_t& remaining, type v) { mask_storeu(p, remaining, v); }
+  static inline type mask_loadu(const S* p, const size_t& remaining) {
+    return md::detail::storage_partial_load<rvv_storage16>(p, remaining);
+  }
+  static inline void mask_storeu(S* p, const size_t& remaining, type v) {
+    md::detail::storage_partial_store<rvv_storage16>(p, remaining, v);
+  }
+};
+
+template <>
+struct simd_storage<md::half> : rvv_storage16<md::half> {};
+
+template <>
+struct simd_storage<md::bfloat16> : rvv_storage16<md::bfloat16> {};
 #endif  // __RISC_V_H__
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef __MDVECTOR_SIMD_H__
 #define __MDVECTOR_SIMD_H__
 
+#include <utility>
+
 #if defined(USE_AVX2)
 #include "x86_avx2.h"
 
@@ -21,50 +23,116 @@
 
 #endif
 
+// 访存实现 16位浮点存储类型经simd_storage扩展为float/收窄写回
+// load/mask_load可指定计算类型C 与元素计算类型不同时经simd_convert转换(如float数组参与double计算)
+template <class T>
+using simd_access = std::conditional_t<is_storage_type_v<T>, simd_storage<T>, simd<T>>;
+
 // 对齐
 struct AlignedPolicy {
-  template <class T>
+  template <class T, class C = compute_type_t<T>>
   static inline auto load(const T* ptr) {
-    return simd<T>::load(ptr);
+    if constexpr (std::is_same_v<C, compute_type_t<T>>) {
+      return simd_access<T>::load(ptr);
+    } else {
+      return simd_convert<T, C>::loadu(ptr);
+    }
   }
 
-  template <class T>
+  template <class T, class C = compute_type_t<T>>
   static inline auto mask_load(const T* ptr, const size_t& remaining) {
-    return simd<T>::mask_load(ptr, remaining);
+    if constexpr (std::is_same_v<C, compute_type_t<T>>) {
+      return simd_access<T>::mask_load(ptr, remaining);
+    } else {
+      return simd_convert<T, C>::mask_loadu(ptr, remaining);
+    }
   }
 
   template <class T>
-  static inline void store(T* ptr, typename simd<T>::type val) {
-    simd<T>::store(ptr, val);
+  static inline void store(T* ptr, typename simd<compute_type_t<T>>::type val) {
+    simd_access<T>::store(ptr, val);
   }
 
   template <class T>
-  static inline void mask_store(T* ptr, const size_t& remaining, typename simd<T>::type val) {
-    simd<T>::mask_store(ptr, remaining, val);
+  static inline void mask_store(T* ptr, const size_t& remaining, typename simd<compute_type_t<T>>::type val) {
+    simd_access<T>::mask_store(ptr, remaining, val);
   }
+
+  static inline void fence() {}
 };
 
 // 非对齐
 struct UnalignedPolicy {
-  template <class T>
+  template <class T, class C = compute_type_t<T>>
   static inline auto load(const T* ptr) {
-    return simd<T>::loadu(ptr);
+    if constexpr (std::is_same_v<C, compute_type_t<T>>) {
+      return simd_access<T>::loadu(ptr);
+    } else {
+      return simd_convert<T, C>::loadu(ptr);
+    }
   }
 
-  template <class T>
+  template <class T, class C = compute_type_t<T>>
   static inline auto mask_load(const T* ptr, const size_t& remaining) {
-    return simd<T>::mask_loadu(ptr, remaining);
+    if constexpr (std::is_same_v<C, compute_type_t<T>>) {
+      return simd_access<T>::mask_loadu(ptr, remaining);
+    } else {
+      return simd_convert<T, C>::mask_loadu(ptr, remaining);
+    }
   }
 
   template <class T>
-  static inline void store(T* ptr, typename simd<T>::type val) {
-    simd<T>::storeu(ptr, val);
+  static inline void store(T* ptr, typename simd<compute_type_t<T>>::type val) {
+    simd_access<T>::storeu(ptr, val);
   }
 
   template <class T>
-  static inline void mask_store(T* ptr, const size_t& remaining, typename simd<T>::type val) {
-    simd<T>::mask_storeu(ptr, remaining, val);
+  static inline void mask_store(T* ptr, const size_t& remaining, typename simd<compute_type_t<T>>::type val) {
+    simd_access<T>::mask_storeu(ptr, remaining, val);
   }
+
+  static inline void fence() {}
 };
 
+// 对齐 非临时存储(流式写回) 写入绕过缓存 省去写分配时读入目标缓存行的内存流量 也不挤占缓存中的操作数
+// 仅用于只写且远大于末级缓存的目标 写完后须调用fence() 尾部掩码存储与16位浮点存储类型为普通存储
+struct StreamPolicy : AlignedPolicy {
+  template <class T>
+  static inline void store(T* ptr, typename simd<compute_type_t<T>>::type val) {
+    if constexpr (is_storage_type_v<T>) {
+      simd_access<T>::store(ptr, val);
+    } else {
+      simd<T>::stream(ptr, val);
+    }
+  }
+
+  static inline void fence() { md::detail::stream_fence(); }
+};
+
+// 目标字节数不小于该值且不与操作数重叠时 mdvector的表达式构造与赋值使用StreamPolicy写回
+// 默认32MB 应大于末级缓存 可在包含头文件前定义MD_STREAM_THRESHOLD覆盖 定义为SIZE_MAX时关闭
+#ifndef MD_STREAM_THRESHOLD
+#define MD_STREAM_THRESHOLD (size_t(32) << 20)
+#endif
+
+namespace md {
+
+inline constexpr size_t stream_threshold = MD_STREAM_THRESHOLD;
+
+namespace detail {
+
+template <class F, size_t... K>
+inline void unroll_impl(F& f, std::index_sequence<K...>) {
+  (f(K), ...);
+}
+
+// 依次调用f(0), f(1), ..., f(N - 1) 编译期展开 用于按unroll_factor展开的主循环
+template <size_t N, class F>
+inline void unroll(F&& f) {
+  unroll_impl(f, std::make_index_sequence<N>{});
+}
+
+}  // namespace detail
+}  // namespace md
+
 #endif  // __SIMD_H__
\ No newline at end of file
@@ -1,8 +1,150 @@
 #ifndef __MDVECTOR_SIMD_BASE_H__
 #define __MDVECTOR_SIMD_BASE_H__
 
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "half.h"
+
 // ======================== SIMD配置 ========================
 template <typename T>
 struct simd;
 
-#endif  // __SIMD_BASE_H__
\ No newline at end of file
+// 16位浮点存储类型(md::half/md::bfloat16)与simd<float>之间的扩展/收窄访存
+template <typename S>
+struct simd_storage;
+
+// 当前指令集是否提供simd<T>特化 (浮点与int32/int64/int16/uint8) 16位浮点存储类型取决于simd<float>
+// 需在指令集头文件之后实例化
+template <class T, class = void>
+struct has_simd : std::false_type {};
+
+template <class T>
+struct has_simd<T, std::void_t<decltype(simd<compute_type_t<T>>::pack_size)>> : std::true_type {};
+
+template <class T>
+inline constexpr bool has_simd_v = has_simd<T>::value;
+
+namespace md {
+namespace detail {
+
+// 经栈缓冲的部分加载/存储 用于缺少对应掩码指令的类型
+template <class T, class V>
+inline V partial_load(const T* p, size_t remaining) {
+  T buf[sizeof(V) / sizeof(T)] = {};
+  for (size_t i = 0; i < remaining; ++i) buf[i] = p[i];
+  V v;
+  std::memcpy(&v, buf, sizeof(V));
+  return v;
+}
+
+template <class T, class V>
+inline void partial_store(T* p, size_t remaining, V v) {
+  T buf[sizeof(V) / sizeof(T)];
+  std::memcpy(buf, &v, sizeof(V));
+  for (size_t i = 0; i < remaining; ++i) p[i] = buf[i];
+}
+
+// 逐通道标量回退 用于指令集缺失的运算(如整数除法)
+template <class T, class V, class F>
+inline V lanewise(V a, V b, F f) {
+  constexpr size_t n = sizeof(V) / sizeof(T);
+  T x[n], y[n];
+  std::memcpy(x, &a, sizeof(V));
+  std::memcpy(y, &b, sizeof(V));
+  for (size_t i = 0; i < n; ++i) x[i] = static_cast<T>(f(x[i], y[i]));
+  std::memcpy(&a, x, sizeof(V));
+  return a;
+}
+
+// 逐元素转换的16位浮点访存 用于无对应转换指令的指令集
+template <class F, class S>
+inline typename F::type widen_lanes(const S* p) {
+  alignas(F::alignment) float buf[F::pack_size];
+  for (size_t i = 0; i < F::pack_size; ++i) buf[i] = static_cast<float>(p[i]);
+  return F::load(buf);
+}
+
+template <class F, class S>
+inline void narrow_lanes(S* p, typename F::type v) {
+  alignas(F::alignment) float buf[F::pack_size];
+  F::store(buf, v);
+  for (size_t i = 0; i < F::pack_size; ++i) p[i] = S(buf[i]);
+}
+
+// 16位浮点存储的尾部访存 经栈缓冲转换
+template <class Storage, class S>
+inline typename Storage::type storage_partial_load(const S* p, size_t remaining) {
+  S buf[Storage::pack_size] = {};
+  for (size_t i = 0; i < remaining; ++i) buf[i] = p[i];
+  return Storage::loadu(buf);
+}
+
+template <class Storage, class S>
+inline void storage_partial_store(S* p, size_t remaining, typename Storage::type v) {
+  S buf[Storage::pack_size];
+  Storage::storeu(buf, v);
+  for (size_t i = 0; i < remaining; ++i) p[i] = buf[i];
+}
+
+// 逐元素类型转换 经栈缓冲 simd_convert的默认实现
+template <class From, class To>
+struct convert_lanes {
+  // 加载simd<To>::pack_size个From元素并转换 尾部以0填充
+  static inline typename simd<To>::type mask_loadu(const From* p, const size_t& remaining) {
+    alignas(simd<To>::alignment) To buf[simd<To>::pack_size] = {};
+    for (size_t i = 0; i < remaining; ++i) buf[i] = static_cast<To>(p[i]);
+    return simd<To>::load(buf);
+  }
+  static inline typename simd<To>::type loadu(const From* p) { return mask_loadu(p, simd<To>::pack_size); }
+
+  // 同宽度逐通道转换 如float <-> int32_t
+  static inline typename simd<To>::type apply(typename simd<From>::type v) {
+    alignas(simd<From>::alignment) From buf[simd<From>::pack_size];
+    simd<From>::store(buf, v);
+    return loadu(buf);
+  }
+
+  // 两个simd<From>收窄为一个simd<To> 如double -> float
+  static inline typename simd<To>::type narrow(typename simd<From>::type lo, typename simd<From>::type hi) {
+    constexpr size_t n = simd<From>::pack_size;
+    alignas(simd<From>::alignment) From buf[2 * n];
+    simd<From>::store(buf, lo);
+    simd<From>::store(buf + n, hi);
+    return loadu(buf);
+  }
+};
+
+// 收窄加载的尾部 分两段按From掩码加载后收窄
+template <class Convert, class From>
+inline auto narrow_mask_loadu(const From* p, size_t remaining) {
+  constexpr size_t n = simd<From>::pack_size;
+  const auto lo = remaining >= n ? simd<From>::loadu(p) : simd<From>::mask_loadu(p, remaining);
+  const auto hi = remaining > n ? simd<From>::mask_loadu(p + n, remaining - n) : simd<From>::set1(From(0));
+  return Convert::narrow(lo, hi);
+}
+
+// 浮点标量除数可替换为乘以倒数: 倒数为正规数 或除数为0/inf/NaN(乘以inf/0/NaN与除法结果一致)
+// 倒数为非正规数或上溢时(|d| > 2^126 或d为非正规数 float)退回除法
+template <class T>
+inline bool use_reciprocal(T d) {
+  return std::isnormal(T(1) / d) || d == T(0) || !std::isfinite(d);
+}
+
+// 整数除法 逐通道回退
+// 尾部无效通道以0填充 除数为0的通道结果记为0 避免触发除零异常
+template <class T, class V>
+inline V int_div(V a, V b) {
+  return lanewise<T>(a, b, [](T x, T y) { return y == 0 ? T(0) : static_cast<T>(x / y); });
+}
+
+}  // namespace detail
+}  // namespace md
+
+// 元素类型转换 默认逐元素转换 各指令集对float <-> double、int32_t <-> float特化
+template <typename From, typename To>
+struct simd_convert : md::detail::convert_lanes<From, To> {};
+
+#endif  // __SIMD_BASE_H__
@@ -3,272 +3,136 @@
 
 #include "simd.h"
 
-// ======================== 向量与向量操作 ========================
-template <class T, class Policy>
-void simd_add(const T* __restrict a, const T* __restrict b, T* __restrict c, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
+namespace md {
+namespace detail {
+
+// 逐pack写回c[i] f以加载函数为参数返回该pack的结果 整pack与尾部掩码共用同一个f
+// 主循环每次处理unroll_factor个相互独立的pack 其余整pack逐个处理 最后不足一个pack时使用掩码
+template <class T, class Policy, class F>
+inline void simd_map(T* c, const size_t n, F f) {
+  constexpr size_t pack_size = simd<compute_type_t<T>>::pack_size;
+  constexpr size_t step = unroll_factor * pack_size;
 
   size_t i = 0;
+  for (; i + step <= n; i += step) {
+    unroll<unroll_factor>([&](size_t k) {
+      const size_t j = i + k * pack_size;
+      Policy::template store<T>(c + j, f([j](const T* p) { return Policy::template load<T>(p + j); }));
+    });
+  }
+
   for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    const typename simd<T>::type vb = Policy::template load<T>(b + i);
-    Policy::template store<T>(c + i, simd<T>::add(va, vb));
+    Policy::template store<T>(c + i, f([i](const T* p) { return Policy::template load<T>(p + i); }));
   }
 
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  const typename simd<T>::type vb = Policy::template mask_load<T>(b + i, remaining);
-  Policy::template mask_store<T>(c + i, remaining, simd<T>::add(va, vb));
+  if (i < n) {
+    const size_t remaining = n - i;
+    Policy::template mask_store<T>(
+        c + i, remaining, f([i, remaining](const T* p) { return Policy::template mask_load<T>(p + i, remaining); }));
+  }
 }
 
-template <class T, class Policy>
-void simd_sub(const T* __restrict a, const T* __restrict b, T* __restrict c, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
+}  // namespace detail
+}  // namespace md
 
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    const typename simd<T>::type vb = Policy::template load<T>(b + i);
-    Policy::template store<T>(c + i, simd<T>::sub(va, vb));
-  }
+// ======================== 向量与向量操作 ========================
+template <class T, class Policy>
+void simd_add(const T* __restrict a, const T* __restrict b, T* __restrict c, const size_t n) {
+  md::detail::simd_map<T, Policy>(c, n, [&](auto load) { return simd<compute_type_t<T>>::add(load(a), load(b)); });
+}
 
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  const typename simd<T>::type vb = Policy::template mask_load<T>(b + i, remaining);
-  Policy::template mask_store<T>(c + i, remaining, simd<T>::sub(va, vb));
+template <class T, class Policy>
+void simd_sub(const T* __restrict a, const T* __restrict b, T* __restrict c, const size_t n) {
+  md::detail::simd_map<T, Policy>(c, n, [&](auto load) { return simd<compute_type_t<T>>::sub(load(a), load(b)); });
 }
 
 template <class T, class Policy>
 void simd_mul(const T* __restrict a, const T* __restrict b, T* __restrict c, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    const typename simd<T>::type vb = Policy::template load<T>(b + i);
-    Policy::template store<T>(c + i, simd<T>::mul(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  const typename simd<T>::type vb = Policy::template mask_load<T>(b + i, remaining);
-  Policy::template mask_store<T>(c + i, remaining, simd<T>::mul(va, vb));
+  md::detail::simd_map<T, Policy>(c, n, [&](auto load) { return simd<compute_type_t<T>>::mul(load(a), load(b)); });
 }
 
 template <class T, class Policy>
 void simd_div(const T* __restrict a, const T* __restrict b, T* __restrict c, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    const typename simd<T>::type vb = Policy::template load<T>(b + i);
-    Policy::template store<T>(c + i, simd<T>::div(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  const typename simd<T>::type vb = Policy::template mask_load<T>(b + i, remaining);
-  Policy::template mask_store<T>(c + i, remaining, simd<T>::div(va, vb));
+  md::detail::simd_map<T, Policy>(c, n, [&](auto load) { return simd<compute_type_t<T>>::div(load(a), load(b)); });
 }
 
 // ======================== 向量与向量就地操作 ========================
 template <class T, class Policy>
 void simd_add_inplace(T* __restrict a, const T* __restrict b, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    const typename simd<T>::type vb = Policy::template load<T>(b + i);
-    Policy::template store<T>(a + i, simd<T>::add(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  const typename simd<T>::type vb = Policy::template mask_load<T>(b + i, remaining);
-  Policy::template mask_store<T>(a + i, remaining, simd<T>::add(va, vb));
+  md::detail::simd_map<T, Policy>(a, n, [&](auto load) { return simd<compute_type_t<T>>::add(load(a), load(b)); });
 }
 
 template <class T, class Policy>
 void simd_sub_inplace(T* __restrict a, const T* __restrict b, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    const typename simd<T>::type vb = Policy::template load<T>(b + i);
-    Policy::template store<T>(a + i, simd<T>::sub(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  const typename simd<T>::type vb = Policy::template mask_load<T>(b + i, remaining);
-  Policy::template mask_store<T>(a + i, remaining, simd<T>::sub(va, vb));
+  md::detail::simd_map<T, Policy>(a, n, [&](auto load) { return simd<compute_type_t<T>>::sub(load(a), load(b)); });
 }
 
 template <class T, class Policy>
 void simd_mul_inplace(T* __restrict a, const T* __restrict b, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    const typename simd<T>::type vb = Policy::template load<T>(b + i);
-    Policy::template store<T>(a + i, simd<T>::mul(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  const typename simd<T>::type vb = Policy::template mask_load<T>(b + i, remaining);
-  Policy::template mask_store<T>(a + i, remaining, simd<T>::mul(va, vb));
+  md::detail::simd_map<T, Policy>(a, n, [&](auto load) { return simd<compute_type_t<T>>::mul(load(a), load(b)); });
 }
 
 template <class T, class Policy>
 void simd_div_inplace(T* __restrict a, const T* __restrict b, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    const typename simd<T>::type vb = Policy::template load<T>(b + i);
-    Policy::template store<T>(a + i, simd<T>::div(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  const typename simd<T>::type vb = Policy::template mask_load<T>(b + i, remaining);
-  Policy::template mask_store<T>(a + i, remaining, simd<T>::div(va, vb));
+  md::detail::simd_map<T, Policy>(a, n, [&](auto load) { return simd<compute_type_t<T>>::div(load(a), load(b)); });
 }
 
 // ======================== 向量与标量操作 ========================
 template <class T, class Policy>
 void simd_add_scalar(const T* __restrict a, T b, T* __restrict c, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-  const typename simd<T>::type vb = simd<T>::set1(b);
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    Policy::template store<T>(c + i, simd<T>::add(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  Policy::template mask_store<T>(c + i, remaining, simd<T>::add(va, vb));
+  const typename simd<compute_type_t<T>>::type vb = simd<compute_type_t<T>>::set1(b);
+  md::detail::simd_map<T, Policy>(c, n, [&](auto load) { return simd<compute_type_t<T>>::add(load(a), vb); });
 }
 
 template <class T, class Policy>
 void simd_sub_scalar(const T* __restrict a, T b, T* __restrict c, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-  const typename simd<T>::type vb = simd<T>::set1(b);
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    Policy::template store<T>(c + i, simd<T>::sub(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  Policy::template mask_store<T>(c + i, remaining, simd<T>::sub(va, vb));
+  const typename simd<compute_type_t<T>>::type vb = simd<compute_type_t<T>>::set1(b);
+  md::detail::simd_map<T, Policy>(c, n, [&](auto load) { return simd<compute_type_t<T>>::sub(load(a), vb); });
 }
 
 template <class T, class Policy>
 void simd_mul_scalar(const T* __restrict a, T b, T* __restrict c, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-  const typename simd<T>::type vb = simd<T>::set1(b);
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    Policy::template store<T>(c + i, simd<T>::mul(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  Policy::template mask_store<T>(c + i, remaining, simd<T>::mul(va, vb));
+  const typename simd<compute_type_t<T>>::type vb = simd<compute_type_t<T>>::set1(b);
+  md::detail::simd_map<T, Policy>(c, n, [&](auto load) { return simd<compute_type_t<T>>::mul(load(a), vb); });
 }
 
 template <class T, class Policy>
 void simd_div_scalar(const T* __restrict a, T b, T* __restrict c, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-  const typename simd<T>::type vb = simd<T>::set1(b);
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    Policy::template store<T>(c + i, simd<T>::div(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  Policy::template mask_store<T>(c + i, remaining, simd<T>::div(va, vb));
+  const typename simd<compute_type_t<T>>::type vb = simd<compute_type_t<T>>::set1(b);
+  md::detail::simd_map<T, Policy>(c, n, [&](auto load) { return simd<compute_type_t<T>>::div(load(a), vb); });
 }
 
 // ======================== 向量与标量就地操作 ========================
 template <class T, class Policy>
 void simd_add_inplace_scalar(T* __restrict a, T b, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-  const typename simd<T>::type vb = simd<T>::set1(b);
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    Policy::template store<T>(a + i, simd<T>::add(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  Policy::template mask_store<T>(a + i, remaining, simd<T>::add(va, vb));
+  const typename simd<compute_type_t<T>>::type vb = simd<compute_type_t<T>>::set1(b);
+  md::detail::simd_map<T, Policy>(a, n, [&](auto load) { return simd<compute_type_t<T>>::add(load(a), vb); });
 }
 
 template <class T, class Policy>
 void simd_sub_inplace_scalar(T* __restrict a, T b, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-  const typename simd<T>::type vb = simd<T>::set1(b);
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    Policy::template store<T>(a + i, simd<T>::sub(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  Policy::template mask_store<T>(a + i, remaining, simd<T>::sub(va, vb));
+  const typename simd<compute_type_t<T>>::type vb = simd<compute_type_t<T>>::set1(b);
+  md::detail::simd_map<T, Policy>(a, n, [&](auto load) { return simd<compute_type_t<T>>::sub(load(a), vb); });
 }
 
 template <class T, class Policy>
 void simd_mul_inplace_scalar(T* __restrict a, T b, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-  const typename simd<T>::type vb = simd<T>::set1(b);
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    Policy::template store<T>(a + i, simd<T>::mul(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  Policy::template mask_store<T>(a + i, remaining, simd<T>::mul(va, vb));
+  const typename simd<compute_type_t<T>>::type vb = simd<compute_type_t<T>>::set1(b);
+  md::detail::simd_map<T, Policy>(a, n, [&](auto load) { return simd<compute_type_t<T>>::mul(load(a), vb); });
 }
 
+// float/double除数优先乘以倒数 结果与除法至多相差1 ULP 除数为2的幂时完全一致
 template <class T, class Policy>
 void simd_div_inplace_scalar(T* __restrict a, T b, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-  const typename simd<T>::type vb = simd<T>::set1(b);
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type va = Policy::template load<T>(a + i);
-    Policy::template store<T>(a + i, simd<T>::div(va, vb));
+  if constexpr (std::is_floating_point_v<T>) {
+    if (md::detail::use_reciprocal(b)) {
+      simd_mul_inplace_scalar<T, Policy>(a, T(1) / b, n);
+      return;
+    }
   }
 
-  const size_t remaining = n - i;
-  const typename simd<T>::type va = Policy::template mask_load<T>(a + i, remaining);
-  Policy::template mask_store<T>(a + i, remaining, simd<T>::div(va, vb));
+  const typename simd<compute_type_t<T>>::type vb = simd<compute_type_t<T>>::set1(b);
+  md::detail::simd_map<T, Policy>(a, n, [&](auto load) { return simd<compute_type_t<T>>::div(load(a), vb); });
 }
 
 // ======================== 标量与向量操作 ========================
@@ -279,18 +143,8 @@ void simd_scalar_add(T a, const T* __restrict b, T* __restrict c, const size_t n
 
 template <class T, class Policy>
 void simd_scalar_sub(T a, const T* __restrict b, T* __restrict c, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-  const typename simd<T>::type va = simd<T>::set1(a);
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type vb = Policy::template load<T>(b + i);
-    Policy::template store<T>(c + i, simd<T>::sub(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type vb = Policy::template mask_load<T>(b + i, remaining);
-  Policy::template mask_store<T>(c + i, remaining, simd<T>::sub(va, vb));
+  const typename simd<compute_type_t<T>>::type va = simd<compute_type_t<T>>::set1(a);
+  md::detail::simd_map<T, Policy>(c, n, [&](auto load) { return simd<compute_type_t<T>>::sub(va, load(b)); });
 }
 
 template <class T, class Policy>
@@ -300,18 +154,8 @@ void simd_scalar_mul(T a, const T* __restrict b, T* __restrict c, const size_t n
 
 template <class T, class Policy>
 void simd_scalar_div(T a, const T* __restrict b, T* __restrict c, const size_t n) {
-  constexpr size_t pack_size = simd<T>::pack_size;
-  const typename simd<T>::type va = simd<T>::set1(a);
-
-  size_t i = 0;
-  for (; i + pack_size <= n; i += pack_size) {
-    const typename simd<T>::type vb = Policy::template load<T>(b + i);
-    Policy::template store<T>(c + i, simd<T>::div(va, vb));
-  }
-
-  const size_t remaining = n - i;
-  const typename simd<T>::type vb = Policy::template mask_load<T>(b + i, remaining);
-  Policy::template mask_store<T>(c + i, remaining, simd<T>::div(va, vb));
+  const typename simd<compute_type_t<T>>::type va = simd<compute_type_t<T>>::set1(a);
+  md::detail::simd_map<T, Policy>(c, n, [&](auto load) { return simd<compute_type_t<T>>::div(va, load(b)); });
 }
 
-#endif  // __SIMD_FUNCTION_H__
\ No newline at end of file
+#endif  // __SIMD_FUNCTION_H__
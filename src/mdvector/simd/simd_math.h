@@ -0,0 +1,629 @@
+#ifndef __MDVECTOR_SIMD_MATH_H__
+#define __MDVECTOR_SIMD_MATH_H__
+
+#include <limits>
+#include <type_traits>
+
+#include "simd.h"
+
+// ======================== SIMD超越函数 ========================
+// 基于simd<T>基础操作实现 各指令集后端共用同一套算法
+// 误差上界为相对std::函数(long double参考值)的实测最大ULP 见 test/correct/test_function.cc
+
+// Horner多项式 coef按最高次项在前排列
+template <class T, size_t N>
+inline typename simd<T>::type simd_poly(typename simd<T>::type x, const T (&coef)[N]) {
+  typename simd<T>::type r = simd<T>::set1(coef[0]);
+  for (size_t k = 1; k < N; ++k) {
+    r = simd<T>::fmadd(r, x, simd<T>::set1(coef[k]));
+  }
+  return r;
+}
+
+// ======================== 多项式求值 ========================
+// polyval的求值方案 作为模板参数选择
+// horner: n次多项式n条fmadd串行 指令最少 连续pack间的乱序执行已能隐藏fmadd延迟
+// estrin: 按x, x^2, x^4...两两合并 依赖链缩短为log2(n)级 多约log2(n)次乘法
+//         适合表达式中其余部分无法填满流水线的场景
+namespace md {
+
+enum class poly_scheme { horner, estrin };
+
+inline constexpr poly_scheme horner = poly_scheme::horner;
+inline constexpr poly_scheme estrin = poly_scheme::estrin;
+
+}  // namespace md
+
+// Horner 运行期项数 coef按最高次项在前排列 系数转换为T后参与计算
+template <class T, class K>
+inline typename simd<T>::type simd_horner(typename simd<T>::type x, const K* coef, size_t n) {
+  using S = simd<T>;
+  if (n == 0) {
+    return S::set1(T(0));
+  }
+  typename S::type r = S::set1(static_cast<T>(coef[0]));
+  for (size_t k = 1; k < n; ++k) {
+    r = S::fmadd(r, x, S::set1(static_cast<T>(coef[k])));
+  }
+  return r;
+}
+
+// Estrin 编译期项数 coef按最高次项在前排列
+// 例(7项): (a0 + a1x) + (a2 + a3x)x^2 + ((a4 + a5x) + a6x^2)x^4
+template <class T, size_t N, class K>
+inline typename simd<T>::type simd_estrin(typename simd<T>::type x, const K* coef) {
+  using S = simd<T>;
+  using V = typename S::type;
+  if constexpr (N <= 2) {
+    return simd_horner<T>(x, coef, N);
+  } else {
+    // a_k = coef[N - 1 - k] 为k次项系数
+    constexpr size_t M = (N + 1) / 2;
+    V b[M];
+    for (size_t i = 0; i < N / 2; ++i) {
+      b[i] = S::fmadd(S::set1(static_cast<T>(coef[N - 2 - 2 * i])), x, S::set1(static_cast<T>(coef[N - 1 - 2 * i])));
+    }
+    if constexpr (N % 2 == 1) {
+      b[M - 1] = S::set1(static_cast<T>(coef[0]));
+    }
+    V p = S::mul(x, x);
+    size_t m = M;
+    while (m > 1) {
+      for (size_t i = 0; i < m / 2; ++i) {
+        b[i] = S::fmadd(b[2 * i + 1], p, b[2 * i]);
+      }
+      if (m % 2 == 1) {
+        b[m / 2] = b[m - 1];
+      }
+      m = (m + 1) / 2;
+      if (m > 1) {
+        p = S::mul(p, p);
+      }
+    }
+    return b[0];
+  }
+}
+
+// ======================== exp ========================
+// x = n*ln2 + r, |r| <= ln2/2, e^x = 2^n * e^r
+// float: <= 1.5 ULP  double: <= 1.5 ULP
+// 上溢返回inf 下溢至非正规数范围逐步缩放 低于最小非正规数返回0
+template <class T>
+inline typename simd<T>::type simd_exp(typename simd<T>::type x) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr bool is_float = std::is_same_v<T, float>;
+
+  const V hi = S::set1(is_float ? T(88.7228391) : T(709.782712893384));
+  const V lo = S::set1(is_float ? T(-103.972077) : T(-745.1332191019412));
+  const V xc = S::min(S::max(x, lo), hi);
+
+  // n = round(x / ln2)  r = x - n*ln2 (两段ln2保证精度)
+  const V n = S::round(S::mul(xc, S::set1(T(1.44269504088896341))));
+  V r = S::fnmadd(n, S::set1(is_float ? T(0.693359375) : T(6.93145751953125E-1)), xc);
+  r = S::fnmadd(n, S::set1(is_float ? T(-2.12194440e-4) : T(1.42860682030941723212E-6)), r);
+
+  // e^r = 1 + r + r^2 * P(r)
+  V p;
+  if constexpr (is_float) {
+    static constexpr float coef[] = {1.9875691500E-4f, 1.3981999507E-3f, 8.3334519073E-3f,
+                                     4.1665795894E-2f, 1.6666665459E-1f, 5.0000001201E-1f};
+    p = simd_poly<T>(r, coef);
+  } else {
+    static constexpr double coef[] = {1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+                                      1.0 / 362880.0,     1.0 / 40320.0,     1.0 / 5040.0,      1.0 / 720.0,
+                                      1.0 / 120.0,        1.0 / 24.0,        1.0 / 6.0,         1.0 / 2.0};
+    p = simd_poly<T>(r, coef);
+  }
+  V y = S::fmadd(S::mul(r, r), p, S::add(r, S::set1(T(1))));
+
+  // 2^n 拆为两次缩放 覆盖上溢边界与非正规数结果
+  const V n1 = S::round(S::fmadd(n, S::set1(T(0.5)), S::set1(T(-0.25))));
+  y = S::mul(S::mul(y, S::pow2n(n1)), S::pow2n(S::sub(n, n1)));
+
+  y = S::select(S::cmp_lt(hi, x), S::set1(std::numeric_limits<T>::infinity()), y);
+  y = S::select(S::cmp_lt(x, lo), S::set1(T(0)), y);
+  return S::select(S::cmp_eq(x, x), y, x);  // NaN透传
+}
+
+// ======================== log ========================
+// x = 2^k * m, m in [sqrt(2)/2, sqrt(2)), log(m) = f - f^2/2 + s*(f^2/2 + R(s^2)), s = f/(2+f)
+// float: <= 1 ULP  double: <= 1 ULP
+// x < 0 返回NaN x == 0 返回-inf 支持非正规数输入
+template <class T>
+inline typename simd<T>::type simd_log(typename simd<T>::type x) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr bool is_float = std::is_same_v<T, float>;
+
+  const V one = S::set1(T(1));
+  const V half = S::set1(T(0.5));
+
+  // 非正规数先放大到正规数范围
+  const auto tiny = S::cmp_lt(x, S::set1(std::numeric_limits<T>::min()));
+  const V scale = S::set1(is_float ? T(16777216.0) : T(18014398509481984.0));  // 2^24 / 2^54
+  const V xs = S::select(tiny, S::mul(x, scale), x);
+  V k = S::select(tiny, S::set1(is_float ? T(-24) : T(-54)), S::set1(T(0)));
+
+  V m = S::get_mant(xs);
+  k = S::add(k, S::get_exp(xs));
+
+  const auto big = S::cmp_lt(S::set1(T(1.41421356237309504880)), m);
+  m = S::select(big, S::mul(m, half), m);
+  k = S::select(big, S::add(k, one), k);
+
+  const V f = S::sub(m, one);
+  const V s = S::div(f, S::add(f, S::set1(T(2))));
+  const V z = S::mul(s, s);
+  V R;
+  if constexpr (is_float) {
+    static constexpr float coef[] = {0.24279078841f, 0.28498786688f, 0.40000972152f, 0.66666662693f};
+    R = S::mul(z, simd_poly<T>(z, coef));
+  } else {
+    static constexpr double coef[] = {1.479819860511658591e-01, 1.531383769920937332e-01, 1.818357216161805012e-01,
+                                      2.222219843214978396e-01, 2.857142874366239149e-01, 3.999999999940941908e-01,
+                                      6.666666666666735130e-01};
+    R = S::mul(z, simd_poly<T>(z, coef));
+  }
+
+  const V ln2_hi = S::set1(is_float ? T(6.9313812256e-01) : T(6.93147180369123816490e-01));
+  const V ln2_lo = S::set1(is_float ? T(9.0580006145e-06) : T(1.90821492927058770002e-10));
+  const V hfsq = S::mul(half, S::mul(f, f));
+  // k*ln2_hi - ((hfsq - (s*(hfsq + R) + k*ln2_lo)) - f)
+  const V t = S::fmadd(k, ln2_lo, S::mul(s, S::add(hfsq, R)));
+  V y = S::fmadd(k, ln2_hi, S::sub(f, S::sub(hfsq, t)));
+
+  const V inf = S::set1(std::numeric_limits<T>::infinity());
+  y = S::select(S::cmp_eq(x, inf), inf, y);
+  y = S::select(S::cmp_eq(x, S::set1(T(0))), S::neg(inf), y);
+  y = S::select(S::cmp_lt(x, S::set1(T(0))), S::set1(std::numeric_limits<T>::quiet_NaN()), y);
+  return S::select(S::cmp_eq(x, x), y, x);  // NaN透传
+}
+
+// ======================== sin / cos / tan ========================
+// x = n*pi/2 + r, |r| <= pi/4 (三段pi/2 Cody-Waite约简) 按象限选择sin(r)/cos(r)
+// sin/cos float: <= 1.5 ULP (|x| <= 100)  double: <= 1.5 ULP (|x| <= 8192)
+// tan     float: <= 3.5 ULP (|x| <= 10)   double: <= 3 ULP (|x| <= 10)
+// float约简误差随|x|增长 |x| = 8192 时约8 ULP
+template <class T>
+struct simd_trig_reduce {
+  using S = simd<T>;
+  using V = typename S::type;
+
+  V n;      // 象限编号(整数值)
+  V sin_r;  // sin(r)
+  V cos_r;  // cos(r)
+
+  explicit simd_trig_reduce(V x) {
+    constexpr bool is_float = std::is_same_v<T, float>;
+    n = S::round(S::mul(x, S::set1(T(0.636619772367581343076))));
+    V r = S::fnmadd(n, S::set1(is_float ? T(1.5703125) : T(1.57079625129699707031e+00)), x);
+    r = S::fnmadd(n, S::set1(is_float ? T(4.837512969970703125e-4) : T(7.54978941586159635336e-08)), r);
+    r = S::fnmadd(n, S::set1(is_float ? T(7.54978995489188216e-8) : T(5.39030285815811905290e-15)), r);
+
+    const V z = S::mul(r, r);
+    if constexpr (is_float) {
+      static constexpr float sin_coef[] = {-1.9515295891E-4f, 8.3321608736E-3f, -1.6666654611E-1f};
+      static constexpr float cos_coef[] = {2.443315711809948E-005f, -1.388731625493765E-003f,
+                                           4.166664568298827E-002f};
+      sin_r = S::fmadd(S::mul(z, r), simd_poly<T>(z, sin_coef), r);
+      cos_r = S::fmadd(S::mul(z, z), simd_poly<T>(z, cos_coef), S::fnmadd(z, S::set1(T(0.5)), S::set1(T(1))));
+    } else {
+      static constexpr double sin_coef[] = {1.58962301576546568060E-10, -2.50507477628578072866E-8,
+                                            2.75573136213857245213E-6,  -1.98412698295895385996E-4,
+                                            8.33333333332211858878E-3,  -1.66666666666666307295E-1};
+      static constexpr double cos_coef[] = {-1.13585365213876817300E-11, 2.08757008419747316778E-9,
+                                            -2.75573141792967388112E-7,  2.48015872888517045348E-5,
+                                            -1.38888888888730564116E-3,  4.16666666666665929218E-2};
+      sin_r = S::fmadd(S::mul(z, r), simd_poly<T>(z, sin_coef), r);
+      cos_r = S::fmadd(S::mul(z, z), simd_poly<T>(z, cos_coef), S::fnmadd(z, S::set1(T(0.5)), S::set1(T(1))));
+    }
+  }
+
+  // 象限 q = n mod 4 中 q为奇数 / q >= 2 的掩码
+  static auto is_odd(V q) {
+    const V half_floor = S::round(S::fmadd(q, S::set1(T(0.5)), S::set1(T(-0.25))));
+    return S::cmp_eq(S::fnmadd(half_floor, S::set1(T(2)), q), S::set1(T(1)));
+  }
+  static auto is_upper(V q) {
+    const V quarter_floor = S::round(S::fmadd(q, S::set1(T(0.25)), S::set1(T(-0.375))));
+    return S::cmp_le(S::set1(T(2)), S::fnmadd(quarter_floor, S::set1(T(4)), q));
+  }
+};
+
+template <class T>
+inline typename simd<T>::type simd_sin(typename simd<T>::type x) {
+  using S = simd<T>;
+  const simd_trig_reduce<T> t(x);
+  const auto v = S::select(t.is_odd(t.n), t.cos_r, t.sin_r);
+  return S::select(t.is_upper(t.n), S::neg(v), v);
+}
+
+template <class T>
+inline typename simd<T>::type simd_cos(typename simd<T>::type x) {
+  using S = simd<T>;
+  const simd_trig_reduce<T> t(x);
+  // cos(x) = sin(x + pi/2) 象限加一
+  const auto q = S::add(t.n, S::set1(T(1)));
+  const auto v = S::select(t.is_odd(q), t.cos_r, t.sin_r);
+  return S::select(t.is_upper(q), S::neg(v), v);
+}
+
+template <class T>
+inline typename simd<T>::type simd_tan(typename simd<T>::type x) {
+  using S = simd<T>;
+  const simd_trig_reduce<T> t(x);
+  // 奇数象限 tan(x) = -cos(r)/sin(r)
+  const auto odd = t.is_odd(t.n);
+  return S::div(S::select(odd, S::neg(t.cos_r), t.sin_r), S::select(odd, t.sin_r, t.cos_r));
+}
+
+// ======================== atan2 ========================
+// 约简到 t = min(|x|,|y|)/max(|x|,|y|) 在[0,1] 再以pi/4为中心二次约简
+// float: <= 3 ULP  double: <= 2 ULP  结果范围[-pi, pi]
+template <class T>
+inline typename simd<T>::type simd_atan2(typename simd<T>::type y, typename simd<T>::type x) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr bool is_float = std::is_same_v<T, float>;
+
+  const V zero = S::set1(T(0));
+  const V one = S::set1(T(1));
+  const V ax = S::abs(x);
+  const V ay = S::abs(y);
+  const V mx = S::max(ax, ay);
+
+  V a = S::div(S::min(ax, ay), mx);
+  a = S::select(S::cmp_eq(ax, ay), one, a);  // inf/inf
+  a = S::select(S::cmp_eq(mx, zero), zero, a);
+
+  const auto big = S::cmp_lt(S::set1(is_float ? T(0.4142135623730950) : T(0.66)), a);
+  const V t = S::select(big, S::div(S::sub(a, one), S::add(a, one)), a);
+  const V z = S::mul(t, t);
+
+  V r;
+  if constexpr (is_float) {
+    static constexpr float coef[] = {8.05374449538e-2f, -1.38776856032E-1f, 1.99777106478E-1f, -3.33329491539E-1f};
+    r = S::fmadd(S::mul(z, t), simd_poly<T>(z, coef), t);
+  } else {
+    static constexpr double p_coef[] = {-8.750608600031904122785E-1, -1.615753718733365076637E1,
+                                        -7.500855792314704667340E1,  -1.228866684490136173410E2,
+                                        -6.485021904942025371773E1};
+    static constexpr double q_coef[] = {1.0,
+                                        2.485846490142306297962E1,
+                                        1.650270098316988542046E2,
+                                        4.328810604912902668951E2,
+                                        4.853903996359136964868E2,
+                                        1.945506571482613964425E2};
+    const V pq = S::div(simd_poly<T>(z, p_coef), simd_poly<T>(z, q_coef));
+    r = S::fmadd(S::mul(z, t), pq, t);
+  }
+
+  const T pio2_lo = is_float ? T(0) : T(6.123233995736765886130E-17);
+  r = S::add(r, S::select(big, S::set1(T(0.785398163397448309616)), zero));
+  r = S::add(r, S::select(big, S::set1(T(0.5) * pio2_lo), zero));
+  r = S::select(S::cmp_lt(ax, ay), S::add(S::sub(S::set1(T(1.57079632679489661923)), r), S::set1(pio2_lo)), r);
+  r = S::select(S::cmp_lt(x, zero),
+                S::add(S::sub(S::set1(T(3.14159265358979323846)), r), S::set1(T(2) * pio2_lo)), r);
+  r = S::select(S::cmp_lt(y, zero), S::neg(r), r);
+
+  r = S::select(S::cmp_eq(x, x), r, x);  // NaN透传
+  return S::select(S::cmp_eq(y, y), r, y);
+}
+
+// ======================== pow ========================
+// pow(x, y) = exp(y * log|x|)
+// 误差随|y*log(x)|放大 约为 (1 + 2*|y*ln(x)|) ULP
+// 特殊值与std::pow一致:
+//   y == 0 或 x == 1 返回1(含NaN)  x == -1 且 y == ±inf 返回1
+//   有限负底数x仅对整数y有定义 其余返回NaN
+//   奇整数y保留底数符号(含-0与-inf 如pow(-0, -1) = -inf) 非奇整数时-0与-inf按+0与+inf计算
+template <class T>
+inline typename simd<T>::type simd_pow(typename simd<T>::type x, typename simd<T>::type y) {
+  using S = simd<T>;
+  using V = typename S::type;
+
+  const V zero = S::set1(T(0));
+  const V one = S::set1(T(1));
+  const V inf = S::set1(std::numeric_limits<T>::infinity());
+
+  V r = simd_exp<T>(S::mul(y, simd_log<T>(S::abs(x))));
+
+  // 奇整数指数取底数符号 1/x < 0 覆盖-0
+  const V yi = S::round(y);
+  const auto y_int = S::cmp_eq(y, yi);
+  const V y_half_floor = S::round(S::fmadd(yi, S::set1(T(0.5)), S::set1(T(-0.25))));
+  const auto y_odd = S::mask_and(y_int, S::cmp_eq(S::fnmadd(y_half_floor, S::set1(T(2)), yi), one));
+  const auto x_sign = S::mask_or(S::cmp_lt(x, zero), S::cmp_lt(S::div(one, x), zero));
+  r = S::select(S::mask_and(x_sign, y_odd), S::neg(r), r);
+
+  // 有限负底数的非整数指数
+  const auto neg_finite = S::mask_and(S::cmp_lt(x, zero), S::cmp_lt(S::neg(inf), x));
+  r = S::select(S::mask_and(neg_finite, S::mask_not(y_int)), S::set1(std::numeric_limits<T>::quiet_NaN()), r);
+
+  const auto unit = S::mask_or(S::mask_or(S::cmp_eq(y, zero), S::cmp_eq(x, one)),
+                               S::mask_and(S::cmp_eq(x, S::neg(one)), S::cmp_eq(S::abs(y), inf)));
+  return S::select(unit, one, r);
+}
+
+// pow(x, 0.5) 与std::pow一致 -0为+0 -inf为+inf (sqrt分别为-0与NaN)
+// 用于pow(x, ±0.5)与pow<N, 2>的开方
+template <class T>
+inline typename simd<T>::type simd_pow_half(typename simd<T>::type x) {
+  using S = simd<T>;
+  const typename S::type inf = S::set1(std::numeric_limits<T>::infinity());
+  return S::select(S::cmp_eq(x, S::neg(inf)), inf, S::sqrt(S::add(x, S::set1(T(0)))));
+}
+
+// ======================== 整数幂 ========================
+// x^N 编译期展开为平方乘链 乘法次数为 floor(log2 N) + popcount(N) - 1
+template <class T, unsigned N>
+inline typename simd<T>::type simd_pow_n(typename simd<T>::type x) {
+  if constexpr (N == 0) {
+    return simd<T>::set1(T(1));
+  } else if constexpr (N == 1) {
+    return x;
+  } else if constexpr (N % 2 == 0) {
+    const typename simd<T>::type h = simd_pow_n<T, N / 2>(x);
+    return simd<T>::mul(h, h);
+  } else {
+    return simd<T>::mul(simd_pow_n<T, N - 1>(x), x);
+  }
+}
+
+// x^n 运行期整数指数 所有通道指数相同 平方乘循环 负指数取倒数
+template <class T>
+inline typename simd<T>::type simd_pow_int(typename simd<T>::type x, long long n) {
+  using S = simd<T>;
+  unsigned long long m = n < 0 ? 0ULL - static_cast<unsigned long long>(n) : static_cast<unsigned long long>(n);
+  typename S::type r = S::set1(T(1));
+  while (m != 0) {
+    if (m & 1) r = S::mul(r, x);
+    m >>= 1;
+    if (m != 0) x = S::mul(x, x);
+  }
+  return n < 0 ? S::div(S::set1(T(1)), r) : r;
+}
+
+// ======================== 精度档 ========================
+// 激活/特殊函数(tanh sigmoid erf softplus)的精度档 作为模板参数选择
+// accurate: 误差数ULP 处理inf/NaN/下溢
+// fast: 低次多项式/有理逼近 float与double相对误差均不超过约3e-7 输入截断到有限范围
+// 两档均透传NaN
+namespace md {
+
+enum class math_precision { accurate, fast };
+
+inline constexpr math_precision accurate_math = math_precision::accurate;
+inline constexpr math_precision fast_math = math_precision::fast;
+
+}  // namespace md
+
+// ======================== 快速exp ========================
+// 快速档共用 单次2^n缩放 e^r = 1 + r + r^2 * P3(r) 相对误差约1.5e-7
+// 输入截断到2^n为正规数的范围 (float约[-87.3, 88.3]) 不处理NaN
+template <class T>
+inline typename simd<T>::type simd_exp_fast(typename simd<T>::type x) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr bool is_float = std::is_same_v<T, float>;
+
+  const V xc = S::min(S::max(x, S::set1(is_float ? T(-87.3) : T(-708.3))), S::set1(is_float ? T(88.3) : T(709.0)));
+  const V n = S::round(S::mul(xc, S::set1(T(1.44269504088896341))));
+  V r = S::fnmadd(n, S::set1(is_float ? T(0.693359375) : T(6.93145751953125E-1)), xc);
+  r = S::fnmadd(n, S::set1(is_float ? T(-2.12194440e-4) : T(1.42860682030941723212E-6)), r);
+
+  static constexpr T coef[] = {T(0.008313140803493074), T(0.04189016432887303), T(0.1666710692779121),
+                               T(0.49999230200047196)};
+  const V y = S::fmadd(S::mul(r, r), simd_poly<T>(r, coef), S::add(r, S::set1(T(1))));
+  return S::mul(y, S::pow2n(n));
+}
+
+// ======================== expm1 ========================
+// 与simd_exp相同的约简与多项式 e^x - 1 = 2^n * (r + r^2 * P(r)) + (2^n - 1)
+// 小|x|时无相消 仅供tanh使用 输入需满足|x| <= 40
+template <class T>
+inline typename simd<T>::type simd_expm1(typename simd<T>::type x) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr bool is_float = std::is_same_v<T, float>;
+
+  const V n = S::round(S::mul(x, S::set1(T(1.44269504088896341))));
+  V r = S::fnmadd(n, S::set1(is_float ? T(0.693359375) : T(6.93145751953125E-1)), x);
+  r = S::fnmadd(n, S::set1(is_float ? T(-2.12194440e-4) : T(1.42860682030941723212E-6)), r);
+
+  V p;
+  if constexpr (is_float) {
+    static constexpr float coef[] = {1.9875691500E-4f, 1.3981999507E-3f, 8.3334519073E-3f,
+                                     4.1665795894E-2f, 1.6666665459E-1f, 5.0000001201E-1f};
+    p = simd_poly<T>(r, coef);
+  } else {
+    static constexpr double coef[] = {1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+                                      1.0 / 362880.0,     1.0 / 40320.0,     1.0 / 5040.0,      1.0 / 720.0,
+                                      1.0 / 120.0,        1.0 / 24.0,        1.0 / 6.0,         1.0 / 2.0};
+    p = simd_poly<T>(r, coef);
+  }
+  const V u = S::fmadd(S::mul(r, r), p, r);
+  const V t = S::pow2n(n);
+  return S::fmadd(t, u, S::sub(t, S::set1(T(1))));
+}
+
+// ======================== tanh ========================
+// accurate: tanh(x) = e / (e + 2), e = expm1(2x)  float: <= 2.5 ULP  double: <= 2.5 ULP
+// fast: x * P6(x^2) / Q3(x^2) 有理逼近 无exp 逼近误差7e-9 float计算约3e-7
+// |x| 超过tanh舍入为1的阈值后截断
+template <class T, md::math_precision P = md::math_precision::accurate>
+inline typename simd<T>::type simd_tanh(typename simd<T>::type x) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr bool is_float = std::is_same_v<T, float>;
+
+  V y;
+  if constexpr (P == md::math_precision::fast) {
+    const V c = S::set1(T(9));
+    const V xc = S::min(S::max(x, S::neg(c)), c);
+    const V s = S::mul(xc, xc);
+    static constexpr T num[] = {T(-8.489036793705103e-14), T(5.278110838983205e-11), T(-2.022564129976687e-08),
+                                T(1.1154427692067155e-05), T(0.003103968641138689),  T(0.13084021507798052),
+                                T(0.9999999934154921)};
+    static constexpr T den[] = {T(0.0002546162719058362), T(0.02449522879104301), T(0.4641734861647057), T(1)};
+    y = S::div(S::mul(xc, simd_poly<T>(s, num)), simd_poly<T>(s, den));
+  } else {
+    const V c = S::set1(is_float ? T(9.0109) : T(19.0615));
+    const V xc = S::min(S::max(x, S::neg(c)), c);
+    const V e = simd_expm1<T>(S::add(xc, xc));
+    y = S::div(e, S::add(e, S::set1(T(2))));
+  }
+  return S::select(S::cmp_eq(x, x), y, x);  // NaN透传
+}
+
+// ======================== sigmoid ========================
+// 1 / (1 + e^-x)  accurate: float/double <= 2.5 ULP
+// fast: 使用simd_exp_fast 相对误差约2.5e-7 x < -87(float) 时结果截断为约1e-38
+template <class T, md::math_precision P = md::math_precision::accurate>
+inline typename simd<T>::type simd_sigmoid(typename simd<T>::type x) {
+  using S = simd<T>;
+  using V = typename S::type;
+
+  const V one = S::set1(T(1));
+  V e;
+  if constexpr (P == md::math_precision::fast) {
+    e = simd_exp_fast<T>(S::neg(x));
+  } else {
+    e = simd_exp<T>(S::neg(x));
+  }
+  const V y = S::div(one, S::add(one, e));
+  return S::select(S::cmp_eq(x, x), y, x);  // NaN透传
+}
+
+// ======================== erf ========================
+// |x| < 1: x * P(x^2)
+// 1 <= |x| < c: 1 - e^(-x^2) * Q(|x| - m)  Q逼近erfc(x)*e^(x^2)  |x| >= c 返回±1
+// accurate float: P5 Q8 c = 3.92  double: P11 Q13 按[1,1.6) [1.6,2.6) [2.6,5.92)三段逐通道选系数
+// fast: float系数与simd_exp_fast 相对误差约1e-7
+// 误差 accurate float: <= 2.5 ULP  double: <= 2 ULP
+template <class T, md::math_precision P = md::math_precision::accurate>
+inline typename simd<T>::type simd_erf(typename simd<T>::type x) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr bool use_float_coef = std::is_same_v<T, float> || P == md::math_precision::fast;
+
+  const V one = S::set1(T(1));
+  const V ax = S::abs(x);
+  const V s = S::mul(x, x);
+
+  V lo;  // |x| < 1
+  V q;   // erfc(x) * e^(x^2)
+  V c;
+  if constexpr (use_float_coef) {
+    static constexpr T ps[] = {T(-0.0005631684137424228), T(0.004917606062103015), T(-0.0267113465575035),
+                               T(0.11280180742005509),    T(-0.3761232614399752),  T(1.1283791224378665)};
+    lo = S::mul(x, simd_poly<T>(s, ps));
+    c = S::set1(T(3.92));
+    const V u = S::sub(S::min(ax, c), S::set1(T(2.46)));
+    if constexpr (P == md::math_precision::fast) {
+      static constexpr T qs[] = {T(0.001350757291133822),  T(0.002283720534807941), T(0.005970865262679586),
+                                 T(-0.007060126778947478), T(0.02576434722155244),  T(-0.07660194334924275),
+                                 T(0.21379046099992496)};
+      q = simd_poly<T>(u, qs);
+    } else {
+      static constexpr T qs[] = {T(0.00010787407551266158), T(0.00019585014839223008), T(0.0004933926743959857),
+                                 T(-0.0007801727813276509), T(0.0024444795875253125),  T(-0.008515364123423982),
+                                 T(0.025912348599312865),   T(-0.07637479939944153),   T(0.21382171959910923)};
+      q = simd_poly<T>(u, qs);
+    }
+  } else {
+    static constexpr double ps[] = {-7.780257145039315e-10, 1.3711369556511704e-08, -1.6206394260886543e-07,
+                                    1.644714055559309e-06,  -1.4924712876001809e-05, 0.0001205529359668298,
+                                    -0.0008548325929545439, 0.00522397760611163,     -0.026866170643108738,
+                                    0.11283791670944152,    -0.3761263890318352,     1.1283791670955126};
+    lo = S::mul(x, simd_poly<T>(s, ps));
+
+    static constexpr double q1[] = {
+        -1.4203786691049152e-06, 4.55734451463134e-06,  -1.4383223526876847e-05, 4.533532123684588e-05,
+        -0.0001381784899924644,  0.0004063785681450943, -0.001150084770076485,   0.0031206212120389945,
+        -0.008082104672390723,   0.01986859978248256,   -0.046034441391236164,   0.09958197337290746,
+        -0.19850822747167784,    0.3576426690860903};
+    static constexpr double q2[] = {
+        -7.714927345514569e-08, 2.5737047177994306e-07, -9.198632880992671e-07,  3.4215243659702012e-06,
+        -1.2301852646292175e-05, 4.2951814221885616e-05, -0.00014554540253027034, 0.0004774519684942083,
+        -0.0015120591720903457, 0.004607680155109862,   -0.013456276208079427,   0.03747354034903519,
+        -0.09887884904579203,   0.24511912334517227};
+    static constexpr double q3[] = {
+        -1.1041193035741354e-09, -6.604331052894386e-09, -2.7541439348924204e-08, -3.118766489964588e-08,
+        -1.396084785035685e-07,  4.280668212963284e-07,  -2.3036554018219857e-06, 1.1712837033648818e-05,
+        -5.787303328983693e-05,  0.0002816660714378869,  -0.0013446096211434545,  0.006291357840476933,
+        -0.028818099813772702,   0.12905646330464926};
+    c = S::set1(T(5.92));
+    const auto m2 = S::cmp_le(S::set1(T(1.6)), ax);
+    const auto m3 = S::cmp_le(S::set1(T(2.6)), ax);
+    auto pick = [&](double a, double b, double d) {
+      return S::select(m3, S::set1(d), S::select(m2, S::set1(b), S::set1(a)));
+    };
+    const V u = S::sub(S::min(ax, c), pick(1.3, 2.1, 4.26));
+    q = pick(q1[0], q2[0], q3[0]);
+    for (size_t k = 1; k < 14; ++k) q = S::fmadd(q, u, pick(q1[k], q2[k], q3[k]));
+  }
+
+  const V e = P == md::math_precision::fast ? simd_exp_fast<T>(S::neg(s)) : simd_exp<T>(S::neg(s));
+  V hi = S::select(S::cmp_lt(ax, c), S::fnmadd(e, q, one), one);
+  hi = S::select(S::cmp_lt(x, S::set1(T(0))), S::neg(hi), hi);
+
+  const V y = S::select(S::cmp_lt(ax, one), lo, hi);
+  return S::select(S::cmp_eq(x, x), y, x);  // NaN透传
+}
+
+// ======================== softplus ========================
+// log(1 + e^x) = max(x, 0) + log1p(e^-|x|) 大|x|无上溢
+// accurate: log1p(y) = log(1 + y) * y / ((1 + y) - 1) 补偿1 + y的舍入  float/double <= 3 ULP
+// fast: log1p(y) = y * P8(y), y in (0, 1] 与simd_exp_fast 相对误差约1e-7
+template <class T, md::math_precision P = md::math_precision::accurate>
+inline typename simd<T>::type simd_softplus(typename simd<T>::type x) {
+  using S = simd<T>;
+  using V = typename S::type;
+
+  const V one = S::set1(T(1));
+  V l;
+  if constexpr (P == md::math_precision::fast) {
+    const V y = simd_exp_fast<T>(S::neg(S::abs(x)));
+    static constexpr T coef[] = {T(0.005229887957299783), T(-0.029493863345883897), T(0.07820727565585725),
+                                 T(-0.13661653258671583), T(0.19105254741891073),   T(-0.24842787926930768),
+                                 T(0.3331907143582422),   T(-0.49999491746070535),  T(0.9999999691514141)};
+    l = S::mul(y, simd_poly<T>(y, coef));
+  } else {
+    const V y = simd_exp<T>(S::neg(S::abs(x)));
+    const V u = S::add(one, y);
+    const V d = S::sub(u, one);
+    l = S::select(S::cmp_eq(d, S::set1(T(0))), y, S::div(S::mul(simd_log<T>(u), y), d));
+  }
+  const V r = S::add(S::max(x, S::set1(T(0))), l);
+  return S::select(S::cmp_eq(x, x), r, x);  // NaN透传
+}
+
+// ======================== 快速除法 ========================
+// 硬件近似倒数y0经牛顿迭代 y' = y + y*(1 - b*y) 每步有效位数翻倍 迭代至T的尾数位数 再乘以被除数
+// 无近似倒数指令(rcp_bits >= 尾数位数)时直接除法
+// 误差 float: <= 2.5 ULP (无FMA时 <= 3 ULP)  double: <= 2 ULP
+// b为0/inf/NaN时与除法一致 b为非正规数时结果可能为±inf
+template <class T>
+inline typename simd<T>::type simd_div_fast(typename simd<T>::type a, typename simd<T>::type b) {
+  using S = simd<T>;
+  using V = typename S::type;
+  constexpr int digits = std::numeric_limits<T>::digits;
+
+  if constexpr (S::rcp_bits >= digits) {
+    return S::div(a, b);
+  } else {
+    const V one = S::set1(T(1));
+    const V y0 = S::rcp(b);
+    V y = y0;
+    for (int bits = S::rcp_bits; bits < digits; bits *= 2) {
+      y = S::fmadd(y, S::fnmadd(b, y, one), y);
+    }
+    // b为0或inf时迭代产生NaN 保留y0 (inf/0)
+    y = S::select(S::cmp_eq(y, y), y, y0);
+    return S::mul(a, y);
+  }
+}
+
+#endif  // __MDVECTOR_SIMD_MATH_H__
@@ -1,11 +1,25 @@
 #ifndef __MDVECTOR_X86_AVX2_H__
 #define __MDVECTOR_X86_AVX2_H__
 
+#include <cstdint>
+
 #include "simd_base.h"
 
 // ======================== AVX2 ========================
 #include <immintrin.h>
 
+namespace md {
+namespace detail {
+
+// 非临时存储为弱序 写完后以sfence保证其先于之后的存储对其他线程可见
+inline void stream_fence() { _mm_sfence(); }
+
+// 逐元素求值主循环每次处理的pack数
+inline constexpr size_t unroll_factor = 4;
+
+}  // namespace detail
+}  // namespace md
+
 template <>
 struct simd<float> {
   static constexpr size_t alignment = 32;
@@ -15,6 +29,7 @@ struct simd<float> {
   // 对齐操作
   static inline type load(const float* p) { return _mm256_load_ps(p); }
   static inline void store(float* p, type v) { _mm256_store_ps(p, v); }
+  static inline void stream(float* p, type v) { _mm256_stream_ps(p, v); }
 
   // 非对齐操作
   static inline type loadu(const float* p) { return _mm256_loadu_ps(p); }
@@ -26,6 +41,11 @@ struct simd<float> {
   static inline type mul(type a, type b) { return _mm256_mul_ps(a, b); }
   static inline type div(type a, type b) { return _mm256_div_ps(a, b); }
 
+  // 融合乘加 a * b + c / a * b - c / c - a * b
+  static inline type fmadd(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+  static inline type fmsub(type a, type b, type c) { return _mm256_fmsub_ps(a, b, c); }
+  static inline type fnmadd(type a, type b, type c) { return _mm256_fnmadd_ps(a, b, c); }
+
   // 掩码表
   static inline const __m256i mask_table[8] = {
       _mm256_set_epi32(0, 0, 0, 0, 0, 0, 0, 0),        // 0个元素
@@ -71,6 +91,57 @@ struct simd<float> {
   }
 
   static inline type set1(float val) { return _mm256_set1_ps(val); }
+
+  // 最值与取整
+  static inline type min(type a, type b) { return _mm256_min_ps(a, b); }
+  static inline type max(type a, type b) { return _mm256_max_ps(a, b); }
+  static inline type round(type a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+  static inline type floor(type a) { return _mm256_floor_ps(a); }
+  static inline type ceil(type a) { return _mm256_ceil_ps(a); }
+
+  // 开方 绝对值 取负
+  static inline type sqrt(type a) { return _mm256_sqrt_ps(a); }
+  // 近似倒数 相对误差 <= 1.5*2^-12 供快速除法牛顿迭代使用
+  static constexpr int rcp_bits = 12;
+  static inline type rcp(type a) { return _mm256_rcp_ps(a); }
+  static inline type abs(type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+  static inline type neg(type a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+
+  // 通道整体向高位移动K个 低K个通道取自fill 用于前缀扫描
+  template <int K>
+  static inline type shift_up(type v, type fill) {
+    const __m256i idx = _mm256_sub_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(K));
+    return _mm256_blend_ps(_mm256_permutevar8x32_ps(v, idx), fill, (1 << K) - 1);
+  }
+  static inline type broadcast_last(type v) { return _mm256_permutevar8x32_ps(v, _mm256_set1_epi32(7)); }
+
+  // 比较与选择 掩码为全1通道
+  using mask_type = type;
+  static inline mask_type cmp_lt(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+  static inline mask_type cmp_le(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+  static inline mask_type cmp_ne(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm256_and_ps(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm256_or_ps(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+  static inline type select(mask_type m, type a, type b) { return _mm256_blendv_ps(b, a, m); }
+
+  // 指数位操作 n为整数值 返回2^n
+  static inline type pow2n(type n) {
+    const type biased = _mm256_add_ps(n, _mm256_set1_ps(8388608.0f + 127.0f));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_castps_si256(biased), 23));
+  }
+  // 正规正数的指数 floor(log2(x))
+  static inline type get_exp(type x) {
+    const __m256i e = _mm256_srli_epi32(_mm256_castps_si256(x), 23);
+    const type f = _mm256_castsi256_ps(_mm256_or_si256(e, _mm256_set1_epi32(0x4B000000)));
+    return _mm256_sub_ps(f, _mm256_set1_ps(8388608.0f + 127.0f));
+  }
+  // 正规正数的尾数 [1, 2)
+  static inline type get_mant(type x) {
+    const __m256i m = _mm256_and_si256(_mm256_castps_si256(x), _mm256_set1_epi32(0x007FFFFF));
+    return _mm256_castsi256_ps(_mm256_or_si256(m, _mm256_set1_epi32(0x3F800000)));
+  }
 };
 
 template <>
@@ -82,6 +153,7 @@ struct simd<double> {
   // 对齐操作
   static inline type load(const double* p) { return _mm256_load_pd(p); }
   static inline void store(double* p, type v) { _mm256_store_pd(p, v); }
+  static inline void stream(double* p, type v) { _mm256_stream_pd(p, v); }
 
   // 非对齐操作
   static inline type loadu(const double* p) { return _mm256_loadu_pd(p); }
@@ -93,6 +165,11 @@ struct simd<double> {
   static inline type mul(type a, type b) { return _mm256_mul_pd(a, b); }
   static inline type div(type a, type b) { return _mm256_div_pd(a, b); }
 
+  // 融合乘加 a * b + c / a * b - c / c - a * b
+  static inline type fmadd(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+  static inline type fmsub(type a, type b, type c) { return _mm256_fmsub_pd(a, b, c); }
+  static inline type fnmadd(type a, type b, type c) { return _mm256_fnmadd_pd(a, b, c); }
+
   // 掩码表
   static inline const __m256i mask_table[4] = {
       _mm256_set_epi64x(0, 0, 0, 0),    // 0元素
@@ -134,5 +211,494 @@ struct simd<double> {
   }
 
   static inline type set1(double val) { return _mm256_set1_pd(val); }
+
+  // 最值与取整
+  static inline type min(type a, type b) { return _mm256_min_pd(a, b); }
+  static inline type max(type a, type b) { return _mm256_max_pd(a, b); }
+  static inline type round(type a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+  static inline type floor(type a) { return _mm256_floor_pd(a); }
+  static inline type ceil(type a) { return _mm256_ceil_pd(a); }
+
+  // 开方 绝对值 取负
+  static inline type sqrt(type a) { return _mm256_sqrt_pd(a); }
+  // 无double近似倒数指令 快速除法直接使用除法
+  static constexpr int rcp_bits = 53;
+  static inline type rcp(type a) { return _mm256_div_pd(_mm256_set1_pd(1.0), a); }
+  static inline type abs(type a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+  static inline type neg(type a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+
+  // 通道整体向高位移动K个 低K个通道取自fill 用于前缀扫描
+  template <int K>
+  static inline type shift_up(type v, type fill) {
+    // K == 1: (0, 0, 1, 2)  K == 2: (0, 0, 0, 1)
+    return _mm256_blend_pd(_mm256_permute4x64_pd(v, K == 1 ? 0x90 : 0x40), fill, (1 << K) - 1);
+  }
+  static inline type broadcast_last(type v) { return _mm256_permute4x64_pd(v, 0xFF); }
+
+  // 比较与选择 掩码为全1通道
+  using mask_type = type;
+  static inline mask_type cmp_lt(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+  static inline mask_type cmp_le(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+  static inline mask_type cmp_ne(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm256_and_pd(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm256_or_pd(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm256_xor_pd(a, _mm256_castsi256_pd(_mm256_set1_epi64x(-1))); }
+  static inline type select(mask_type m, type a, type b) { return _mm256_blendv_pd(b, a, m); }
+
+  // 指数位操作 n为整数值 返回2^n
+  static inline type pow2n(type n) {
+    const type biased = _mm256_add_pd(n, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+    return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(biased), 52));
+  }
+  // 正规正数的指数 floor(log2(x))
+  static inline type get_exp(type x) {
+    const __m256i e = _mm256_srli_epi64(_mm256_castpd_si256(x), 52);
+    const type f = _mm256_castsi256_pd(_mm256_or_si256(e, _mm256_set1_epi64x(0x4330000000000000)));
+    return _mm256_sub_pd(f, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+  }
+  // 正规正数的尾数 [1, 2)
+  static inline type get_mant(type x) {
+    const __m256i m = _mm256_and_si256(_mm256_castpd_si256(x), _mm256_set1_epi64x(0x000FFFFFFFFFFFFF));
+    return _mm256_castsi256_pd(_mm256_or_si256(m, _mm256_set1_epi64x(0x3FF0000000000000)));
+  }
+};
+
+// ======================== AVX2 整数 ========================
+// 整数类型共用__m256i 无对应指令的运算(除法 8位乘法与移位 64位乘法与算术右移)由组合指令或逐通道回退实现
+// shl/shr为逐通道移位 有符号类型右移为算术右移
+
+template <>
+struct simd<int32_t> {
+  static constexpr size_t alignment = 32;
+  static constexpr size_t pack_size = 8;
+  using type = __m256i;
+
+  // 对齐操作
+  static inline type load(const int32_t* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+  static inline void store(int32_t* p, type v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+  static inline void stream(int32_t* p, type v) { _mm256_stream_si256(reinterpret_cast<__m256i*>(p), v); }
+
+  // 非对齐操作
+  static inline type loadu(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+  static inline void storeu(int32_t* p, type v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+  // 算术运算
+  static inline type add(type a, type b) { return _mm256_add_epi32(a, b); }
+  static inline type sub(type a, type b) { return _mm256_sub_epi32(a, b); }
+  static inline type mul(type a, type b) { return _mm256_mullo_epi32(a, b); }
+  static inline type div(type a, type b) {
+    return md::detail::int_div<int32_t>(a, b);
+  }
+
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  // 掩码操作 复用float掩码表 remaining为pack_size时取全1 maskload/maskstore不要求对齐
+  static inline __m256i mask(const size_t& remaining) {
+    return remaining < pack_size ? simd<float>::mask_table[remaining] : _mm256_set1_epi32(-1);
+  }
+  static inline type mask_load(const int32_t* p, const size_t& remaining) {
+    return _mm256_maskload_epi32(p, mask(remaining));
+  }
+  static inline void mask_store(int32_t* p, const size_t& remaining, type v) {
+    _mm256_maskstore_epi32(p, mask(remaining), v);
+  }
+  static inline type mask_loadu(const int32_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int32_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int32_t val) { return _mm256_set1_epi32(val); }
+
+  // 最值 绝对值 取负
+  static inline type min(type a, type b) { return _mm256_min_epi32(a, b); }
+  static inline type max(type a, type b) { return _mm256_max_epi32(a, b); }
+  static inline type abs(type a) { return _mm256_abs_epi32(a); }
+  static inline type neg(type a) { return _mm256_sub_epi32(_mm256_setzero_si256(), a); }
+
+  // 位运算与移位
+  static inline type bit_and(type a, type b) { return _mm256_and_si256(a, b); }
+  static inline type bit_or(type a, type b) { return _mm256_or_si256(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm256_xor_si256(a, b); }
+  static inline type bit_not(type a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+  static inline type shl(type a, int n) { return _mm256_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+  static inline type shr(type a, int n) { return _mm256_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+
+  // 比较与选择 掩码为全1通道
+  using mask_type = type;
+  static inline mask_type cmp_lt(type a, type b) { return _mm256_cmpgt_epi32(b, a); }
+  static inline mask_type cmp_le(type a, type b) { return mask_not(_mm256_cmpgt_epi32(a, b)); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm256_cmpeq_epi32(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(_mm256_cmpeq_epi32(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm256_and_si256(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm256_or_si256(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+  static inline type select(mask_type m, type a, type b) { return _mm256_blendv_epi8(b, a, m); }
+};
+
+template <>
+struct simd<int64_t> {
+  static constexpr size_t alignment = 32;
+  static constexpr size_t pack_size = 4;
+  using type = __m256i;
+
+  // 对齐操作
+  static inline type load(const int64_t* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+  static inline void store(int64_t* p, type v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+  static inline void stream(int64_t* p, type v) { _mm256_stream_si256(reinterpret_cast<__m256i*>(p), v); }
+
+  // 非对齐操作
+  static inline type loadu(const int64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+  static inline void storeu(int64_t* p, type v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+  // 算术运算
+  static inline type add(type a, type b) { return _mm256_add_epi64(a, b); }
+  static inline type sub(type a, type b) { return _mm256_sub_epi64(a, b); }
+  // AVX2无64位乘法 由32位乘法拼出低64位
+  static inline type mul(type a, type b) {
+    const __m256i lo = _mm256_mul_epu32(a, b);
+    const __m256i cross =
+        _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b), _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+  }
+  static inline type div(type a, type b) {
+    return md::detail::int_div<int64_t>(a, b);
+  }
+
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  // 掩码操作 复用double掩码表 remaining为pack_size时取全1 maskload/maskstore不要求对齐
+  static inline __m256i mask(const size_t& remaining) {
+    return remaining < pack_size ? simd<double>::mask_table[remaining] : _mm256_set1_epi32(-1);
+  }
+  static inline type mask_load(const int64_t* p, const size_t& remaining) {
+    return _mm256_maskload_epi64(reinterpret_cast<const long long*>(p), mask(remaining));
+  }
+  static inline void mask_store(int64_t* p, const size_t& remaining, type v) {
+    _mm256_maskstore_epi64(reinterpret_cast<long long*>(p), mask(remaining), v);
+  }
+  static inline type mask_loadu(const int64_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int64_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int64_t val) { return _mm256_set1_epi64x(val); }
+
+  // 最值 绝对值 取负
+  static inline type min(type a, type b) { return select(_mm256_cmpgt_epi64(a, b), b, a); }
+  static inline type max(type a, type b) { return select(_mm256_cmpgt_epi64(a, b), a, b); }
+  static inline type abs(type a) { return select(_mm256_cmpgt_epi64(_mm256_setzero_si256(), a), neg(a), a); }
+  static inline type neg(type a) { return _mm256_sub_epi64(_mm256_setzero_si256(), a); }
+
+  // 位运算与移位 无64位算术右移 由逻辑右移后修正符号位
+  static inline type bit_and(type a, type b) { return _mm256_and_si256(a, b); }
+  static inline type bit_or(type a, type b) { return _mm256_or_si256(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm256_xor_si256(a, b); }
+  static inline type bit_not(type a) { return _mm256_xor_si256(a, _mm256_set1_epi64x(-1)); }
+  static inline type shl(type a, int n) { return _mm256_sll_epi64(a, _mm_cvtsi32_si128(n)); }
+  static inline type shr(type a, int n) {
+    const __m128i cnt = _mm_cvtsi32_si128(n);
+    const __m256i sign = _mm256_srl_epi64(_mm256_set1_epi64x(INT64_MIN), cnt);
+    return _mm256_sub_epi64(_mm256_xor_si256(_mm256_srl_epi64(a, cnt), sign), sign);
+  }
+
+  // 比较与选择 掩码为全1通道
+  using mask_type = type;
+  static inline mask_type cmp_lt(type a, type b) { return _mm256_cmpgt_epi64(b, a); }
+  static inline mask_type cmp_le(type a, type b) { return mask_not(_mm256_cmpgt_epi64(a, b)); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm256_cmpeq_epi64(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(_mm256_cmpeq_epi64(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm256_and_si256(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm256_or_si256(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm256_xor_si256(a, _mm256_set1_epi64x(-1)); }
+  static inline type select(mask_type m, type a, type b) { return _mm256_blendv_epi8(b, a, m); }
+};
+
+template <>
+struct simd<int16_t> {
+  static constexpr size_t alignment = 32;
+  static constexpr size_t pack_size = 16;
+  using type = __m256i;
+
+  // 对齐操作
+  static inline type load(const int16_t* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+  static inline void store(int16_t* p, type v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+  static inline void stream(int16_t* p, type v) { _mm256_stream_si256(reinterpret_cast<__m256i*>(p), v); }
+
+  // 非对齐操作
+  static inline type loadu(const int16_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+  static inline void storeu(int16_t* p, type v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+  // 算术运算
+  static inline type add(type a, type b) { return _mm256_add_epi16(a, b); }
+  static inline type sub(type a, type b) { return _mm256_sub_epi16(a, b); }
+  static inline type mul(type a, type b) { return _mm256_mullo_epi16(a, b); }
+  static inline type div(type a, type b) {
+    return md::detail::int_div<int16_t>(a, b);
+  }
+
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  // 掩码操作 AVX2无16位maskload 使用缓冲区
+  static inline type mask_load(const int16_t* p, const size_t& remaining) {
+    return md::detail::partial_load<int16_t, type>(p, remaining);
+  }
+  static inline void mask_store(int16_t* p, const size_t& remaining, type v) {
+    md::detail::partial_store(p, remaining, v);
+  }
+  static inline type mask_loadu(const int16_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int16_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int16_t val) { return _mm256_set1_epi16(val); }
+
+  // 最值 绝对值 取负
+  static inline type min(type a, type b) { return _mm256_min_epi16(a, b); }
+  static inline type max(type a, type b) { return _mm256_max_epi16(a, b); }
+  static inline type abs(type a) { return _mm256_abs_epi16(a); }
+  static inline type neg(type a) { return _mm256_sub_epi16(_mm256_setzero_si256(), a); }
+
+  // 位运算与移位
+  static inline type bit_and(type a, type b) { return _mm256_and_si256(a, b); }
+  static inline type bit_or(type a, type b) { return _mm256_or_si256(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm256_xor_si256(a, b); }
+  static inline type bit_not(type a) { return _mm256_xor_si256(a, _mm256_set1_epi16(-1)); }
+  static inline type shl(type a, int n) { return _mm256_sll_epi16(a, _mm_cvtsi32_si128(n)); }
+  static inline type shr(type a, int n) { return _mm256_sra_epi16(a, _mm_cvtsi32_si128(n)); }
+
+  // 比较与选择 掩码为全1通道
+  using mask_type = type;
+  static inline mask_type cmp_lt(type a, type b) { return _mm256_cmpgt_epi16(b, a); }
+  static inline mask_type cmp_le(type a, type b) { return mask_not(_mm256_cmpgt_epi16(a, b)); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm256_cmpeq_epi16(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(_mm256_cmpeq_epi16(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm256_and_si256(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm256_or_si256(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm256_xor_si256(a, _mm256_set1_epi16(-1)); }
+  static inline type select(mask_type m, type a, type b) { return _mm256_blendv_epi8(b, a, m); }
+};
+
+template <>
+struct simd<uint8_t> {
+  static constexpr size_t alignment = 32;
+  static constexpr size_t pack_size = 32;
+  using type = __m256i;
+
+  // 对齐操作
+  static inline type load(const uint8_t* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+  static inline void store(uint8_t* p, type v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+  static inline void stream(uint8_t* p, type v) { _mm256_stream_si256(reinterpret_cast<__m256i*>(p), v); }
+
+  // 非对齐操作
+  static inline type loadu(const uint8_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+  static inline void storeu(uint8_t* p, type v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+  // 算术运算 结果按256取模
+  static inline type add(type a, type b) { return _mm256_add_epi8(a, b); }
+  static inline type sub(type a, type b) { return _mm256_sub_epi8(a, b); }
+  // 无8位乘法 奇偶字节分别用16位乘法计算
+  static inline type mul(type a, type b) {
+    const __m256i even = _mm256_and_si256(_mm256_mullo_epi16(a, b), _mm256_set1_epi16(0x00FF));
+    const __m256i odd = _mm256_slli_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8)), 8);
+    return _mm256_or_si256(even, odd);
+  }
+  static inline type div(type a, type b) {
+    return md::detail::int_div<uint8_t>(a, b);
+  }
+
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  // 掩码操作 AVX2无8位maskload 使用缓冲区
+  static inline type mask_load(const uint8_t* p, const size_t& remaining) {
+    return md::detail::partial_load<uint8_t, type>(p, remaining);
+  }
+  static inline void mask_store(uint8_t* p, const size_t& remaining, type v) {
+    md::detail::partial_store(p, remaining, v);
+  }
+  static inline type mask_loadu(const uint8_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(uint8_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(uint8_t val) { return _mm256_set1_epi8(static_cast<char>(val)); }
+
+  // 最值 绝对值 取负(按256取模)
+  static inline type min(type a, type b) { return _mm256_min_epu8(a, b); }
+  static inline type max(type a, type b) { return _mm256_max_epu8(a, b); }
+  static inline type abs(type a) { return a; }
+  static inline type neg(type a) { return _mm256_sub_epi8(_mm256_setzero_si256(), a); }
+
+  // 位运算与移位 无8位移位 以16位移位后屏蔽跨字节的位
+  static inline type bit_and(type a, type b) { return _mm256_and_si256(a, b); }
+  static inline type bit_or(type a, type b) { return _mm256_or_si256(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm256_xor_si256(a, b); }
+  static inline type bit_not(type a) { return _mm256_xor_si256(a, _mm256_set1_epi8(-1)); }
+  static inline type shl(type a, int n) {
+    const __m256i keep = _mm256_set1_epi8(static_cast<char>(n < 8 ? 0xFF << n : 0));
+    return _mm256_and_si256(_mm256_sll_epi16(a, _mm_cvtsi32_si128(n)), keep);
+  }
+  static inline type shr(type a, int n) {
+    const __m256i keep = _mm256_set1_epi8(static_cast<char>(n < 8 ? 0xFF >> n : 0));
+    return _mm256_and_si256(_mm256_srl_epi16(a, _mm_cvtsi32_si128(n)), keep);
+  }
+
+  // 比较与选择 无符号比较由min/max与相等比较组合
+  using mask_type = type;
+  static inline mask_type cmp_lt(type a, type b) { return mask_not(cmp_le(b, a)); }
+  static inline mask_type cmp_le(type a, type b) { return _mm256_cmpeq_epi8(_mm256_min_epu8(a, b), a); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm256_cmpeq_epi8(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(_mm256_cmpeq_epi8(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm256_and_si256(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm256_or_si256(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm256_xor_si256(a, _mm256_set1_epi8(-1)); }
+  static inline type select(mask_type m, type a, type b) { return _mm256_blendv_epi8(b, a, m); }
+};
+
+// ======================== 16位浮点存储 ========================
+// 存储为16位 寄存器内扩展为simd<float>计算 尾部经栈缓冲处理
+template <>
+struct simd_storage<md::half> {
+  static constexpr size_t pack_size = simd<float>::pack_size;
+  using type = simd<float>::type;
+
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+  static inline type loadu(const md::half* p) {
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+  }
+  static inline void storeu(md::half* p, type v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+#else
+  // 无F16C 逐元素转换
+  static inline type loadu(const md::half* p) { return md::detail::widen_lanes<simd<float>>(p); }
+  static inline void storeu(md::half* p, type v) { md::detail::narrow_lanes<simd<float>>(p, v); }
+#endif
+
+  static inline type load(const md::half* p) { return loadu(p); }
+  static inline void store(md::half* p, type v) { storeu(p, v); }
+  static inline type mask_load(const md::half* p, const size_t& remaining) { return mask_loadu(p, remaining); }
+  static inline void mask_store(md::half* p, const size_t& remaining, type v) { mask_storeu(p, remaining, v); }
+  static inline type mask_loadu(const md::half* p, const size_t& remaining) {
+    return md::detail::storage_partial_load<simd_storage>(p, remaining);
+  }
+  static inline void mask_storeu(md::half* p, const size_t& remaining, type v) {
+    md::detail::storage_partial_store<simd_storage>(p, remaining, v);
+  }
+};
+
+// bfloat16为float的高16位 扩展为移位 收窄按就近舍入(偶数) NaN保持为静默NaN
+template <>
+struct simd_storage<md::bfloat16> {
+  static constexpr size_t pack_size = simd<float>::pack_size;
+  using type = simd<float>::type;
+
+  static inline type loadu(const md::bfloat16* p) {
+    const __m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(x, 16));
+  }
+  static inline void storeu(md::bfloat16* p, type v) {
+    const __m256i x = _mm256_castps_si256(v);
+    const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1));
+    __m256i r = _mm256_srli_epi32(_mm256_add_epi32(x, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7FFF))), 16);
+    const __m256i nan = _mm256_or_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(0x40));
+    r = _mm256_blendv_epi8(r, nan, _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)));
+    const __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), packed);
+  }
+
+  static inline type load(const md::bfloat16* p) { return loadu(p); }
+  static inline void store(md::bfloat16* p, type v) { storeu(p, v); }
+  static inline type mask_load(const md::bfloat16* p, const size_t& remaining) { return mask_loadu(p, remaining); }
+  static inline void mask_store(md::bfloat16* p, const size_t& remaining, type v) { mask_storeu(p, remaining, v); }
+  static inline type mask_loadu(const md::bfloat16* p, const size_t& remaining) {
+    return md::detail::storage_partial_load<simd_storage>(p, remaining);
+  }
+  static inline void mask_storeu(md::bfloat16* p, const size_t& remaining, type v) {
+    md::detail::storage_partial_store<simd_storage>(p, remaining, v);
+  }
+};
+
+// ======================== 元素类型转换 ========================
+// float -> double 加载4个float扩展
+template <>
+struct simd_convert<float, double> {
+  static inline simd<double>::type loadu(const float* p) { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+  static inline simd<double>::type mask_loadu(const float* p, const size_t& remaining) {
+    return _mm256_cvtps_pd(_mm_maskload_ps(p, _mm256_castsi256_si128(simd<float>::mask_table[remaining])));
+  }
+};
+
+// double -> float 两个__m256d收窄为一个__m256
+template <>
+struct simd_convert<double, float> {
+  static inline simd<float>::type narrow(simd<double>::type lo, simd<double>::type hi) {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(lo)), _mm256_cvtpd_ps(hi), 1);
+  }
+  static inline simd<float>::type loadu(const double* p) { return narrow(_mm256_loadu_pd(p), _mm256_loadu_pd(p + 4)); }
+  static inline simd<float>::type mask_loadu(const double* p, const size_t& remaining) {
+    return md::detail::narrow_mask_loadu<simd_convert>(p, remaining);
+  }
+};
+
+template <>
+struct simd_convert<int32_t, float> {
+  static inline simd<float>::type apply(simd<int32_t>::type v) { return _mm256_cvtepi32_ps(v); }
+  static inline simd<float>::type loadu(const int32_t* p) { return apply(simd<int32_t>::loadu(p)); }
+  static inline simd<float>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return apply(simd<int32_t>::mask_loadu(p, remaining));
+  }
+};
+
+// int16_t/uint8_t -> int64_t 窄整数以int64_t累加时的扩展加载 读取4个元素
+template <>
+struct simd_convert<int16_t, int64_t> : md::detail::convert_lanes<int16_t, int64_t> {
+  static inline simd<int64_t>::type loadu(const int16_t* p) {
+    return _mm256_cvtepi16_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+  }
+};
+
+template <>
+struct simd_convert<uint8_t, int64_t> : md::detail::convert_lanes<uint8_t, int64_t> {
+  static inline simd<int64_t>::type loadu(const uint8_t* p) {
+    int32_t bytes;
+    std::memcpy(&bytes, p, sizeof(bytes));
+    return _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(bytes));
+  }
+};
+
+// int32_t -> double/int64_t 加载4个int32_t扩展 结果精确 用于整数表达式的扩展转换与按更宽类型加载
+template <>
+struct simd_convert<int32_t, double> {
+  static inline simd<double>::type loadu(const int32_t* p) {
+    return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+  }
+  static inline simd<double>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return _mm256_cvtepi32_pd(_mm256_castsi256_si128(simd<int32_t>::mask_loadu(p, remaining)));
+  }
+};
+
+template <>
+struct simd_convert<int32_t, int64_t> {
+  static inline simd<int64_t>::type loadu(const int32_t* p) {
+    return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+  }
+  static inline simd<int64_t>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return _mm256_cvtepi32_epi64(_mm256_castsi256_si128(simd<int32_t>::mask_loadu(p, remaining)));
+  }
+};
+
+// 向零截断 与static_cast一致
+template <>
+struct simd_convert<float, int32_t> {
+  static inline simd<int32_t>::type apply(simd<float>::type v) { return _mm256_cvttps_epi32(v); }
+  static inline simd<int32_t>::type loadu(const float* p) { return apply(simd<float>::loadu(p)); }
+  static inline simd<int32_t>::type mask_loadu(const float* p, const size_t& remaining) {
+    return apply(simd<float>::mask_loadu(p, remaining));
+  }
 };
 #endif  // __X86_AVX2_H__
\ No newline at end of file
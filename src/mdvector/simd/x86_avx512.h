@@ -1,12 +1,26 @@
 #ifndef __MDVECTOR_X86_AVX512_H__
 #define __MDVECTOR_X86_AVX512_H__
 
+#include <cstdint>
+
 #include "simd_base.h"
 
 // ======================== AVX512 ========================
 
 #include <immintrin.h>
 
+namespace md {
+namespace detail {
+
+// 非临时存储为弱序 写完后以sfence保证其先于之后的存储对其他线程可见
+inline void stream_fence() { _mm_sfence(); }
+
+// 逐元素求值主循环每次处理的pack数
+inline constexpr size_t unroll_factor = 2;
+
+}  // namespace detail
+}  // namespace md
+
 template <>
 struct simd<float> {
   static constexpr size_t alignment = 64;
@@ -15,10 +29,16 @@ struct simd<float> {
 
   static inline type load(const float* p) { return _mm512_load_ps(p); }
   static inline void store(float* p, type v) { _mm512_store_ps(p, v); }
+  static inline void stream(float* p, type v) { _mm512_stream_ps(p, v); }
+  static inline type loadu(const float* p) { return _mm512_loadu_ps(p); }
+  static inline void storeu(float* p, type v) { _mm512_storeu_ps(p, v); }
   static inline type add(type a, type b) { return _mm512_add_ps(a, b); }
   static inline type sub(type a, type b) { return _mm512_sub_ps(a, b); }
   static inline type mul(type a, type b) { return _mm512_mul_ps(a, b); }
   static inline type div(type a, type b) { return _mm512_div_ps(a, b); }
+  static inline type fmadd(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+  static inline type fmsub(type a, type b, type c) { return _mm512_fmsub_ps(a, b, c); }
+  static inline type fnmadd(type a, type b, type c) { return _mm512_fnmadd_ps(a, b, c); }
 
   static inline __mmask16 mask(const size_t& remaining) { return (1u << remaining) - 1; }
 
@@ -36,6 +56,44 @@ struct simd<float> {
   }
 
   static inline type set1(float val) { return _mm512_set1_ps(val); }
+
+  static inline type min(type a, type b) { return _mm512_min_ps(a, b); }
+  static inline type max(type a, type b) { return _mm512_max_ps(a, b); }
+  static inline type round(type a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+  static inline type floor(type a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+  static inline type ceil(type a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+
+  static inline type sqrt(type a) { return _mm512_sqrt_ps(a); }
+  // 近似倒数 相对误差 <= 2^-14 供快速除法牛顿迭代使用
+  static constexpr int rcp_bits = 14;
+  static inline type rcp(type a) { return _mm512_rcp14_ps(a); }
+  static inline type abs(type a) { return _mm512_abs_ps(a); }
+  // AVX512F无浮点xor 使用整数xor翻转符号位
+  static inline type neg(type a) {
+    return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(static_cast<int>(0x80000000))));
+  }
+
+  // 通道整体向高位移动K个 低K个通道取自fill 用于前缀扫描
+  template <int K>
+  static inline type shift_up(type v, type fill) {
+    return _mm512_castsi512_ps(_mm512_alignr_epi32(_mm512_castps_si512(v), _mm512_castps_si512(fill), 16 - K));
+  }
+  static inline type broadcast_last(type v) { return _mm512_permutexvar_ps(_mm512_set1_epi32(15), v); }
+
+  // 比较结果使用掩码寄存器
+  using mask_type = __mmask16;
+  static inline mask_type cmp_lt(type a, type b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+  static inline mask_type cmp_le(type a, type b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+  static inline mask_type cmp_ne(type a, type b) { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm512_kand(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm512_kor(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm512_knot(a); }
+  static inline type select(mask_type m, type a, type b) { return _mm512_mask_blend_ps(m, b, a); }
+
+  static inline type pow2n(type n) { return _mm512_scalef_ps(_mm512_set1_ps(1), n); }
+  static inline type get_exp(type x) { return _mm512_getexp_ps(x); }
+  static inline type get_mant(type x) { return _mm512_getmant_ps(x, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero); }
 };
 
 template <>
@@ -48,9 +106,13 @@ struct simd<double> {
   static inline type sub(type a, type b) { return _mm512_sub_pd(a, b); }
   static inline type mul(type a, type b) { return _mm512_mul_pd(a, b); }
   static inline type div(type a, type b) { return _mm512_div_pd(a, b); }
+  static inline type fmadd(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+  static inline type fmsub(type a, type b, type c) { return _mm512_fmsub_pd(a, b, c); }
+  static inline type fnmadd(type a, type b, type c) { return _mm512_fnmadd_pd(a, b, c); }
 
   static inline type load(const double* p) { return _mm512_load_pd(p); }
   static inline void store(double* p, type v) { _mm512_store_pd(p, v); }
+  static inline void stream(double* p, type v) { _mm512_stream_pd(p, v); }
   static inline type loadu(const double* p) { return _mm512_loadu_pd(p); }
   static inline void storeu(double* p, type v) { _mm512_storeu_pd(p, v); }
 
@@ -70,5 +132,474 @@ struct simd<double> {
   }
 
   static inline type set1(double val) { return _mm512_set1_pd(val); }
+
+  static inline type min(type a, type b) { return _mm512_min_pd(a, b); }
+  static inline type max(type a, type b) { return _mm512_max_pd(a, b); }
+  static inline type round(type a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+  static inline type floor(type a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+  static inline type ceil(type a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+
+  static inline type sqrt(type a) { return _mm512_sqrt_pd(a); }
+  static constexpr int rcp_bits = 14;
+  static inline type rcp(type a) { return _mm512_rcp14_pd(a); }
+  static inline type abs(type a) { return _mm512_abs_pd(a); }
+  // AVX512F无浮点xor 使用整数xor翻转符号位
+  static inline type neg(type a) {
+    return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(static_cast<long long>(0x8000000000000000))));
+  }
+
+  // 通道整体向高位移动K个 低K个通道取自fill 用于前缀扫描
+  template <int K>
+  static inline type shift_up(type v, type fill) {
+    return _mm512_castsi512_pd(_mm512_alignr_epi64(_mm512_castpd_si512(v), _mm512_castpd_si512(fill), 8 - K));
+  }
+  static inline type broadcast_last(type v) { return _mm512_permutexvar_pd(_mm512_set1_epi64(7), v); }
+
+  // 比较结果使用掩码寄存器
+  using mask_type = __mmask8;
+  static inline mask_type cmp_lt(type a, type b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+  static inline mask_type cmp_le(type a, type b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+  static inline mask_type cmp_ne(type a, type b) { return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return static_cast<mask_type>(a & b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return static_cast<mask_type>(a | b); }
+  static inline mask_type mask_not(mask_type a) { return static_cast<mask_type>(~a); }
+  static inline type select(mask_type m, type a, type b) { return _mm512_mask_blend_pd(m, b, a); }
+
+  static inline type pow2n(type n) { return _mm512_scalef_pd(_mm512_set1_pd(1), n); }
+  static inline type get_exp(type x) { return _mm512_getexp_pd(x); }
+  static inline type get_mant(type x) { return _mm512_getmant_pd(x, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero); }
+};
+
+// ======================== AVX512 整数 ========================
+// 整数类型共用__m512i 比较结果使用掩码寄存器 除法逐通道回退
+// int16_t/uint8_t需要AVX512BW 64位乘法优先使用AVX512DQ
+
+template <>
+struct simd<int32_t> {
+  static constexpr size_t alignment = 64;
+  static constexpr size_t pack_size = 16;
+  using type = __m512i;
+
+  static inline type load(const int32_t* p) { return _mm512_load_si512(p); }
+  static inline void store(int32_t* p, type v) { _mm512_store_si512(p, v); }
+  static inline void stream(int32_t* p, type v) { _mm512_stream_si512(reinterpret_cast<__m512i*>(p), v); }
+  static inline type loadu(const int32_t* p) { return _mm512_loadu_si512(p); }
+  static inline void storeu(int32_t* p, type v) { _mm512_storeu_si512(p, v); }
+  static inline type add(type a, type b) { return _mm512_add_epi32(a, b); }
+  static inline type sub(type a, type b) { return _mm512_sub_epi32(a, b); }
+  static inline type mul(type a, type b) { return _mm512_mullo_epi32(a, b); }
+  static inline type div(type a, type b) { return md::detail::int_div<int32_t>(a, b); }
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  static inline __mmask16 mask(const size_t& remaining) { return (1u << remaining) - 1; }
+
+  static inline type mask_load(const int32_t* p, const size_t& remaining) {
+    return _mm512_maskz_load_epi32(mask(remaining), p);
+  }
+  static inline type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return _mm512_maskz_loadu_epi32(mask(remaining), p);
+  }
+  static inline void mask_store(int32_t* p, const size_t& remaining, type v) {
+    _mm512_mask_store_epi32(p, mask(remaining), v);
+  }
+  static inline void mask_storeu(int32_t* p, const size_t& remaining, type v) {
+    _mm512_mask_storeu_epi32(p, mask(remaining), v);
+  }
+
+  static inline type set1(int32_t val) { return _mm512_set1_epi32(val); }
+
+  static inline type min(type a, type b) { return _mm512_min_epi32(a, b); }
+  static inline type max(type a, type b) { return _mm512_max_epi32(a, b); }
+  static inline type abs(type a) { return _mm512_abs_epi32(a); }
+  static inline type neg(type a) { return _mm512_sub_epi32(_mm512_setzero_si512(), a); }
+
+  static inline type bit_and(type a, type b) { return _mm512_and_si512(a, b); }
+  static inline type bit_or(type a, type b) { return _mm512_or_si512(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm512_xor_si512(a, b); }
+  static inline type bit_not(type a) { return _mm512_xor_si512(a, _mm512_set1_epi32(-1)); }
+  static inline type shl(type a, int n) { return _mm512_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+  static inline type shr(type a, int n) { return _mm512_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+
+  using mask_type = __mmask16;
+  static inline mask_type cmp_lt(type a, type b) { return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_LT); }
+  static inline mask_type cmp_le(type a, type b) { return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_LE); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_EQ); }
+  static inline mask_type cmp_ne(type a, type b) { return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_NE); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm512_kand(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm512_kor(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm512_knot(a); }
+  static inline type select(mask_type m, type a, type b) { return _mm512_mask_blend_epi32(m, b, a); }
+};
+
+template <>
+struct simd<int64_t> {
+  static constexpr size_t alignment = 64;
+  static constexpr size_t pack_size = 8;
+  using type = __m512i;
+
+  static inline type load(const int64_t* p) { return _mm512_load_si512(p); }
+  static inline void store(int64_t* p, type v) { _mm512_store_si512(p, v); }
+  static inline void stream(int64_t* p, type v) { _mm512_stream_si512(reinterpret_cast<__m512i*>(p), v); }
+  static inline type loadu(const int64_t* p) { return _mm512_loadu_si512(p); }
+  static inline void storeu(int64_t* p, type v) { _mm512_storeu_si512(p, v); }
+  static inline type add(type a, type b) { return _mm512_add_epi64(a, b); }
+  static inline type sub(type a, type b) { return _mm512_sub_epi64(a, b); }
+#if defined(__AVX512DQ__)
+  static inline type mul(type a, type b) { return _mm512_mullo_epi64(a, b); }
+#else
+  // 无AVX512DQ 由32位乘法拼出低64位
+  static inline type mul(type a, type b) {
+    const __m512i lo = _mm512_mul_epu32(a, b);
+    const __m512i cross =
+        _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), b), _mm512_mul_epu32(a, _mm512_srli_epi64(b, 32)));
+    return _mm512_add_epi64(lo, _mm512_slli_epi64(cross, 32));
+  }
+#endif
+  static inline type div(type a, type b) { return md::detail::int_div<int64_t>(a, b); }
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  static inline __mmask8 mask(const size_t& remaining) { return (1u << remaining) - 1; }
+
+  static inline type mask_load(const int64_t* p, const size_t& remaining) {
+    return _mm512_maskz_load_epi64(mask(remaining), p);
+  }
+  static inline type mask_loadu(const int64_t* p, const size_t& remaining) {
+    return _mm512_maskz_loadu_epi64(mask(remaining), p);
+  }
+  static inline void mask_store(int64_t* p, const size_t& remaining, type v) {
+    _mm512_mask_store_epi64(p, mask(remaining), v);
+  }
+  static inline void mask_storeu(int64_t* p, const size_t& remaining, type v) {
+    _mm512_mask_storeu_epi64(p, mask(remaining), v);
+  }
+
+  static inline type set1(int64_t val) { return _mm512_set1_epi64(val); }
+
+  static inline type min(type a, type b) { return _mm512_min_epi64(a, b); }
+  static inline type max(type a, type b) { return _mm512_max_epi64(a, b); }
+  static inline type abs(type a) { return _mm512_abs_epi64(a); }
+  static inline type neg(type a) { return _mm512_sub_epi64(_mm512_setzero_si512(), a); }
+
+  static inline type bit_and(type a, type b) { return _mm512_and_si512(a, b); }
+  static inline type bit_or(type a, type b) { return _mm512_or_si512(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm512_xor_si512(a, b); }
+  static inline type bit_not(type a) { return _mm512_xor_si512(a, _mm512_set1_epi64(-1)); }
+  static inline type shl(type a, int n) { return _mm512_sll_epi64(a, _mm_cvtsi32_si128(n)); }
+  static inline type shr(type a, int n) { return _mm512_sra_epi64(a, _mm_cvtsi32_si128(n)); }
+
+  using mask_type = __mmask8;
+  static inline mask_type cmp_lt(type a, type b) { return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_LT); }
+  static inline mask_type cmp_le(type a, type b) { return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_LE); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_EQ); }
+  static inline mask_type cmp_ne(type a, type b) { return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_NE); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return static_cast<mask_type>(a & b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return static_cast<mask_type>(a | b); }
+  static inline mask_type mask_not(mask_type a) { return static_cast<mask_type>(~a); }
+  static inline type select(mask_type m, type a, type b) { return _mm512_mask_blend_epi64(m, b, a); }
+};
+
+#if defined(__AVX512BW__)
+template <>
+struct simd<int16_t> {
+  static constexpr size_t alignment = 64;
+  static constexpr size_t pack_size = 32;
+  using type = __m512i;
+
+  static inline type load(const int16_t* p) { return _mm512_load_si512(p); }
+  static inline void store(int16_t* p, type v) { _mm512_store_si512(p, v); }
+  static inline void stream(int16_t* p, type v) { _mm512_stream_si512(reinterpret_cast<__m512i*>(p), v); }
+  static inline type loadu(const int16_t* p) { return _mm512_loadu_si512(p); }
+  static inline void storeu(int16_t* p, type v) { _mm512_storeu_si512(p, v); }
+  static inline type add(type a, type b) { return _mm512_add_epi16(a, b); }
+  static inline type sub(type a, type b) { return _mm512_sub_epi16(a, b); }
+  static inline type mul(type a, type b) { return _mm512_mullo_epi16(a, b); }
+  static inline type div(type a, type b) { return md::detail::int_div<int16_t>(a, b); }
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  // remaining为pack_size时移位量等于位宽 单独取全1
+  static inline __mmask32 mask(const size_t& remaining) {
+    return remaining < pack_size ? (1u << remaining) - 1 : ~__mmask32(0);
+  }
+
+  // 16位掩码访存无对齐版本 统一使用非对齐指令
+  static inline type mask_load(const int16_t* p, const size_t& remaining) {
+    return _mm512_maskz_loadu_epi16(mask(remaining), p);
+  }
+  static inline type mask_loadu(const int16_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_store(int16_t* p, const size_t& remaining, type v) {
+    _mm512_mask_storeu_epi16(p, mask(remaining), v);
+  }
+  static inline void mask_storeu(int16_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int16_t val) { return _mm512_set1_epi16(val); }
+
+  static inline type min(type a, type b) { return _mm512_min_epi16(a, b); }
+  static inline type max(type a, type b) { return _mm512_max_epi16(a, b); }
+  static inline type abs(type a) { return _mm512_abs_epi16(a); }
+  static inline type neg(type a) { return _mm512_sub_epi16(_mm512_setzero_si512(), a); }
+
+  static inline type bit_and(type a, type b) { return _mm512_and_si512(a, b); }
+  static inline type bit_or(type a, type b) { return _mm512_or_si512(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm512_xor_si512(a, b); }
+  static inline type bit_not(type a) { return _mm512_xor_si512(a, _mm512_set1_epi16(-1)); }
+  static inline type shl(type a, int n) { return _mm512_sll_epi16(a, _mm_cvtsi32_si128(n)); }
+  static inline type shr(type a, int n) { return _mm512_sra_epi16(a, _mm_cvtsi32_si128(n)); }
+
+  using mask_type = __mmask32;
+  static inline mask_type cmp_lt(type a, type b) { return _mm512_cmp_epi16_mask(a, b, _MM_CMPINT_LT); }
+  static inline mask_type cmp_le(type a, type b) { return _mm512_cmp_epi16_mask(a, b, _MM_CMPINT_LE); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm512_cmp_epi16_mask(a, b, _MM_CMPINT_EQ); }
+  static inline mask_type cmp_ne(type a, type b) { return _mm512_cmp_epi16_mask(a, b, _MM_CMPINT_NE); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return a & b; }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return a | b; }
+  static inline mask_type mask_not(mask_type a) { return ~a; }
+  static inline type select(mask_type m, type a, type b) { return _mm512_mask_blend_epi16(m, b, a); }
+};
+
+template <>
+struct simd<uint8_t> {
+  static constexpr size_t alignment = 64;
+  static constexpr size_t pack_size = 64;
+  using type = __m512i;
+
+  static inline type load(const uint8_t* p) { return _mm512_load_si512(p); }
+  static inline void store(uint8_t* p, type v) { _mm512_store_si512(p, v); }
+  static inline void stream(uint8_t* p, type v) { _mm512_stream_si512(reinterpret_cast<__m512i*>(p), v); }
+  static inline type loadu(const uint8_t* p) { return _mm512_loadu_si512(p); }
+  static inline void storeu(uint8_t* p, type v) { _mm512_storeu_si512(p, v); }
+  // 结果按256取模
+  static inline type add(type a, type b) { return _mm512_add_epi8(a, b); }
+  static inline type sub(type a, type b) { return _mm512_sub_epi8(a, b); }
+  // 无8位乘法 奇偶字节分别用16位乘法计算
+  static inline type mul(type a, type b) {
+    const __m512i even = _mm512_and_si512(_mm512_mullo_epi16(a, b), _mm512_set1_epi16(0x00FF));
+    const __m512i odd = _mm512_slli_epi16(_mm512_mullo_epi16(_mm512_srli_epi16(a, 8), _mm512_srli_epi16(b, 8)), 8);
+    return _mm512_or_si512(even, odd);
+  }
+  static inline type div(type a, type b) { return md::detail::int_div<uint8_t>(a, b); }
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  static inline __mmask64 mask(const size_t& remaining) {
+    return remaining < pack_size ? (1ull << remaining) - 1 : ~__mmask64(0);
+  }
+
+  // 8位掩码访存无对齐版本 统一使用非对齐指令
+  static inline type mask_load(const uint8_t* p, const size_t& remaining) {
+    return _mm512_maskz_loadu_epi8(mask(remaining), p);
+  }
+  static inline type mask_loadu(const uint8_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_store(uint8_t* p, const size_t& remaining, type v) {
+    _mm512_mask_storeu_epi8(p, mask(remaining), v);
+  }
+  static inline void mask_storeu(uint8_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(uint8_t val) { return _mm512_set1_epi8(static_cast<char>(val)); }
+
+  // 取负按256取模
+  static inline type min(type a, type b) { return _mm512_min_epu8(a, b); }
+  static inline type max(type a, type b) { return _mm512_max_epu8(a, b); }
+  static inline type abs(type a) { return a; }
+  static inline type neg(type a) { return _mm512_sub_epi8(_mm512_setzero_si512(), a); }
+
+  // 无8位移位 以16位移位后屏蔽跨字节的位
+  static inline type bit_and(type a, type b) { return _mm512_and_si512(a, b); }
+  static inline type bit_or(type a, type b) { return _mm512_or_si512(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm512_xor_si512(a, b); }
+  static inline type bit_not(type a) { return _mm512_xor_si512(a, _mm512_set1_epi8(-1)); }
+  static inline type shl(type a, int n) {
+    const __m512i keep = _mm512_set1_epi8(static_cast<char>(n < 8 ? 0xFF << n : 0));
+    return _mm512_and_si512(_mm512_sll_epi16(a, _mm_cvtsi32_si128(n)), keep);
+  }
+  static inline type shr(type a, int n) {
+    const __m512i keep = _mm512_set1_epi8(static_cast<char>(n < 8 ? 0xFF >> n : 0));
+    return _mm512_and_si512(_mm512_srl_epi16(a, _mm_cvtsi32_si128(n)), keep);
+  }
+
+  using mask_type = __mmask64;
+  static inline mask_type cmp_lt(type a, type b) { return _mm512_cmp_epu8_mask(a, b, _MM_CMPINT_LT); }
+  static inline mask_type cmp_le(type a, type b) { return _mm512_cmp_epu8_mask(a, b, _MM_CMPINT_LE); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm512_cmp_epu8_mask(a, b, _MM_CMPINT_EQ); }
+  static inline mask_type cmp_ne(type a, type b) { return _mm512_cmp_epu8_mask(a, b, _MM_CMPINT_NE); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return a & b; }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return a | b; }
+  static inline mask_type mask_not(mask_type a) { return ~a; }
+  static inline type select(mask_type m, type a, type b) { return _mm512_mask_blend_epi8(m, b, a); }
+};
+#endif  // __AVX512BW__
+
+
+// ======================== 16位浮点存储 ========================
+// 存储为16位 寄存器内扩展为simd<float>计算
+template <>
+struct simd_storage<md::half> {
+  static constexpr size_t pack_size = simd<float>::pack_size;
+  using type = simd<float>::type;
+
+  static inline type loadu(const md::half* p) {
+    return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+  }
+  static inline void storeu(md::half* p, type v) {
+    const __m256i h = _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), h);
+  }
+#if defined(__AVX512BW__) && defined(__AVX512VL__)
+  // 16位掩码访存
+  static inline type mask_loadu(const md::half* p, const size_t& remaining) {
+    return _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(simd<float>::mask(remaining), p));
+  }
+  static inline void mask_storeu(md::half* p, const size_t& remaining, type v) {
+    const __m256i h = _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm256_mask_storeu_epi16(p, simd<float>::mask(remaining), h);
+  }
+#else
+  static inline type mask_loadu(const md::half* p, const size_t& remaining) {
+    return md::detail::storage_partial_load<simd_storage>(p, remaining);
+  }
+  static inline void mask_storeu(md::half* p, const size_t& remaining, type v) {
+    md::detail::storage_partial_store<simd_storage>(p, remaining, v);
+  }
+#endif
+
+  static inline type load(const md::half* p) { return loadu(p); }
+  static inline void store(md::half* p, type v) { storeu(p, v); }
+  static inline type mask_load(const md::half* p, const size_t& remaining) { return mask_loadu(p, remaining); }
+  static inline void mask_store(md::half* p, const size_t& remaining, type v) { mask_storeu(p, remaining, v); }
+};
+
+// bfloat16为float的高16位 扩展为移位 收窄优先使用AVX512-BF16指令 否则整数运算就近舍入(偶数)
+template <>
+struct simd_storage<md::bfloat16> {
+  static constexpr size_t pack_size = simd<float>::pack_size;
+  using type = simd<float>::type;
+
+  static inline type widen(__m256i b) { return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(b), 16)); }
+  static inline __m256i narrow(type v) {
+#if defined(__AVX512BF16__)
+    // 指令将float非规格化输入按0处理
+    return (__m256i)_mm512_cvtneps_pbh(v);
+#else
+    const __m512i x = _mm512_castps_si512(v);
+    const __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(x, 16), _mm512_set1_epi32(1));
+    const __m512i r = _mm512_srli_epi32(_mm512_add_epi32(x, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7FFF))), 16);
+    const __m512i nan = _mm512_or_si512(_mm512_srli_epi32(x, 16), _mm512_set1_epi32(0x40));
+    return _mm512_cvtepi32_epi16(_mm512_mask_blend_epi32(_mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q), r, nan));
+#endif
+  }
+
+  static inline type loadu(const md::bfloat16* p) {
+    return widen(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+  }
+  static inline void storeu(md::bfloat16* p, type v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), narrow(v)); }
+#if defined(__AVX512BW__) && defined(__AVX512VL__)
+  static inline type mask_loadu(const md::bfloat16* p, const size_t& remaining) {
+    return widen(_mm256_maskz_loadu_epi16(simd<float>::mask(remaining), p));
+  }
+  static inline void mask_storeu(md::bfloat16* p, const size_t& remaining, type v) {
+    _mm256_mask_storeu_epi16(p, simd<float>::mask(remaining), narrow(v));
+  }
+#else
+  static inline type mask_loadu(const md::bfloat16* p, const size_t& remaining) {
+    return md::detail::storage_partial_load<simd_storage>(p, remaining);
+  }
+  static inline void mask_storeu(md::bfloat16* p, const size_t& remaining, type v) {
+    md::detail::storage_partial_store<simd_storage>(p, remaining, v);
+  }
+#endif
+
+  static inline type load(const md::bfloat16* p) { return loadu(p); }
+  static inline void store(md::bfloat16* p, type v) { storeu(p, v); }
+  static inline type mask_load(const md::bfloat16* p, const size_t& remaining) { return mask_loadu(p, remaining); }
+  static inline void mask_store(md::bfloat16* p, const size_t& remaining, type v) { mask_storeu(p, remaining, v); }
+};
+
+// ======================== 元素类型转换 ========================
+// float -> double 加载8个float扩展
+template <>
+struct simd_convert<float, double> {
+  static inline simd<double>::type loadu(const float* p) { return _mm512_cvtps_pd(_mm256_loadu_ps(p)); }
+  static inline simd<double>::type mask_loadu(const float* p, const size_t& remaining) {
+    return _mm512_cvtps_pd(_mm512_castps512_ps256(_mm512_maskz_loadu_ps(simd<float>::mask(remaining), p)));
+  }
+};
+
+// double -> float 两个__m512d收窄为一个__m512
+template <>
+struct simd_convert<double, float> {
+  static inline simd<float>::type narrow(simd<double>::type lo, simd<double>::type hi) {
+    const __m512d l = _mm512_castps_pd(_mm512_castps256_ps512(_mm512_cvtpd_ps(lo)));
+    return _mm512_castpd_ps(_mm512_insertf64x4(l, _mm256_castps_pd(_mm512_cvtpd_ps(hi)), 1));
+  }
+  static inline simd<float>::type loadu(const double* p) { return narrow(_mm512_loadu_pd(p), _mm512_loadu_pd(p + 8)); }
+  static inline simd<float>::type mask_loadu(const double* p, const size_t& remaining) {
+    return md::detail::narrow_mask_loadu<simd_convert>(p, remaining);
+  }
+};
+
+template <>
+struct simd_convert<int32_t, float> {
+  static inline simd<float>::type apply(simd<int32_t>::type v) { return _mm512_cvtepi32_ps(v); }
+  static inline simd<float>::type loadu(const int32_t* p) { return apply(simd<int32_t>::loadu(p)); }
+  static inline simd<float>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return apply(simd<int32_t>::mask_loadu(p, remaining));
+  }
+};
+
+// int16_t/uint8_t -> int64_t 窄整数以int64_t累加时的扩展加载 读取8个元素
+template <>
+struct simd_convert<int16_t, int64_t> : md::detail::convert_lanes<int16_t, int64_t> {
+  static inline simd<int64_t>::type loadu(const int16_t* p) {
+    return _mm512_cvtepi16_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+  }
+};
+
+template <>
+struct simd_convert<uint8_t, int64_t> : md::detail::convert_lanes<uint8_t, int64_t> {
+  static inline simd<int64_t>::type loadu(const uint8_t* p) {
+    return _mm512_cvtepu8_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+  }
+};
+
+// int32_t -> double/int64_t 加载8个int32_t扩展 结果精确 用于整数表达式的扩展转换与按更宽类型加载
+template <>
+struct simd_convert<int32_t, double> {
+  static inline simd<double>::type loadu(const int32_t* p) {
+    return _mm512_cvtepi32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+  }
+  static inline simd<double>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return _mm512_cvtepi32_pd(_mm512_castsi512_si256(simd<int32_t>::mask_loadu(p, remaining)));
+  }
+};
+
+template <>
+struct simd_convert<int32_t, int64_t> {
+  static inline simd<int64_t>::type loadu(const int32_t* p) {
+    return _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+  }
+  static inline simd<int64_t>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return _mm512_cvtepi32_epi64(_mm512_castsi512_si256(simd<int32_t>::mask_loadu(p, remaining)));
+  }
+};
+
+// 向零截断 与static_cast一致
+template <>
+struct simd_convert<float, int32_t> {
+  static inline simd<int32_t>::type apply(simd<float>::type v) { return _mm512_cvttps_epi32(v); }
+  static inline simd<int32_t>::type loadu(const float* p) { return apply(simd<float>::loadu(p)); }
+  static inline simd<int32_t>::type mask_loadu(const float* p, const size_t& remaining) {
+    return apply(simd<float>::mask_loadu(p, remaining));
+  }
 };
 #endif  // __X86_AVX512_H__
\ No newline at end of file
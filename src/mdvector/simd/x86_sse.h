@@ -1,11 +1,29 @@
 #ifndef __MDVECTOR_X86_SSE_H__
 #define __MDVECTOR_X86_SSE_H__
 
+#include <cstdint>
+
 #include "simd_base.h"
 
 // ======================== SSE ========================
 #include <emmintrin.h>  // SSE2
+#include <smmintrin.h>  // SSE4.1
 #include <xmmintrin.h>  // SSE
+#if defined(__FMA__)
+#include <immintrin.h>  // FMA
+#endif
+
+namespace md {
+namespace detail {
+
+// 非临时存储为弱序 写完后以sfence保证其先于之后的存储对其他线程可见
+inline void stream_fence() { _mm_sfence(); }
+
+// 逐元素求值主循环每次处理的pack数
+inline constexpr size_t unroll_factor = 4;
+
+}  // namespace detail
+}  // namespace md
 
 template <>
 struct simd<float> {
@@ -16,6 +34,7 @@ struct simd<float> {
   // 对齐操作
   static inline type load(const float* p) { return _mm_load_ps(p); }
   static inline void store(float* p, type v) { _mm_store_ps(p, v); }
+  static inline void stream(float* p, type v) { _mm_stream_ps(p, v); }
 
   // 非对齐操作
   static inline type loadu(const float* p) { return _mm_loadu_ps(p); }
@@ -27,6 +46,18 @@ struct simd<float> {
   static inline type mul(type a, type b) { return _mm_mul_ps(a, b); }
   static inline type div(type a, type b) { return _mm_div_ps(a, b); }
 
+  // 融合乘加 a * b + c / a * b - c / c - a * b
+#if defined(__FMA__)
+  static inline type fmadd(type a, type b, type c) { return _mm_fmadd_ps(a, b, c); }
+  static inline type fmsub(type a, type b, type c) { return _mm_fmsub_ps(a, b, c); }
+  static inline type fnmadd(type a, type b, type c) { return _mm_fnmadd_ps(a, b, c); }
+#else
+  // 无FMA指令 退化为乘法+加减法
+  static inline type fmadd(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return _mm_sub_ps(_mm_mul_ps(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+#endif
+
   // 对齐掩码操作（SSE没有原生支持，使用临时缓冲区）
   static inline type mask_load(const float* p, const size_t& remaining) {
     alignas(16) float tmp[4] = {0, 0, 0, 0};
@@ -52,6 +83,56 @@ struct simd<float> {
   }
 
   static inline type set1(float val) { return _mm_set1_ps(val); }
+
+  // 最值与取整
+  static inline type min(type a, type b) { return _mm_min_ps(a, b); }
+  static inline type max(type a, type b) { return _mm_max_ps(a, b); }
+  static inline type round(type a) { return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+  static inline type floor(type a) { return _mm_floor_ps(a); }
+  static inline type ceil(type a) { return _mm_ceil_ps(a); }
+
+  // 开方 绝对值 取负
+  static inline type sqrt(type a) { return _mm_sqrt_ps(a); }
+  // 近似倒数 相对误差 <= 1.5*2^-12 供快速除法牛顿迭代使用
+  static constexpr int rcp_bits = 12;
+  static inline type rcp(type a) { return _mm_rcp_ps(a); }
+  static inline type abs(type a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+  static inline type neg(type a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+
+  // 通道整体向高位移动K个 低K个通道取自fill 用于前缀扫描
+  template <int K>
+  static inline type shift_up(type v, type fill) {
+    return _mm_blend_ps(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4 * K)), fill, (1 << K) - 1);
+  }
+  static inline type broadcast_last(type v) { return _mm_shuffle_ps(v, v, 0xFF); }
+
+  // 比较与选择 掩码为全1通道
+  using mask_type = type;
+  static inline mask_type cmp_lt(type a, type b) { return _mm_cmplt_ps(a, b); }
+  static inline mask_type cmp_le(type a, type b) { return _mm_cmple_ps(a, b); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm_cmpeq_ps(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return _mm_cmpneq_ps(a, b); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm_and_ps(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm_or_ps(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+  static inline type select(mask_type m, type a, type b) { return _mm_blendv_ps(b, a, m); }
+
+  // 指数位操作 n为整数值 返回2^n
+  static inline type pow2n(type n) {
+    const type biased = _mm_add_ps(n, _mm_set1_ps(8388608.0f + 127.0f));
+    return _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(biased), 23));
+  }
+  // 正规正数的指数 floor(log2(x))
+  static inline type get_exp(type x) {
+    const __m128i e = _mm_srli_epi32(_mm_castps_si128(x), 23);
+    const type f = _mm_castsi128_ps(_mm_or_si128(e, _mm_set1_epi32(0x4B000000)));
+    return _mm_sub_ps(f, _mm_set1_ps(8388608.0f + 127.0f));
+  }
+  // 正规正数的尾数 [1, 2)
+  static inline type get_mant(type x) {
+    const __m128i m = _mm_and_si128(_mm_castps_si128(x), _mm_set1_epi32(0x007FFFFF));
+    return _mm_castsi128_ps(_mm_or_si128(m, _mm_set1_epi32(0x3F800000)));
+  }
 };
 
 template <>
@@ -63,6 +144,7 @@ struct simd<double> {
   // 对齐操作
   static inline type load(const double* p) { return _mm_load_pd(p); }
   static inline void store(double* p, type v) { _mm_store_pd(p, v); }
+  static inline void stream(double* p, type v) { _mm_stream_pd(p, v); }
 
   // 非对齐操作
   static inline type loadu(const double* p) { return _mm_loadu_pd(p); }
@@ -74,6 +156,18 @@ struct simd<double> {
   static inline type mul(type a, type b) { return _mm_mul_pd(a, b); }
   static inline type div(type a, type b) { return _mm_div_pd(a, b); }
 
+  // 融合乘加 a * b + c / a * b - c / c - a * b
+#if defined(__FMA__)
+  static inline type fmadd(type a, type b, type c) { return _mm_fmadd_pd(a, b, c); }
+  static inline type fmsub(type a, type b, type c) { return _mm_fmsub_pd(a, b, c); }
+  static inline type fnmadd(type a, type b, type c) { return _mm_fnmadd_pd(a, b, c); }
+#else
+  // 无FMA指令 退化为乘法+加减法
+  static inline type fmadd(type a, type b, type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return _mm_sub_pd(_mm_mul_pd(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return _mm_sub_pd(c, _mm_mul_pd(a, b)); }
+#endif
+
   // 对齐掩码操作
   static inline type mask_load(const double* p, const size_t& remaining) {
     alignas(16) double tmp[2] = {0, 0};
@@ -99,5 +193,492 @@ struct simd<double> {
   }
 
   static inline type set1(double val) { return _mm_set1_pd(val); }
+
+  // 最值与取整
+  static inline type min(type a, type b) { return _mm_min_pd(a, b); }
+  static inline type max(type a, type b) { return _mm_max_pd(a, b); }
+  static inline type round(type a) { return _mm_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+  static inline type floor(type a) { return _mm_floor_pd(a); }
+  static inline type ceil(type a) { return _mm_ceil_pd(a); }
+
+  // 开方 绝对值 取负
+  static inline type sqrt(type a) { return _mm_sqrt_pd(a); }
+  // 无double近似倒数指令 快速除法直接使用除法
+  static constexpr int rcp_bits = 53;
+  static inline type rcp(type a) { return _mm_div_pd(_mm_set1_pd(1.0), a); }
+  static inline type abs(type a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+  static inline type neg(type a) { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+
+  // 通道整体向高位移动K个 低K个通道取自fill 用于前缀扫描
+  template <int K>
+  static inline type shift_up(type v, type fill) {
+    return _mm_blend_pd(_mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(v), 8 * K)), fill, (1 << K) - 1);
+  }
+  static inline type broadcast_last(type v) { return _mm_unpackhi_pd(v, v); }
+
+  // 比较与选择 掩码为全1通道
+  using mask_type = type;
+  static inline mask_type cmp_lt(type a, type b) { return _mm_cmplt_pd(a, b); }
+  static inline mask_type cmp_le(type a, type b) { return _mm_cmple_pd(a, b); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm_cmpeq_pd(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return _mm_cmpneq_pd(a, b); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm_and_pd(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm_or_pd(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm_xor_pd(a, _mm_castsi128_pd(_mm_set1_epi64x(-1))); }
+  static inline type select(mask_type m, type a, type b) { return _mm_blendv_pd(b, a, m); }
+
+  // 指数位操作 n为整数值 返回2^n
+  static inline type pow2n(type n) {
+    const type biased = _mm_add_pd(n, _mm_set1_pd(4503599627370496.0 + 1023.0));
+    return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(biased), 52));
+  }
+  // 正规正数的指数 floor(log2(x))
+  static inline type get_exp(type x) {
+    const __m128i e = _mm_srli_epi64(_mm_castpd_si128(x), 52);
+    const type f = _mm_castsi128_pd(_mm_or_si128(e, _mm_set1_epi64x(0x4330000000000000)));
+    return _mm_sub_pd(f, _mm_set1_pd(4503599627370496.0 + 1023.0));
+  }
+  // 正规正数的尾数 [1, 2)
+  static inline type get_mant(type x) {
+    const __m128i m = _mm_and_si128(_mm_castpd_si128(x), _mm_set1_epi64x(0x000FFFFFFFFFFFFF));
+    return _mm_castsi128_pd(_mm_or_si128(m, _mm_set1_epi64x(0x3FF0000000000000)));
+  }
+};
+
+// ======================== SSE 整数 ========================
+// 整数类型共用__m128i 掩码访存使用缓冲区 除法逐通道回退
+// 无对应指令的运算(8位乘法与移位 64位乘法 比较与算术右移)由组合指令实现
+
+template <>
+struct simd<int32_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 4;
+  using type = __m128i;
+
+  // 对齐操作
+  static inline type load(const int32_t* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+  static inline void store(int32_t* p, type v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+  static inline void stream(int32_t* p, type v) { _mm_stream_si128(reinterpret_cast<__m128i*>(p), v); }
+
+  // 非对齐操作
+  static inline type loadu(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+  static inline void storeu(int32_t* p, type v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+  // 算术运算
+  static inline type add(type a, type b) { return _mm_add_epi32(a, b); }
+  static inline type sub(type a, type b) { return _mm_sub_epi32(a, b); }
+  static inline type mul(type a, type b) { return _mm_mullo_epi32(a, b); }
+  static inline type div(type a, type b) { return md::detail::int_div<int32_t>(a, b); }
+
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  // 掩码操作（SSE没有原生支持，使用临时缓冲区）
+  static inline type mask_load(const int32_t* p, const size_t& remaining) {
+    return md::detail::partial_load<int32_t, type>(p, remaining);
+  }
+  static inline void mask_store(int32_t* p, const size_t& remaining, type v) {
+    md::detail::partial_store(p, remaining, v);
+  }
+  static inline type mask_loadu(const int32_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int32_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int32_t val) { return _mm_set1_epi32(val); }
+
+  // 最值 绝对值 取负
+  static inline type min(type a, type b) { return _mm_min_epi32(a, b); }
+  static inline type max(type a, type b) { return _mm_max_epi32(a, b); }
+  static inline type abs(type a) { return _mm_abs_epi32(a); }
+  static inline type neg(type a) { return _mm_sub_epi32(_mm_setzero_si128(), a); }
+
+  // 位运算与移位
+  static inline type bit_and(type a, type b) { return _mm_and_si128(a, b); }
+  static inline type bit_or(type a, type b) { return _mm_or_si128(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm_xor_si128(a, b); }
+  static inline type bit_not(type a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+  static inline type shl(type a, int n) { return _mm_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+  static inline type shr(type a, int n) { return _mm_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+
+  // 比较与选择 掩码为全1通道
+  using mask_type = type;
+  static inline mask_type cmp_lt(type a, type b) { return _mm_cmplt_epi32(a, b); }
+  static inline mask_type cmp_le(type a, type b) { return mask_not(_mm_cmpgt_epi32(a, b)); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm_cmpeq_epi32(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(_mm_cmpeq_epi32(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm_and_si128(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm_or_si128(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+  static inline type select(mask_type m, type a, type b) { return _mm_blendv_epi8(b, a, m); }
+};
+
+template <>
+struct simd<int64_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 2;
+  using type = __m128i;
+
+  // 对齐操作
+  static inline type load(const int64_t* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+  static inline void store(int64_t* p, type v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+  static inline void stream(int64_t* p, type v) { _mm_stream_si128(reinterpret_cast<__m128i*>(p), v); }
+
+  // 非对齐操作
+  static inline type loadu(const int64_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+  static inline void storeu(int64_t* p, type v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+  // 算术运算
+  static inline type add(type a, type b) { return _mm_add_epi64(a, b); }
+  static inline type sub(type a, type b) { return _mm_sub_epi64(a, b); }
+  // 无64位乘法 由32位乘法拼出低64位
+  static inline type mul(type a, type b) {
+    const __m128i lo = _mm_mul_epu32(a, b);
+    const __m128i cross =
+        _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b), _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+    return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+  }
+  static inline type div(type a, type b) { return md::detail::int_div<int64_t>(a, b); }
+
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  // 掩码操作（SSE没有原生支持，使用临时缓冲区）
+  static inline type mask_load(const int64_t* p, const size_t& remaining) {
+    return md::detail::partial_load<int64_t, type>(p, remaining);
+  }
+  static inline void mask_store(int64_t* p, const size_t& remaining, type v) {
+    md::detail::partial_store(p, remaining, v);
+  }
+  static inline type mask_loadu(const int64_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int64_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int64_t val) { return _mm_set1_epi64x(val); }
+
+  // 最值 绝对值 取负
+  static inline type min(type a, type b) { return select(cmp_lt(a, b), a, b); }
+  static inline type max(type a, type b) { return select(cmp_lt(a, b), b, a); }
+  static inline type abs(type a) { return select(cmp_lt(a, _mm_setzero_si128()), neg(a), a); }
+  static inline type neg(type a) { return _mm_sub_epi64(_mm_setzero_si128(), a); }
+
+  // 位运算与移位 无64位算术右移 由逻辑右移后修正符号位
+  static inline type bit_and(type a, type b) { return _mm_and_si128(a, b); }
+  static inline type bit_or(type a, type b) { return _mm_or_si128(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm_xor_si128(a, b); }
+  static inline type bit_not(type a) { return _mm_xor_si128(a, _mm_set1_epi64x(-1)); }
+  static inline type shl(type a, int n) { return _mm_sll_epi64(a, _mm_cvtsi32_si128(n)); }
+  static inline type shr(type a, int n) {
+    const __m128i cnt = _mm_cvtsi32_si128(n);
+    const __m128i sign = _mm_srl_epi64(_mm_set1_epi64x(INT64_MIN), cnt);
+    return _mm_sub_epi64(_mm_xor_si128(_mm_srl_epi64(a, cnt), sign), sign);
+  }
+
+  // 比较与选择 掩码为全1通道
+  using mask_type = type;
+#if defined(__SSE4_2__)
+  static inline mask_type cmp_lt(type a, type b) { return _mm_cmpgt_epi64(b, a); }
+#else
+  // SSE4.1无64位有符号比较 a < b 即 (a - b) ^ ((a ^ b) & ((a - b) ^ a)) 为负 再将符号位扩展到整个通道
+  static inline mask_type cmp_lt(type a, type b) {
+    const __m128i d = _mm_sub_epi64(a, b);
+    const __m128i t = _mm_xor_si128(d, _mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(d, a)));
+    return _mm_shuffle_epi32(_mm_srai_epi32(t, 31), _MM_SHUFFLE(3, 3, 1, 1));
+  }
+#endif
+  static inline mask_type cmp_le(type a, type b) { return mask_not(cmp_lt(b, a)); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm_cmpeq_epi64(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(_mm_cmpeq_epi64(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm_and_si128(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm_or_si128(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm_xor_si128(a, _mm_set1_epi64x(-1)); }
+  static inline type select(mask_type m, type a, type b) { return _mm_blendv_epi8(b, a, m); }
+};
+
+template <>
+struct simd<int16_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 8;
+  using type = __m128i;
+
+  // 对齐操作
+  static inline type load(const int16_t* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+  static inline void store(int16_t* p, type v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+  static inline void stream(int16_t* p, type v) { _mm_stream_si128(reinterpret_cast<__m128i*>(p), v); }
+
+  // 非对齐操作
+  static inline type loadu(const int16_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+  static inline void storeu(int16_t* p, type v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+  // 算术运算
+  static inline type add(type a, type b) { return _mm_add_epi16(a, b); }
+  static inline type sub(type a, type b) { return _mm_sub_epi16(a, b); }
+  static inline type mul(type a, type b) { return _mm_mullo_epi16(a, b); }
+  static inline type div(type a, type b) { return md::detail::int_div<int16_t>(a, b); }
+
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  // 掩码操作（SSE没有原生支持，使用临时缓冲区）
+  static inline type mask_load(const int16_t* p, const size_t& remaining) {
+    return md::detail::partial_load<int16_t, type>(p, remaining);
+  }
+  static inline void mask_store(int16_t* p, const size_t& remaining, type v) {
+    md::detail::partial_store(p, remaining, v);
+  }
+  static inline type mask_loadu(const int16_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(int16_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(int16_t val) { return _mm_set1_epi16(val); }
+
+  // 最值 绝对值 取负
+  static inline type min(type a, type b) { return _mm_min_epi16(a, b); }
+  static inline type max(type a, type b) { return _mm_max_epi16(a, b); }
+  static inline type abs(type a) { return _mm_abs_epi16(a); }
+  static inline type neg(type a) { return _mm_sub_epi16(_mm_setzero_si128(), a); }
+
+  // 位运算与移位
+  static inline type bit_and(type a, type b) { return _mm_and_si128(a, b); }
+  static inline type bit_or(type a, type b) { return _mm_or_si128(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm_xor_si128(a, b); }
+  static inline type bit_not(type a) { return _mm_xor_si128(a, _mm_set1_epi16(-1)); }
+  static inline type shl(type a, int n) { return _mm_sll_epi16(a, _mm_cvtsi32_si128(n)); }
+  static inline type shr(type a, int n) { return _mm_sra_epi16(a, _mm_cvtsi32_si128(n)); }
+
+  // 比较与选择 掩码为全1通道
+  using mask_type = type;
+  static inline mask_type cmp_lt(type a, type b) { return _mm_cmplt_epi16(a, b); }
+  static inline mask_type cmp_le(type a, type b) { return mask_not(_mm_cmpgt_epi16(a, b)); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm_cmpeq_epi16(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(_mm_cmpeq_epi16(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm_and_si128(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm_or_si128(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm_xor_si128(a, _mm_set1_epi16(-1)); }
+  static inline type select(mask_type m, type a, type b) { return _mm_blendv_epi8(b, a, m); }
+};
+
+template <>
+struct simd<uint8_t> {
+  static constexpr size_t alignment = 16;
+  static constexpr size_t pack_size = 16;
+  using type = __m128i;
+
+  // 对齐操作
+  static inline type load(const uint8_t* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+  static inline void store(uint8_t* p, type v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+  static inline void stream(uint8_t* p, type v) { _mm_stream_si128(reinterpret_cast<__m128i*>(p), v); }
+
+  // 非对齐操作
+  static inline type loadu(const uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+  static inline void storeu(uint8_t* p, type v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+  // 算术运算 结果按256取模
+  static inline type add(type a, type b) { return _mm_add_epi8(a, b); }
+  static inline type sub(type a, type b) { return _mm_sub_epi8(a, b); }
+  // 无8位乘法 奇偶字节分别用16位乘法计算
+  static inline type mul(type a, type b) {
+    const __m128i even = _mm_and_si128(_mm_mullo_epi16(a, b), _mm_set1_epi16(0x00FF));
+    const __m128i odd = _mm_slli_epi16(_mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)), 8);
+    return _mm_or_si128(even, odd);
+  }
+  static inline type div(type a, type b) { return md::detail::int_div<uint8_t>(a, b); }
+
+  // 整数无融合乘加 拆为乘法与加减法
+  static inline type fmadd(type a, type b, type c) { return add(mul(a, b), c); }
+  static inline type fmsub(type a, type b, type c) { return sub(mul(a, b), c); }
+  static inline type fnmadd(type a, type b, type c) { return sub(c, mul(a, b)); }
+
+  // 掩码操作（SSE没有原生支持，使用临时缓冲区）
+  static inline type mask_load(const uint8_t* p, const size_t& remaining) {
+    return md::detail::partial_load<uint8_t, type>(p, remaining);
+  }
+  static inline void mask_store(uint8_t* p, const size_t& remaining, type v) {
+    md::detail::partial_store(p, remaining, v);
+  }
+  static inline type mask_loadu(const uint8_t* p, const size_t& remaining) { return mask_load(p, remaining); }
+  static inline void mask_storeu(uint8_t* p, const size_t& remaining, type v) { mask_store(p, remaining, v); }
+
+  static inline type set1(uint8_t val) { return _mm_set1_epi8(static_cast<char>(val)); }
+
+  // 最值 绝对值 取负(按256取模)
+  static inline type min(type a, type b) { return _mm_min_epu8(a, b); }
+  static inline type max(type a, type b) { return _mm_max_epu8(a, b); }
+  static inline type abs(type a) { return a; }
+  static inline type neg(type a) { return _mm_sub_epi8(_mm_setzero_si128(), a); }
+
+  // 位运算与移位 无8位移位 以16位移位后屏蔽跨字节的位
+  static inline type bit_and(type a, type b) { return _mm_and_si128(a, b); }
+  static inline type bit_or(type a, type b) { return _mm_or_si128(a, b); }
+  static inline type bit_xor(type a, type b) { return _mm_xor_si128(a, b); }
+  static inline type bit_not(type a) { return _mm_xor_si128(a, _mm_set1_epi8(-1)); }
+  static inline type shl(type a, int n) {
+    const __m128i keep = _mm_set1_epi8(static_cast<char>(n < 8 ? 0xFF << n : 0));
+    return _mm_and_si128(_mm_sll_epi16(a, _mm_cvtsi32_si128(n)), keep);
+  }
+  static inline type shr(type a, int n) {
+    const __m128i keep = _mm_set1_epi8(static_cast<char>(n < 8 ? 0xFF >> n : 0));
+    return _mm_and_si128(_mm_srl_epi16(a, _mm_cvtsi32_si128(n)), keep);
+  }
+
+  // 比较与选择 无符号比较由min与相等比较组合
+  using mask_type = type;
+  static inline mask_type cmp_lt(type a, type b) { return mask_not(cmp_le(b, a)); }
+  static inline mask_type cmp_le(type a, type b) { return _mm_cmpeq_epi8(_mm_min_epu8(a, b), a); }
+  static inline mask_type cmp_eq(type a, type b) { return _mm_cmpeq_epi8(a, b); }
+  static inline mask_type cmp_ne(type a, type b) { return mask_not(_mm_cmpeq_epi8(a, b)); }
+  static inline mask_type mask_and(mask_type a, mask_type b) { return _mm_and_si128(a, b); }
+  static inline mask_type mask_or(mask_type a, mask_type b) { return _mm_or_si128(a, b); }
+  static inline mask_type mask_not(mask_type a) { return _mm_xor_si128(a, _mm_set1_epi8(-1)); }
+  static inline type select(mask_type m, type a, type b) { return _mm_blendv_epi8(b, a, m); }
+};
+
+
+// ======================== 16位浮点存储 ========================
+// 存储为16位 寄存器内扩展为simd<float>计算 尾部经栈缓冲处理
+template <>
+struct simd_storage<md::half> {
+  static constexpr size_t pack_size = simd<float>::pack_size;
+  using type = simd<float>::type;
+
+#if defined(__F16C__)
+  static inline type loadu(const md::half* p) {
+    return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+  }
+  static inline void storeu(md::half* p, type v) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+#else
+  // 无F16C 逐元素转换
+  static inline type loadu(const md::half* p) { return md::detail::widen_lanes<simd<float>>(p); }
+  static inline void storeu(md::half* p, type v) { md::detail::narrow_lanes<simd<float>>(p, v); }
+#endif
+
+  static inline type load(const md::half* p) { return loadu(p); }
+  static inline void store(md::half* p, type v) { storeu(p, v); }
+  static inline type mask_load(const md::half* p, const size_t& remaining) { return mask_loadu(p, remaining); }
+  static inline void mask_store(md::half* p, const size_t& remaining, type v) { mask_storeu(p, remaining, v); }
+  static inline type mask_loadu(const md::half* p, const size_t& remaining) {
+    return md::detail::storage_partial_load<simd_storage>(p, remaining);
+  }
+  static inline void mask_storeu(md::half* p, const size_t& remaining, type v) {
+    md::detail::storage_partial_store<simd_storage>(p, remaining, v);
+  }
+};
+
+// bfloat16为float的高16位 扩展为移位 收窄按就近舍入(偶数) NaN保持为静默NaN
+template <>
+struct simd_storage<md::bfloat16> {
+  static constexpr size_t pack_size = simd<float>::pack_size;
+  using type = simd<float>::type;
+
+  static inline type loadu(const md::bfloat16* p) {
+    const __m128i x = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+    return _mm_castsi128_ps(_mm_slli_epi32(x, 16));
+  }
+  static inline void storeu(md::bfloat16* p, type v) {
+    const __m128i x = _mm_castps_si128(v);
+    const __m128i lsb = _mm_and_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(1));
+    __m128i r = _mm_srli_epi32(_mm_add_epi32(x, _mm_add_epi32(lsb, _mm_set1_epi32(0x7FFF))), 16);
+    const __m128i nan = _mm_or_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(0x40));
+    r = _mm_blendv_epi8(r, nan, _mm_castps_si128(_mm_cmpunord_ps(v, v)));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packus_epi32(r, r));
+  }
+
+  static inline type load(const md::bfloat16* p) { return loadu(p); }
+  static inline void store(md::bfloat16* p, type v) { storeu(p, v); }
+  static inline type mask_load(const md::bfloat16* p, const size_t& remaining) { return mask_loadu(p, remaining); }
+  static inline void mask_store(md::bfloat16* p, const size_t& remaining, type v) { mask_storeu(p, remaining, v); }
+  static inline type mask_loadu(const md::bfloat16* p, const size_t& remaining) {
+    return md::detail::storage_partial_load<simd_storage>(p, remaining);
+  }
+  static inline void mask_storeu(md::bfloat16* p, const size_t& remaining, type v) {
+    md::detail::storage_partial_store<simd_storage>(p, remaining, v);
+  }
+};
+
+// ======================== 元素类型转换 ========================
+// float -> double 加载2个float扩展
+template <>
+struct simd_convert<float, double> {
+  static inline simd<double>::type loadu(const float* p) {
+    return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+  }
+  static inline simd<double>::type mask_loadu(const float* p, const size_t& remaining) {
+    return remaining == 0 ? _mm_setzero_pd() : _mm_cvtps_pd(_mm_load_ss(p));
+  }
+};
+
+// double -> float 两个__m128d收窄为一个__m128
+template <>
+struct simd_convert<double, float> {
+  static inline simd<float>::type narrow(simd<double>::type lo, simd<double>::type hi) {
+    return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+  }
+  static inline simd<float>::type loadu(const double* p) { return narrow(_mm_loadu_pd(p), _mm_loadu_pd(p + 2)); }
+  static inline simd<float>::type mask_loadu(const double* p, const size_t& remaining) {
+    return md::detail::narrow_mask_loadu<simd_convert>(p, remaining);
+  }
+};
+
+template <>
+struct simd_convert<int32_t, float> {
+  static inline simd<float>::type apply(simd<int32_t>::type v) { return _mm_cvtepi32_ps(v); }
+  static inline simd<float>::type loadu(const int32_t* p) { return apply(simd<int32_t>::loadu(p)); }
+  static inline simd<float>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return apply(simd<int32_t>::mask_loadu(p, remaining));
+  }
+};
+
+// int16_t/uint8_t -> int64_t 窄整数以int64_t累加时的扩展加载 读取2个元素
+template <>
+struct simd_convert<int16_t, int64_t> : md::detail::convert_lanes<int16_t, int64_t> {
+  static inline simd<int64_t>::type loadu(const int16_t* p) {
+    int32_t bytes;
+    std::memcpy(&bytes, p, sizeof(bytes));
+    return _mm_cvtepi16_epi64(_mm_cvtsi32_si128(bytes));
+  }
+};
+
+template <>
+struct simd_convert<uint8_t, int64_t> : md::detail::convert_lanes<uint8_t, int64_t> {
+  static inline simd<int64_t>::type loadu(const uint8_t* p) {
+    uint16_t bytes;
+    std::memcpy(&bytes, p, sizeof(bytes));
+    return _mm_cvtepu8_epi64(_mm_cvtsi32_si128(bytes));
+  }
+};
+
+// int32_t -> double/int64_t 加载2个int32_t扩展 结果精确 用于整数表达式的扩展转换与按更宽类型加载
+template <>
+struct simd_convert<int32_t, double> {
+  static inline simd<double>::type loadu(const int32_t* p) {
+    return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+  }
+  static inline simd<double>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return _mm_cvtepi32_pd(simd<int32_t>::mask_loadu(p, remaining));
+  }
+};
+
+template <>
+struct simd_convert<int32_t, int64_t> {
+  static inline simd<int64_t>::type loadu(const int32_t* p) {
+    return _mm_cvtepi32_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+  }
+  static inline simd<int64_t>::type mask_loadu(const int32_t* p, const size_t& remaining) {
+    return _mm_cvtepi32_epi64(simd<int32_t>::mask_loadu(p, remaining));
+  }
+};
+
+// 向零截断 与static_cast一致
+template <>
+struct simd_convert<float, int32_t> {
+  static inline simd<int32_t>::type apply(simd<float>::type v) { return _mm_cvttps_epi32(v); }
+  static inline simd<int32_t>::type loadu(const float* p) { return apply(simd<float>::loadu(p)); }
+  static inline simd<int32_t>::type mask_loadu(const float* p, const size_t& remaining) {
+    return apply(simd<float>::mask_loadu(p, remaining));
+  }
 };
 #endif  // __X86_SSE_H__
\ No newline at end of file
@@ -13,7 +13,7 @@ template <std::size_t Rank>
 auto compute_strides(const std::array<std::size_t, Rank>& extents) {
   std::array<std::size_t, Rank> strides;
   strides.back() = 1;
-  for (int i = Rank - 2; i >= 0; --i) {
+  for (int i = static_cast<int>(Rank) - 2; i >= 0; --i) {
     strides[i] = strides[i + 1] * extents[i + 1];
   }
   return strides;
@@ -13,6 +13,8 @@ class subspan : public mdspan<T, Rank, Layout>, public TensorExpr<subspan<T, Ran
   using Policy = UnalignedPolicy;
 
  public:
+  using value_type = T;
+
   // 默认构造函数
   constexpr subspan() noexcept = default;
 
@@ -56,8 +58,13 @@ class subspan : public mdspan<T, Rank, Layout>, public TensorExpr<subspan<T, Ran
 
   // ---------- 赋值运算符 ----------
   // 拷贝赋值：将右侧数据复制到当前视图（不修改指针和大小）
+  // 同一数组中部分重叠的两个视图 目标在后时反向复制
   subspan& operator=(const subspan& other) {
-    std::copy(other.begin(), other.end(), this->data_);  // 逐元素复制
+    if (alias_of(other) == md::detail::alias_kind::behind) {
+      std::copy_backward(other.begin(), other.end(), this->data_ + other.size());
+    } else {
+      std::copy(other.begin(), other.end(), this->data_);  // 逐元素复制
+    }
     return *this;
   }
 
@@ -69,6 +76,9 @@ class subspan : public mdspan<T, Rank, Layout>, public TensorExpr<subspan<T, Ran
 
   size_t size() const { return this->size_; }
 
+  // 基类mdspan与TensorExpr均有extents() 取mdspan的形状
+  using mdspan<T, Rank, Layout>::extents;
+
   // ====================== 迭代器 ============================
 
   // 显式定义迭代器类型别名（符合 STL 惯例）
@@ -84,7 +94,7 @@ class subspan : public mdspan<T, Rank, Layout>, public TensorExpr<subspan<T, Ran
 
   // const 重载（读写，但返回 const_iterator）
   const_iterator begin() const noexcept { return this->data_; }
-  const_iterator end() const noexcept { return this->data_ + this->data_; }
+  const_iterator end() const noexcept { return this->data_ + this->size_; }
 
   // 常量迭代器（只读，C++11 风格）
   const_iterator cbegin() const noexcept { return this->data_; }
@@ -127,50 +137,84 @@ class subspan : public mdspan<T, Rank, Layout>, public TensorExpr<subspan<T, Ran
 
   // =================== 表达式模板 ============================
   // 不允许表达式构造
-  template <typename E>
-  subspan(const TensorExpr<E, Policy>& expr) = delete;
-
-  // 表达式赋值
-  template <typename E>
-  subspan& operator=(const TensorExpr<E, Policy>& expr) {
-    expr.eval_to(this->data());  // 直接计算到目标内存
+  template <typename E, class P>
+  subspan(const TensorExpr<E, P>& expr) = delete;
+
+  // 表达式赋值 表达式可含对齐的mdvector操作数 写回按非对齐存储
+  // 操作数与自身不相交或为同一视图时直接计算到目标内存 部分重叠(如 row(1) = row(0) + row(1) 的错位视图)时反向求值或经临时缓冲区
+  template <typename E, class P>
+  subspan& operator=(const TensorExpr<E, P>& expr) {
+    expr.template assign_to<Policy>(this->data());
     return *this;
   }
 
-  // 取值
+  // 取值 T2为计算类型 与元素类型不同时加载后转换
   template <typename T2>
   typename simd<T2>::type eval_simd(size_t i) const {
-    return simd<T2>::loadu(this->data() + i);
+    return Policy::template load<T, T2>(this->data() + i);
   }
 
   // 取值
   template <typename T2>
   typename simd<T2>::type eval_simd_mask(size_t i) const {
-    return simd<T2>::mask_loadu(this->data() + i, this->size() - i);
+    return Policy::template mask_load<T, T2>(this->data() + i, this->size() - i);
+  }
+
+  md::detail::alias_kind alias(const md::detail::mem_range& dest) const {
+    return md::detail::range_alias(this->data(), this->size(), dest);
   }
 
+  void prepare() const {}
+
   // ========================================================
   // b ?= a
+  // 两个视图部分重叠时不满足simd_?_inplace的__restrict约定 形状不同时需广播 均按表达式赋值处理
   subspan& operator+=(const subspan& other) {
+    if (!restrict_safe(other) || other.extents() != extents()) return compound_assign(*this + other);
     simd_add_inplace<T, Policy>(this->data(), other.data(), this->size());
     return *this;
   }
 
   subspan& operator-=(const subspan& other) {
+    if (!restrict_safe(other) || other.extents() != extents()) return compound_assign(*this - other);
     simd_sub_inplace<T, Policy>(this->data(), other.data(), this->size());
     return *this;
   }
 
   subspan& operator*=(const subspan& other) {
+    if (!restrict_safe(other) || other.extents() != extents()) return compound_assign(*this * other);
     simd_mul_inplace<T, Policy>(this->data(), other.data(), this->size());
     return *this;
   }
 
   subspan& operator/=(const subspan& other) {
+    if (!restrict_safe(other) || other.extents() != extents()) return compound_assign(*this / other);
     simd_div_inplace<T, Policy>(this->data(), other.data(), this->size());
     return *this;
   }
 
+  // 表达式复合赋值 b ?= expr 即 b = b ? expr 单次遍历读-改-写 不生成中间数组
+  // 如 a += b * c 为每个pack一次fmadd 低秩表达式按广播规则扩展到b的形状
+  template <class E, class P>
+  subspan& operator+=(const TensorExpr<E, P>& expr) {
+    return compound_assign(*this + expr.derived());
+  }
+
+  template <class E, class P>
+  subspan& operator-=(const TensorExpr<E, P>& expr) {
+    return compound_assign(*this - expr.derived());
+  }
+
+  template <class E, class P>
+  subspan& operator*=(const TensorExpr<E, P>& expr) {
+    return compound_assign(*this * expr.derived());
+  }
+
+  template <class E, class P>
+  subspan& operator/=(const TensorExpr<E, P>& expr) {
+    return compound_assign(*this / expr.derived());
+  }
+
   // ========================================================
 
   // 标量操作
@@ -201,9 +245,52 @@ class subspan : public mdspan<T, Rank, Layout>, public TensorExpr<subspan<T, Ran
     return *this;
   }
 
+  // 整数数组与浮点标量 按浮点计算后转换写回(同int x; x *= 0.5) 标量不先截断为整数
+  template <class U, typename = std::enable_if_t<std::is_integral_v<T> && std::is_floating_point_v<U>>>
+  subspan& operator+=(U scalar) {
+    return compound_assign(*this + scalar);
+  }
+
+  template <class U, typename = std::enable_if_t<std::is_integral_v<T> && std::is_floating_point_v<U>>>
+  subspan& operator-=(U scalar) {
+    return compound_assign(*this - scalar);
+  }
+
+  template <class U, typename = std::enable_if_t<std::is_integral_v<T> && std::is_floating_point_v<U>>>
+  subspan& operator*=(U scalar) {
+    return compound_assign(*this * scalar);
+  }
+
+  template <class U, typename = std::enable_if_t<std::is_integral_v<T> && std::is_floating_point_v<U>>>
+  subspan& operator/=(U scalar) {
+    return compound_assign(*this / scalar);
+  }
+
   // ====================== 标量运算 ============================
 
  private:
+  // 复合赋值的结果表达式逐元素写回自身 形状须与自身相同(操作数可广播到自身 自身不随操作数扩展)
+  template <class E>
+  subspan& compound_assign(const E& expr) {
+    static_assert(md::detail::expr_rank_v<E> == Rank,
+                  "compound assignment cannot broadcast the target to a higher rank");
+    if (expr.extents() != extents()) {
+      throw std::invalid_argument("compound assignment cannot broadcast the target to a larger shape");
+    }
+    expr.template assign_to<Policy>(this->data());
+    return *this;
+  }
+
+  md::detail::alias_kind alias_of(const subspan& other) const {
+    return other.alias(md::detail::make_mem_range(this->data(), this->size()));
+  }
+
+  // 不相交或为同一视图
+  bool restrict_safe(const subspan& other) const {
+    const auto kind = alias_of(other);
+    return kind == md::detail::alias_kind::none || kind == md::detail::alias_kind::same;
+  }
+
   void check_slice_bounds(const std::array<md::slice, Rank>& slices, const std::array<std::size_t, Rank>& extents) {
     for (size_t i = 0; i < Rank; ++i) {
       if (slices[i].is_all) {
@@ -0,0 +1,141 @@
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+// 与标量结果逐元素比较 返回不一致个数
+template <class R, class F>
+size_t mismatch(const R& r, F f) {
+  size_t count = 0;
+  for (size_t k = 0; k < r.size(); ++k) {
+    if (r.cbegin()[k] != f(k)) ++count;
+  }
+  return count;
+}
+
+// 与simd<T>::fmadd一致 有FMA指令时单次舍入 SSE无FMA时为乘法加法
+double madd(double x, double y, double z) {
+#if defined(__FMA__) || defined(__ARM_NEON) || defined(__riscv)
+  return std::fma(x, y, z);
+#else
+  volatile double p = x * y;
+  return p + z;
+#endif
+}
+
+int main(int args, char* argv[]) {
+  // 3 * 37 非pack_size整数倍 覆盖尾部掩码
+  constexpr size_t M = 3;
+  constexpr size_t N = 37;
+  mdvector_2d<double> u({M, N});
+  mdvector_2d<double> v({M, N});
+  mdvector_2d<double> f({M, N});
+  for (size_t k = 0; k < u.size(); ++k) {
+    u.begin()[k] = static_cast<double>(k);
+    v.begin()[k] = 2.0 * static_cast<double>(k) + 1.0;
+    f.begin()[k] = 1.0 / (1.0 + static_cast<double>(k));
+  }
+  std::vector<double> u0(u.cbegin(), u.cend());
+  std::vector<double> v0(v.cbegin(), v.cend());
+  auto fk = [&](size_t k) { return f.cbegin()[k]; };
+  const double dt = 0.1;
+
+  // 两个输出共用f 单次遍历
+  mdvector_2d<double> u1({M, N});
+  mdvector_2d<double> v1({M, N});
+  md::assign(md::tie(u1, v1), u + dt * f, v - dt * f);
+  std::cout << "assign(tie(u1, v1), u + dt * f, v - dt * f) mismatches: expected 0 0\n"
+            << mismatch(u1, [&](size_t k) { return madd(dt, fk(k), u0[k]); }) << " "
+            << mismatch(v1, [&](size_t k) { return v0[k] - dt * fk(k); }) << "\n";
+
+  // 三个输出 含数学函数
+  mdvector_2d<double> w1({M, N});
+  md::assign(md::tie(u1, v1, w1), md::sqrt(u), md::max(u, v * 0.5), f * f);
+  std::cout << "assign three outputs mismatches: expected 0 0 0\n"
+            << mismatch(u1, [&](size_t k) { return std::sqrt(u0[k]); }) << " "
+            << mismatch(v1, [&](size_t k) { return std::max(u0[k], v0[k] * 0.5); }) << " "
+            << mismatch(w1, [&](size_t k) { return fk(k) * fk(k); }) << "\n";
+
+  // 同一下标先求值后写回 交换u与v
+  md::assign(md::tie(u, v), v, u);
+  std::cout << "assign(tie(u, v), v, u) swaps mismatches: expected 0 0\n"
+            << mismatch(u, [&](size_t k) { return v0[k]; }) << " " << mismatch(v, [&](size_t k) { return u0[k]; })
+            << "\n";
+
+  // 目标为subspan 与mdvector混合
+  mdvector_3d<double> field({2, 5, N});
+  for (size_t k = 0; k < field.size(); ++k) field.begin()[k] = static_cast<double>(k);
+  auto lo = field.create_subspan(0, all(), all());
+  auto hi = field.create_subspan(1, all(), all());
+  mdvector_2d<double> sum_plane({5, N});
+  md::assign(md::tie(lo, hi, sum_plane), hi - lo, hi + lo, lo * hi);
+  const double offset = 5.0 * N;
+  std::cout << "assign subspan targets mismatches: expected 0 0 0\n"
+            << mismatch(lo, [&](size_t) { return offset; }) << " "
+            << mismatch(hi, [&](size_t k) { return 2.0 * static_cast<double>(k) + offset; }) << " "
+            << mismatch(sum_plane, [&](size_t k) { return static_cast<double>(k) * (static_cast<double>(k) + offset); })
+            << "\n";
+
+  // 目标为float 表达式为double 按目标类型转换
+  mdvector_2d<float> a({M, N});
+  mdvector_2d<float> b({M, N});
+  md::assign(md::tie(a, b), f * 3.0, md::cast<float>(f) + 1.0f);
+  std::cout << "assign float targets from double expr mismatches: expected 0 0\n"
+            << mismatch(a, [&](size_t k) { return static_cast<float>(fk(k) * 3.0); }) << " "
+            << mismatch(b, [&](size_t k) { return static_cast<float>(fk(k)) + 1.0f; }) << "\n";
+
+  // 元素个数不一致
+  mdvector_2d<double> small({M, N - 1});
+  try {
+    md::assign(md::tie(u1, small), u, v);
+    std::cout << "assign size mismatch: expected runtime_error\nno exception\n";
+  } catch (const std::runtime_error&) {
+    std::cout << "assign size mismatch: expected runtime_error\nruntime_error\n";
+  }
+
+  // 元素个数相同 形状不同
+  mdvector_2d<double> transposed({N, M});
+  try {
+    md::assign(md::tie(u1, v1), u, transposed);
+    std::cout << "assign shape mismatch: expected runtime_error\nno exception\n";
+  } catch (const std::runtime_error&) {
+    std::cout << "assign shape mismatch: expected runtime_error\nruntime_error\n";
+  }
+
+  // 操作数在目标之前 反向求值 两个表达式均读取赋值前的值
+  mdvector_2d<double> rows({4, N});
+  for (size_t k = 0; k < rows.size(); ++k) rows.begin()[k] = static_cast<double>(k);
+  auto below = rows.create_subspan(md::slice(1, 3), all());
+  mdvector_2d<double> copy({3, N});
+  md::assign(md::tie(below, copy), rows.create_subspan(md::slice(0, 2), all()) + 1.0,
+             rows.create_subspan(md::slice(0, 2), all()));
+  std::cout << "assign rows[1:3] = rows[0:2] + 1 mismatches: expected 0 0\n"
+            << mismatch(below, [&](size_t k) { return static_cast<double>(k) + 1.0; }) << " "
+            << mismatch(copy, [&](size_t k) { return static_cast<double>(k); }) << "\n";
+
+  // 操作数在目标之后 正向求值
+  for (size_t k = 0; k < rows.size(); ++k) rows.begin()[k] = static_cast<double>(k);
+  auto above = rows.create_subspan(md::slice(0, 2), all());
+  md::assign(md::tie(above), rows.create_subspan(md::slice(1, 3), all()) * 2.0);
+  std::cout << "assign rows[0:2] = rows[1:3] * 2 mismatches: expected 0\n"
+            << mismatch(above, [&](size_t k) { return 2.0 * static_cast<double>(k + N); }) << "\n";
+
+  // 一个目标需反向求值 另一个需正向求值 经临时缓冲区
+  mdvector_2d<double> shift({4, N});
+  for (size_t k = 0; k < rows.size(); ++k) {
+    rows.begin()[k] = static_cast<double>(k);
+    shift.begin()[k] = -static_cast<double>(k);
+  }
+  auto shift_up = shift.create_subspan(md::slice(0, 2), all());
+  md::assign(md::tie(below, shift_up), rows.create_subspan(md::slice(0, 2), all()),
+             shift.create_subspan(md::slice(1, 3), all()));
+  std::cout << "assign opposite overlaps mismatches: expected 0 0\n"
+            << mismatch(below, [&](size_t k) { return static_cast<double>(k); }) << " "
+            << mismatch(shift_up, [&](size_t k) { return -static_cast<double>(k + N); }) << "\n";
+
+  return 0;
+}
@@ -82,6 +82,23 @@ int main(int args, char *argv[]) {
   dat_temp.show_data_matrix_style();
   std::cout << "dat_temp(1,1):" << dat_temp(1, 1) << "\n";
 
+  // 融合乘加 编译期识别为fmadd/fmsub/fnmadd
+  dat_temp = dat1 * dat2 + dat3;
+  std::cout << "\na * b + c dat_temp: 0.32\n";
+  dat_temp.show_data_matrix_style();
+
+  dat_temp = dat3 + dat1 * dat2;
+  std::cout << "\nc + a * b dat_temp: 0.32\n";
+  dat_temp.show_data_matrix_style();
+
+  dat_temp = dat1 * dat2 - dat3;
+  std::cout << "\na * b - c dat_temp: -0.28\n";
+  dat_temp.show_data_matrix_style();
+
+  dat_temp = dat3 - dat1 * dat2;
+  std::cout << "\nc - a * b dat_temp: 0.28\n";
+  dat_temp.show_data_matrix_style();
+
   // dat1.MinusEqual(dat2_error);  // 维度不同 会抛出异常
 
   // 显示数据内容
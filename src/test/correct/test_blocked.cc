@@ -0,0 +1,162 @@
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+// 与标量结果逐元素比较 返回不一致个数
+template <class R, class F>
+size_t mismatch(const R& r, F f) {
+  size_t count = 0;
+  for (size_t k = 0; k < r.size(); ++k) {
+    if (r.cbegin()[k] != f(k)) ++count;
+  }
+  return count;
+}
+
+// 乘积先舍入 防止参考值被编译器收缩为fma
+double mul(double x, double y) {
+  volatile double p = x * y;
+  return p;
+}
+
+// 与simd<T>::fmadd一致 有FMA指令时单次舍入 SSE无FMA时为乘法加法
+double madd(double x, double y, double z) {
+#if defined(__FMA__) || defined(__ARM_NEON) || defined(__riscv)
+  return std::fma(x, y, z);
+#else
+  return mul(x, y) + z;
+#endif
+}
+
+int main(int args, char* argv[]) {
+  // 50 * 333 非64整数倍 最后一块不足块长 且不足一个pack
+  constexpr size_t M = 50;
+  constexpr size_t N = 333;
+  mdvector_2d<double> a({M, N});
+  mdvector_2d<double> b({M, N});
+  mdvector_2d<double> c({M, N});
+  mdvector_2d<double> d({M, N});
+  for (size_t k = 0; k < a.size(); ++k) {
+    a.begin()[k] = 0.01 * static_cast<double>(k) - 30.0;
+    b.begin()[k] = 1.0 / (1.0 + static_cast<double>(k));
+    c.begin()[k] = static_cast<double>(k % 7);
+    d.begin()[k] = static_cast<double>(k % 3) + 0.5;
+  }
+  auto ak = [&](size_t k) { return a.cbegin()[k]; };
+  auto bk = [&](size_t k) { return b.cbegin()[k]; };
+  auto ck = [&](size_t k) { return c.cbegin()[k]; };
+  auto dk = [&](size_t k) { return d.cbegin()[k]; };
+  auto uk = [&](size_t k) { return mul(ak(k), bk(k)) + ck(k); };
+
+  // t只在块内使用 u, v写回
+  md::scratch<double, 2> t({M, N});
+  mdvector_2d<double> u({M, N});
+  mdvector_2d<double> v({M, N});
+  auto step = md::blocked(md::stmt(t, a * b), md::stmt(u, t + c), md::stmt(v, u * u - d));
+  for (size_t tile : {1, 64, 100, 4096, 100000}) {
+    u.set_value(0.0);
+    v.set_value(0.0);
+    step.eval(tile);
+    std::cout << "blocked t = a * b; u = t + c; v = u * u - d (tile " << tile << ") mismatches: expected 0 0\n"
+              << mismatch(u, uk) << " " << mismatch(v, [&](size_t k) { return madd(uk(k), uk(k), -dk(k)); })
+              << "\n";
+  }
+
+  // 记录一次 每个时间步重复eval 目标同时出现在表达式中
+  mdvector_2d<double> w({M, N});
+  w.set_value(1.0);
+  auto relax = md::blocked(md::stmt(t, w * 0.5), md::stmt(w, t + b));
+  std::vector<double> ref(w.size(), 1.0);
+  for (int s = 0; s < 3; ++s) {
+    relax.eval(256);
+    for (size_t k = 0; k < ref.size(); ++k) ref[k] = ref[k] * 0.5 + bk(k);
+  }
+  std::cout << "3 steps of t = w * 0.5; w = t + b mismatches: expected 0\n"
+            << mismatch(w, [&](size_t k) { return ref[k]; }) << "\n";
+
+  // 目标为subspan 块内中间量为float 表达式为double 按目标类型转换
+  mdvector_3d<double> field({2, M, N});
+  auto plane = field.create_subspan(1, all(), all());
+  md::scratch<float, 2> h({M, N});
+  md::blocked(md::stmt(h, a - b), md::stmt(plane, md::abs(h) * 2.0f)).eval();
+  std::cout << "subspan = |float scratch| * 2 mismatches: expected 0\n"
+            << mismatch(plane, [&](size_t k) {
+                 return static_cast<double>(std::fabs(static_cast<float>(ak(k) - bk(k))) * 2.0f);
+               })
+            << "\n";
+
+  // 广播操作数不是前面语句的目标时可参与
+  mdvector_1d<double> row({N});
+  for (size_t j = 0; j < N; ++j) row(j) = static_cast<double>(j);
+  md::blocked(md::stmt(t, a + row), md::stmt(u, t * 0.25)).eval(128);
+  std::cout << "t = a + row; u = t * 0.25 mismatches: expected 0\n"
+            << mismatch(u, [&](size_t k) { return (ak(k) + static_cast<double>(k % N)) * 0.25; }) << "\n";
+
+  // 元素个数不一致
+  mdvector_2d<double> small({M, N - 1});
+  try {
+    md::blocked(md::stmt(u, a + b), md::stmt(small, md::sqrt(small))).eval();
+    std::cout << "blocked size mismatch: expected runtime_error\nno exception\n";
+  } catch (const std::runtime_error&) {
+    std::cout << "blocked size mismatch: expected runtime_error\nruntime_error\n";
+  }
+
+  // 块内中间量被广播 需读取整个数组
+  md::scratch<double, 1> t_row({N});
+  try {
+    md::blocked(md::stmt(u, a + t_row)).eval();
+    std::cout << "broadcast scratch: expected runtime_error\nno exception\n";
+  } catch (const std::runtime_error&) {
+    std::cout << "broadcast scratch: expected runtime_error\nruntime_error\n";
+  }
+
+  // 块内中间量在md::blocked之外按完整数组读取
+  try {
+    u = t * 2.0;
+    std::cout << "scratch read outside blocked: expected runtime_error\nno exception\n";
+  } catch (const std::runtime_error&) {
+    std::cout << "scratch read outside blocked: expected runtime_error\nruntime_error\n";
+  }
+
+  // 读取自身目标之后的高位下标 逐块执行时读取的仍是旧值
+  mdvector_2d<double> rows({4, N});
+  for (size_t k = 0; k < rows.size(); ++k) rows.begin()[k] = static_cast<double>(k);
+  auto upper = rows.create_subspan(md::slice(0, 2), all());
+  md::blocked(md::stmt(upper, rows.create_subspan(md::slice(1, 3), all()) * 2.0)).eval(64);
+  std::cout << "rows[0:2] = rows[1:3] * 2 mismatches: expected 0\n"
+            << mismatch(upper, [&](size_t k) { return 2.0 * static_cast<double>(k + N); }) << "\n";
+
+  // 读取自身目标之前的低位下标 逐块执行时会读到已写回的新值
+  auto lower = rows.create_subspan(md::slice(1, 3), all());
+  try {
+    md::blocked(md::stmt(lower, rows.create_subspan(md::slice(0, 2), all()) + 1.0)).eval(64);
+    std::cout << "rows[1:3] = rows[0:2] + 1: expected runtime_error\nno exception\n";
+  } catch (const std::runtime_error&) {
+    std::cout << "rows[1:3] = rows[0:2] + 1: expected runtime_error\nruntime_error\n";
+  }
+
+  // 读取前面语句目标中尚未写出的高位下标
+  mdvector_2d<double> next({3, N});
+  try {
+    md::blocked(md::stmt(upper, next * 0.5), md::stmt(next, rows.create_subspan(md::slice(1, 3), all()))).eval(64);
+    std::cout << "read later rows of an earlier target: expected runtime_error\nno exception\n";
+  } catch (const std::runtime_error&) {
+    std::cout << "read later rows of an earlier target: expected runtime_error\nruntime_error\n";
+  }
+
+  // 广播前面语句目标的一行 广播缓冲区在序列开始前生成 会读到旧值
+  mdvector_2d<double> plane2({M, N});
+  plane2.set_value(1.0);
+  try {
+    md::blocked(md::stmt(plane2, plane2 * 2.0), md::stmt(v, plane2.create_subspan(0, all()) + c)).eval();
+    std::cout << "broadcast row of an earlier target: expected runtime_error\nno exception\n";
+  } catch (const std::runtime_error&) {
+    std::cout << "broadcast row of an earlier target: expected runtime_error\nruntime_error\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+// 与标量结果逐元素比较 返回不一致个数
+template <class R, class F>
+size_t mismatch(const R& r, F f) {
+  size_t count = 0;
+  for (size_t k = 0; k < r.size(); ++k) {
+    if (r.cbegin()[k] != f(k)) ++count;
+  }
+  return count;
+}
+
+// 整数元素 行长3小于pack_size 每个pack跨多行 经缓冲区拼接出整个pack
+template <class T>
+void test_int(const char* name) {
+  mdvector_3d<T> a({2, 13, 3});
+  mdvector_3d<T> b({1, 1, 3});
+  mdvector_1d<T> row({37});
+  for (size_t k = 0; k < a.size(); ++k) a.begin()[k] = static_cast<T>(k % 50);
+  for (size_t j = 0; j < 3; ++j) b(0, 0, j) = static_cast<T>(j + 1);
+  for (size_t j = 0; j < row.size(); ++j) row(j) = static_cast<T>(j % 5);
+  auto ak = [&](size_t k) { return a.cbegin()[k]; };
+
+  mdvector_3d<T> r = a + b;
+  std::cout << name << " (2, 13, 3) + (1, 1, 3) mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return static_cast<T>(ak(k) + b.cbegin()[k % 3]); }) << "\n";
+
+  r = a * md::broadcast_to(b, a.extents());
+  std::cout << name << " a * broadcast_to(b) mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return static_cast<T>(ak(k) * b.cbegin()[k % 3]); }) << "\n";
+
+  mdvector_2d<T> m({3, 37});
+  for (size_t k = 0; k < m.size(); ++k) m.begin()[k] = static_cast<T>(k % 11);
+  mdvector_2d<T> p = m - row;
+  std::cout << name << " (3, 37) - (37) mismatches: expected 0\n"
+            << mismatch(p, [&](size_t k) { return static_cast<T>(m.cbegin()[k] - row(k % 37)); }) << "\n";
+}
+
+int main(int args, char* argv[]) {
+  std::cout << "pack_size float " << simd<float>::pack_size << " double " << simd<double>::pack_size << "\n";
+
+  // 行长37 非pack_size整数倍 覆盖跨行pack与尾部掩码
+  const size_t M = 3, N = 37;
+  mdvector_2d<float> m({M, N});
+  mdvector_1d<float> row({N});
+  mdvector_2d<float> col({M, 1});
+  for (size_t k = 0; k < m.size(); ++k) m.begin()[k] = 0.5f * static_cast<float>(k) - 7.0f;
+  for (size_t j = 0; j < N; ++j) row(j) = 100.0f + static_cast<float>(j);
+  for (size_t i = 0; i < M; ++i) col(i, 0) = -1000.0f * static_cast<float>(i + 1);
+  auto mk = [&](size_t k) { return m.cbegin()[k]; };
+
+  // 缺失维 (M, N) + (N)
+  mdvector_2d<float> r = m + row;
+  std::cout << "(3, 37) + (37) shape: expected 3 37\n" << r.extents()[0] << " " << r.extents()[1] << "\n";
+  std::cout << "m + row mismatches: expected 0\n" << mismatch(r, [&](size_t k) { return mk(k) + row(k % N); })
+            << "\n";
+
+  // 低秩在左侧
+  r = row - m;
+  std::cout << "row - m mismatches: expected 0\n" << mismatch(r, [&](size_t k) { return row(k % N) - mk(k); })
+            << "\n";
+
+  // 长度为1的维 (M, N) * (M, 1) 行内为set1
+  r = m * md::broadcast_to(col, m.extents());
+  std::cout << "m * broadcast_to(col) mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return mk(k) * col(k / N, 0); }) << "\n";
+
+  // 广播操作数为表达式 并参与融合乘加与函数
+  r = m * (row * 2.0f) + 1.0f;
+  std::cout << "m * (row * 2) + 1 mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return std::fma(mk(k), row(k % N) * 2.0f, 1.0f); }) << "\n";
+
+  r = md::abs(m - row);
+  std::cout << "abs(m - row) mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return std::fabs(mk(k) - row(k % N)); }) << "\n";
+
+  // 三维 (D, H, W) 与二维 (H, W) 合并为一行 H*W
+  const size_t D = 4, H = 5, W = 37;
+  mdvector_3d<double> field({D, H, W});
+  mdvector_2d<double> slab({H, W});
+  mdvector_3d<double> mid({D, 1, W});
+  for (size_t k = 0; k < field.size(); ++k) field.begin()[k] = std::sin(static_cast<double>(k));
+  for (size_t k = 0; k < slab.size(); ++k) slab.begin()[k] = 1.0 + 0.01 * static_cast<double>(k);
+  for (size_t k = 0; k < mid.size(); ++k) mid.begin()[k] = static_cast<double>(k);
+  auto fk = [&](size_t k) { return field.cbegin()[k]; };
+
+  mdvector_3d<double> g = field * slab;
+  std::cout << "(4, 5, 37) * (5, 37) mismatches: expected 0\n"
+            << mismatch(g, [&](size_t k) { return fk(k) * slab.cbegin()[k % (H * W)]; }) << "\n";
+
+  // 中间维广播 (D, 1, W)
+  g = field - md::broadcast_to(mid, field.extents());
+  std::cout << "(4, 5, 37) - (4, 1, 37) mismatches: expected 0\n"
+            << mismatch(g, [&](size_t k) { return fk(k) - mid.cbegin()[k / (H * W) * W + k % W]; }) << "\n";
+
+  // 行长小于pack_size 每个pack跨多行
+  mdvector_2d<double> small({7, 3});
+  mdvector_1d<double> v3({3});
+  for (size_t k = 0; k < small.size(); ++k) small.begin()[k] = static_cast<double>(k);
+  v3(0) = 10;
+  v3(1) = 20;
+  v3(2) = 30;
+  mdvector_2d<double> s = small + v3;
+  std::cout << "(7, 3) + (3):\nexpected 10 21 32 / 13 24 35 / ... / 28 39 50\n";
+  s.show_data_matrix_style();
+
+  // 混合精度与整数
+  mdvector_1d<double> rowd({N});
+  for (size_t j = 0; j < N; ++j) rowd(j) = 0.25 * static_cast<double>(j);
+  mdvector_2d<double> rd = m + rowd;
+  std::cout << "float (3, 37) + double (37) mismatches: expected 0\n"
+            << mismatch(rd, [&](size_t k) { return static_cast<double>(mk(k)) + rowd(k % N); }) << "\n";
+
+  mdvector_2d<int32_t> im({M, N});
+  mdvector_1d<int32_t> irow({N});
+  for (size_t k = 0; k < im.size(); ++k) im.begin()[k] = static_cast<int32_t>(k);
+  for (size_t j = 0; j < N; ++j) irow(j) = static_cast<int32_t>(j) * 1000;
+  mdvector_2d<int32_t> ir = im * 2 + irow;
+  std::cout << "int32 (3, 37) * 2 + (37) mismatches: expected 0\n"
+            << mismatch(ir, [&](size_t k) { return static_cast<int32_t>(k) * 2 + static_cast<int32_t>(k % N) * 1000; })
+            << "\n";
+
+  // 子视图 UnalignedPolicy
+  auto plane = field.create_subspan(1, all(), all());
+  auto src = mid.create_subspan(2, all(), all());
+  plane = md::broadcast_to(src, plane.shapes()) * 2.0;
+  std::cout << "field plane 1 = broadcast_to(mid plane 2) * 2 mismatches: expected 0\n"
+            << mismatch(plane, [&](size_t k) { return mid(2, 0, k % W) * 2.0; }) << "\n";
+
+  // 同秩长度为1的维自动广播 (M, N) + (M, 1)
+  r = m + col;
+  std::cout << "(3, 37) + (3, 1) mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return mk(k) + col(k / N, 0); }) << "\n";
+
+  // 两侧均广播 (M, 1) * (1, N) 外积 乘法因子各自广播后与(M, N)融合乘加
+  mdvector_2d<float> row2({1, N});
+  for (size_t j = 0; j < N; ++j) row2(0, j) = 0.5f + static_cast<float>(j);
+  mdvector_2d<float> outer = col * row2;
+  std::cout << "(3, 1) * (1, 37) shape: expected 3 37\n" << outer.extents()[0] << " " << outer.extents()[1] << "\n";
+  std::cout << "(3, 1) * (1, 37) mismatches: expected 0\n"
+            << mismatch(outer, [&](size_t k) { return col(k / N, 0) * row2(0, k % N); }) << "\n";
+  r = col * row2 + m;
+  std::cout << "(3, 1) * (1, 37) + (3, 37) mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return std::fma(col(k / N, 0), row2(0, k % N), mk(k)); }) << "\n";
+
+  // 比较 二元函数 位运算同样广播
+  r = md::where(m > col * 0.001f, m, 0.0f);
+  std::cout << "where(m > (3, 1) * 0.001, m, 0) mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return mk(k) > col(k / N, 0) * 0.001f ? mk(k) : 0.0f; }) << "\n";
+  r = md::max(m, row2) + md::min(col, m);
+  std::cout << "max(m, (1, 37)) + min((3, 1), m) mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) {
+                 return std::max(mk(k), row2(0, k % N)) + std::min(col(k / N, 0), mk(k));
+               })
+            << "\n";
+
+  r = md::where(m > 0.0f, row2, col) + md::clamp(m, col, row2);
+  std::cout << "where(m > 0, (1, 37), (3, 1)) + clamp(m, (3, 1), (1, 37)) mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) {
+                 const float lo = col(k / N, 0), hi = row2(0, k % N);
+                 return (mk(k) > 0.0f ? hi : lo) + std::min(std::max(mk(k), lo), hi);
+               })
+            << "\n";
+
+  // 复合赋值 操作数广播到自身形状
+  mdvector_2d<float> acc = m;
+  acc += col;
+  acc *= row2;
+  std::cout << "m += (3, 1); m *= (1, 37) mismatches: expected 0\n"
+            << mismatch(acc, [&](size_t k) { return (mk(k) + col(k / N, 0)) * row2(0, k % N); }) << "\n";
+
+  // 存储的广播表达式 每次求值前刷新操作数缓冲区 构造时不计算
+  auto stored = m * (row * 2.0f) + row;
+  row(0) = -3.0f;
+  r = stored;
+  std::cout << "stored m * (row * 2) + row after row(0) = -3 mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return std::fma(mk(k), row(k % N) * 2.0f, row(k % N)); }) << "\n";
+  small(6, 2) = 100.0;
+  v3(2) = 0.5;
+  auto stored_small = small + v3 * 2.0;
+  v3(1) = -1.0;
+  s = stored_small;
+  std::cout << "stored (7, 3) + (3) * 2 after v3(1) = -1: expected 20 -1 3 / 101\n"
+            << s(0, 0) << " " << s(0, 1) << " " << s(0, 2) << " / " << s(6, 2) << "\n";
+
+  // 形状不兼容
+  mdvector_1d<float> bad({N - 1});
+  try {
+    r = m + bad;
+    std::cout << "(3, 37) + (36): expected invalid_argument\nno exception\n";
+  } catch (const std::invalid_argument&) {
+    std::cout << "(3, 37) + (36): expected invalid_argument\ninvalid_argument\n";
+  }
+
+  // 同秩形状不兼容
+  mdvector_2d<float> bad2({M, N - 1});
+  try {
+    r = m + bad2;
+    std::cout << "(3, 37) + (3, 36): expected invalid_argument\nno exception\n";
+  } catch (const std::invalid_argument&) {
+    std::cout << "(3, 37) + (3, 36): expected invalid_argument\ninvalid_argument\n";
+  }
+
+  // 目标不随操作数扩展
+  mdvector_2d<float> col_acc = col;
+  try {
+    col_acc += m;
+    std::cout << "(3, 1) += (3, 37): expected invalid_argument\nno exception\n";
+  } catch (const std::invalid_argument&) {
+    std::cout << "(3, 1) += (3, 37): expected invalid_argument\ninvalid_argument\n";
+  }
+
+  // 掩码不广播
+  try {
+    r = md::where(col > 0.0f, m, 0.0f);
+    std::cout << "where((3, 1) > 0, (3, 37), 0): expected invalid_argument\nno exception\n";
+  } catch (const std::invalid_argument&) {
+    std::cout << "where((3, 1) > 0, (3, 37), 0): expected invalid_argument\ninvalid_argument\n";
+  }
+
+  test_int<int32_t>("int32_t");
+  test_int<int64_t>("int64_t");
+  test_int<int16_t>("int16_t");
+  test_int<uint8_t>("uint8_t");
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+// 与标量结果逐元素比较 返回不一致个数
+template <class R, class F>
+size_t mismatch(const R& r, F f) {
+  size_t count = 0;
+  for (size_t k = 0; k < r.size(); ++k) {
+    if (r.cbegin()[k] != f(k)) ++count;
+  }
+  return count;
+}
+
+int main(int args, char* argv[]) {
+  std::cout << "pack_size float " << simd<float>::pack_size << " double " << simd<double>::pack_size << "\n";
+
+  // 3 * 37 非pack_size整数倍 覆盖尾部掩码
+  mdvector_2d<float> f({3, 37});
+  mdvector_2d<double> d({3, 37});
+  for (size_t k = 0; k < f.size(); ++k) {
+    f.begin()[k] = 0.1f * static_cast<float>(k) - 3.0f;
+    d.begin()[k] = 1.0 / (1.0 + static_cast<double>(k));
+  }
+  auto fk = [&](size_t k) { return static_cast<double>(f.cbegin()[k]); };
+  auto dk = [&](size_t k) { return d.cbegin()[k]; };
+
+  // 混合运算提升为double
+  mdvector_2d<double> r = (f + d) * f;
+  std::cout << "double r = (f + d) * f mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return (fk(k) + dk(k)) * fk(k); }) << "\n";
+
+  r = d - f;
+  std::cout << "double r = d - f mismatches: expected 0\n" << mismatch(r, [&](size_t k) { return dk(k) - fk(k); })
+            << "\n";
+
+  // 按double计算后收窄写入float
+  mdvector_2d<float> rf = f / d;
+  std::cout << "float r = f / d mismatches: expected 0\n"
+            << mismatch(rf, [&](size_t k) { return static_cast<float>(fk(k) / dk(k)); }) << "\n";
+
+  // 整体扩展/收窄
+  mdvector_2d<double> w = f;
+  std::cout << "double w = f mismatches: expected 0\n" << mismatch(w, fk) << "\n";
+
+  rf = md::cast<float>(d * 3.0);
+  std::cout << "cast<float>(d * 3) mismatches: expected 0\n"
+            << mismatch(rf, [&](size_t k) { return static_cast<float>(dk(k) * 3.0); }) << "\n";
+
+  // 同宽度转换 向零截断
+  mdvector_2d<int32_t> n = md::cast<int32_t>(f * 10.0f);
+  std::cout << "cast<int32_t>(f * 10) mismatches: expected 0\n"
+            << mismatch(n, [&](size_t k) { return static_cast<int32_t>(f.cbegin()[k] * 10.0f); }) << "\n";
+
+  rf = md::cast<float>(n) * 0.5f;
+  std::cout << "cast<float>(n) * 0.5 mismatches: expected 0\n"
+            << mismatch(rf, [&](size_t k) { return static_cast<float>(n.cbegin()[k]) * 0.5f; }) << "\n";
+
+  // 整数扩展: 叶节点加载时转换 整数表达式按int32_t运算(含回绕与整数除法)后转换
+  auto nk = [&](size_t k) { return n.cbegin()[k]; };
+  mdvector_2d<double> wn = n;
+  std::cout << "double wn = n mismatches: expected 0\n"
+            << mismatch(wn, [&](size_t k) { return static_cast<double>(nk(k)); }) << "\n";
+
+  wn = md::cast<double>(n * 50000000 + n / 3);
+  std::cout << "cast<double>(n * 50000000 + n / 3) mismatches: expected 0\n"
+            << mismatch(wn, [&](size_t k) {
+                 const auto wrapped = static_cast<int32_t>(static_cast<uint32_t>(nk(k)) * 50000000u);
+                 return static_cast<double>(static_cast<int32_t>(static_cast<uint32_t>(wrapped) + nk(k) / 3));
+               })
+            << "\n";
+
+  mdvector_2d<int64_t> wl = n * 7 / 2;
+  std::cout << "int64_t wl = n * 7 / 2 mismatches: expected 0\n"
+            << mismatch(wl, [&](size_t k) { return static_cast<int64_t>(nk(k) * 7 / 2); }) << "\n";
+
+  auto nrow = n.create_subspan(1, all());
+  mdvector_2d<double> wr = md::cast<double>(nrow - 1) * 0.25;
+  std::cout << "cast<double>(n row 1 - 1) * 0.25 mismatches: expected 0\n"
+            << mismatch(wr, [&](size_t k) { return static_cast<double>(nk(37 + k) - 1) * 0.25; }) << "\n";
+
+  // 归约按提升后的类型累加
+  double s = 0.0;
+  double p = 0.0;
+  for (size_t k = 0; k < f.size(); ++k) {
+    s += fk(k);
+    p += fk(k) * dk(k);
+  }
+  std::cout << "sum(cast<double>(f)): expected " << s << "\n" << md::sum(md::cast<double>(f)) << "\n";
+  std::cout << "dot(f, d): expected " << p << "\n" << md::dot(f, d) << "\n";
+  std::cout << "sum(cast<float>(d)) is float: expected 1\n"
+            << std::is_same_v<decltype(md::sum(md::cast<float>(d))), float> << "\n";
+
+  // 子视图 UnalignedPolicy
+  auto frow = f.create_subspan(1, all());
+  auto drow = d.create_subspan(2, all());
+  drow = frow * 2.0f + drow;
+  std::cout << "row 2 = f row 1 * 2 + d row 2 mismatches: expected 0\n";
+  size_t bad = 0;
+  for (size_t j = 0; j < 37; ++j) {
+    // f * 2 无舍入 与是否融合乘加无关
+    const double v = static_cast<double>(f(1, j)) * 2.0 + 1.0 / (1.0 + static_cast<double>(74 + j));
+    if (d(2, j) != v) ++bad;
+  }
+  std::cout << bad << "\n";
+
+  return 0;
+}
@@ -0,0 +1,148 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+// 与标量结果逐元素比较 返回不一致个数
+template <class R, class F>
+size_t mismatch(const R& r, F f) {
+  size_t count = 0;
+  for (size_t k = 0; k < r.size(); ++k) {
+    if (r.cbegin()[k] != f(k)) ++count;
+  }
+  return count;
+}
+
+// 与simd<T>::fmadd一致 有FMA指令时单次舍入 SSE无FMA时为乘法加法
+double madd(double x, double y, double z) {
+#if defined(__FMA__) || defined(__ARM_NEON) || defined(__riscv)
+  return std::fma(x, y, z);
+#else
+  volatile double p = x * y;
+  return p + z;
+#endif
+}
+
+int main(int args, char* argv[]) {
+  // 3 * 37 非pack_size整数倍 覆盖尾部掩码
+  constexpr size_t M = 3;
+  constexpr size_t N = 37;
+  mdvector_2d<double> a({M, N});
+  mdvector_2d<double> b({M, N});
+  mdvector_2d<double> c({M, N});
+  for (size_t k = 0; k < a.size(); ++k) {
+    b.begin()[k] = 0.5 * static_cast<double>(k) - 20.0;
+    c.begin()[k] = 1.0 / (1.0 + static_cast<double>(k));
+  }
+  auto bk = [&](size_t k) { return b.cbegin()[k]; };
+  auto ck = [&](size_t k) { return c.cbegin()[k]; };
+
+  // a += b * c 每个pack一次fmadd
+  std::vector<double> ref(a.size());
+  for (size_t k = 0; k < a.size(); ++k) ref[k] = a.begin()[k] = static_cast<double>(k % 5);
+  a += b * c;
+  std::cout << "a += b * c mismatches: expected 0\n"
+            << mismatch(a, [&](size_t k) { return madd(bk(k), ck(k), ref[k]); }) << "\n";
+
+  for (size_t k = 0; k < a.size(); ++k) ref[k] = a.cbegin()[k];
+  a -= md::sqrt(md::abs(b)) + 1.0;
+  std::cout << "a -= sqrt(|b|) + 1 mismatches: expected 0\n"
+            << mismatch(a, [&](size_t k) { return ref[k] - (std::sqrt(std::fabs(bk(k))) + 1.0); }) << "\n";
+
+  for (size_t k = 0; k < a.size(); ++k) ref[k] = a.cbegin()[k];
+  a *= md::where(b > 0.0, c, -c);
+  std::cout << "a *= where(b > 0, c, -c) mismatches: expected 0\n"
+            << mismatch(a, [&](size_t k) { return ref[k] * (bk(k) > 0.0 ? ck(k) : -ck(k)); }) << "\n";
+
+  for (size_t k = 0; k < a.size(); ++k) ref[k] = a.cbegin()[k];
+  a /= c + 2.0;
+  std::cout << "a /= c + 2 mismatches: expected 0\n"
+            << mismatch(a, [&](size_t k) { return ref[k] / (ck(k) + 2.0); }) << "\n";
+
+  // 自身出现在表达式中 逐元素读-改-写
+  for (size_t k = 0; k < a.size(); ++k) ref[k] = a.cbegin()[k];
+  a += a * 0.5;
+  std::cout << "a += a * 0.5 mismatches: expected 0\n"
+            << mismatch(a, [&](size_t k) { return madd(ref[k], 0.5, ref[k]); }) << "\n";
+
+  // 低秩表达式广播 (3, 37) += (37)
+  mdvector_1d<double> row({N});
+  for (size_t j = 0; j < N; ++j) row(j) = static_cast<double>(j);
+  for (size_t k = 0; k < a.size(); ++k) ref[k] = a.cbegin()[k];
+  a += row * 2.0;
+  std::cout << "(3, 37) += (37) * 2 mismatches: expected 0\n"
+            << mismatch(a, [&](size_t k) { return ref[k] + static_cast<double>(k % N) * 2.0; }) << "\n";
+
+  // 混合精度 float目标按double计算后收窄
+  mdvector_2d<float> f({M, N});
+  for (size_t k = 0; k < f.size(); ++k) f.begin()[k] = 0.1f * static_cast<float>(k);
+  std::vector<float> fref(f.cbegin(), f.cend());
+  f *= b - c;
+  std::cout << "float *= double expr mismatches: expected 0\n"
+            << mismatch(f, [&](size_t k) { return static_cast<float>(fref[k] * (bk(k) - ck(k))); }) << "\n";
+
+  // 整数
+  mdvector_2d<int32_t> n({M, N});
+  mdvector_2d<int32_t> m({M, N});
+  for (size_t k = 0; k < n.size(); ++k) {
+    n.begin()[k] = static_cast<int32_t>(k);
+    m.begin()[k] = static_cast<int32_t>(k % 4) + 1;
+  }
+  n += m * 3 - 1;
+  n /= m + 1;
+  std::cout << "int32 (n += m * 3 - 1) /= m + 1 mismatches: expected 0\n"
+            << mismatch(n, [&](size_t k) {
+                 const int32_t mv = static_cast<int32_t>(k % 4) + 1;
+                 return (static_cast<int32_t>(k) + mv * 3 - 1) / (mv + 1);
+               })
+            << "\n";
+
+  // 子视图 UnalignedPolicy
+  mdvector_3d<double> field({4, 5, N});
+  for (size_t k = 0; k < field.size(); ++k) field.begin()[k] = static_cast<double>(k);
+  auto plane = field.create_subspan(2, all(), all());
+  auto other = field.create_subspan(1, all(), all());
+  plane += other * 2.0 - 1.0;
+  const size_t base = 2 * 5 * N;
+  const size_t prev = 1 * 5 * N;
+  std::cout << "plane 2 += plane 1 * 2 - 1 mismatches: expected 0\n"
+            << mismatch(plane, [&](size_t k) {
+                 return static_cast<double>(base + k) + madd(static_cast<double>(prev + k), 2.0, -1.0);
+               })
+            << "\n";
+
+  plane /= md::max(other, 1.0);
+  std::cout << "plane 2 /= max(plane 1, 1) mismatches: expected 0\n"
+            << mismatch(plane, [&](size_t k) {
+                 const double p1 = static_cast<double>(prev + k);
+                 return (static_cast<double>(base + k) + madd(p1, 2.0, -1.0)) / std::max(p1, 1.0);
+               })
+            << "\n";
+
+  // 长度1~100 覆盖展开主循环 逐pack循环与尾部掩码的各种组合
+  size_t bad_kernel = 0;
+  size_t bad_expr = 0;
+  for (size_t n = 1; n <= 100; ++n) {
+    mdvector_1d<float> x({n});
+    mdvector_1d<float> y({n});
+    for (size_t k = 0; k < n; ++k) {
+      x(k) = static_cast<float>(k);
+      y(k) = static_cast<float>(k % 5) + 1.0f;
+    }
+    mdvector_1d<float> z = x - y * 0.5f;
+    x += y;
+    x *= 2.0f;
+    for (size_t k = 0; k < n; ++k) {
+      if (x(k) != (static_cast<float>(k) + y(k)) * 2.0f) ++bad_kernel;
+      if (z(k) != static_cast<float>(k) - y(k) * 0.5f) ++bad_expr;
+    }
+  }
+  std::cout << "lengths 1..100 (x + y) * 2, x - y * 0.5 mismatches: expected 0 0\n"
+            << bad_kernel << " " << bad_expr << "\n";
+
+  return 0;
+}
@@ -0,0 +1,374 @@
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "src/mdvector/mdvector.h"
+
+// 相对long double参考值的ULP误差
+template <class T>
+double ulp_error(T val, long double ref) {
+  if (std::isnan(ref)) return std::isnan(val) ? 0.0 : std::numeric_limits<double>::infinity();
+  if (std::isinf(ref)) return val == ref ? 0.0 : std::numeric_limits<double>::infinity();
+  const T r = static_cast<T>(ref);
+  const T ulp = std::nextafter(std::fabs(r), std::numeric_limits<T>::infinity()) - std::fabs(r);
+  return static_cast<double>(std::fabs(static_cast<long double>(val) - ref) / ulp);
+}
+
+// 在[lo, hi]上均匀取点 统计最大ULP误差
+template <class T, class Expr, class Ref>
+void check_unary(const char* name, T lo, T hi, Expr expr, Ref ref) {
+  const size_t n = 100003;  // 非pack_size整数倍 覆盖尾部掩码
+  mdvector_1d<T> x({n});
+  for (size_t i = 0; i < n; ++i) {
+    x(i) = lo + (hi - lo) * static_cast<T>(i) / static_cast<T>(n - 1);
+  }
+  mdvector_1d<T> y = expr(x);
+
+  double max_err = 0;
+  for (size_t i = 0; i < n; ++i) {
+    max_err = std::max(max_err, ulp_error<T>(y(i), ref(static_cast<long double>(x(i)))));
+  }
+  std::cout << name << " [" << lo << ", " << hi << "] max ulp error: " << max_err << "\n";
+}
+
+// 快速档 统计最大相对误差
+template <class T, class Expr, class Ref>
+void check_relative(const char* name, T lo, T hi, Expr expr, Ref ref) {
+  const size_t n = 100003;
+  mdvector_1d<T> x({n});
+  for (size_t i = 0; i < n; ++i) {
+    x(i) = lo + (hi - lo) * static_cast<T>(i) / static_cast<T>(n - 1);
+  }
+  mdvector_1d<T> y = expr(x);
+
+  long double max_err = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const long double r = ref(static_cast<long double>(x(i)));
+    if (r != 0) max_err = std::max(max_err, std::fabs((static_cast<long double>(y(i)) - r) / r));
+  }
+  std::cout << name << " [" << lo << ", " << hi << "] max relative error: " << static_cast<double>(max_err) << "\n";
+}
+
+template <class T>
+void test_accuracy() {
+  check_unary<T>(
+      "exp", T(-80), T(80), [](const auto& x) { return md::exp(x); }, [](long double v) { return std::exp(v); });
+  check_unary<T>(
+      "exp", T(-700), T(700), [](const auto& x) { return md::exp(x); }, [](long double v) { return std::exp(v); });
+  check_unary<T>(
+      "log", T(1e-30), T(1e30), [](const auto& x) { return md::log(x); }, [](long double v) { return std::log(v); });
+  check_unary<T>(
+      "log", T(0.5), T(2), [](const auto& x) { return md::log(x); }, [](long double v) { return std::log(v); });
+  check_unary<T>(
+      "sin", T(-100), T(100), [](const auto& x) { return md::sin(x); }, [](long double v) { return std::sin(v); });
+  check_unary<T>(
+      "sin", T(-8192), T(8192), [](const auto& x) { return md::sin(x); }, [](long double v) { return std::sin(v); });
+  check_unary<T>(
+      "cos", T(-100), T(100), [](const auto& x) { return md::cos(x); }, [](long double v) { return std::cos(v); });
+  check_unary<T>(
+      "tan", T(-10), T(10), [](const auto& x) { return md::tan(x); }, [](long double v) { return std::tan(v); });
+  check_unary<T>(
+      "atan2(x, 1.5)", T(-100), T(100), [](const auto& x) { return md::atan2(x, T(1.5)); },
+      [](long double v) { return std::atan2(v, 1.5L); });
+  check_unary<T>(
+      "atan2(-1.5, x)", T(-100), T(100), [](const auto& x) { return md::atan2(T(-1.5), x); },
+      [](long double v) { return std::atan2(-1.5L, v); });
+  check_unary<T>(
+      "pow(x, 2.5)", T(0), T(100), [](const auto& x) { return md::pow(x, T(2.5)); },
+      [](long double v) { return std::pow(v, 2.5L); });
+  check_unary<T>(
+      "pow(x, 3)", T(-10), T(10), [](const auto& x) { return md::pow(x, T(3)); },
+      [](long double v) { return std::pow(v, 3.0L); });
+  check_unary<T>(
+      "pow(x, -2)", T(0.01), T(100), [](const auto& x) { return md::pow(x, T(-2)); },
+      [](long double v) { return std::pow(v, -2.0L); });
+  check_unary<T>(
+      "pow(x, -0.5)", T(1e-3), T(1e3), [](const auto& x) { return md::pow(x, T(-0.5)); },
+      [](long double v) { return 1.0L / std::sqrt(v); });
+  check_unary<T>(
+      "pow<3>(x)", T(-10), T(10), [](const auto& x) { return md::pow<3>(x); },
+      [](long double v) { return v * v * v; });
+  check_unary<T>(
+      "pow<7>(x)", T(-4), T(4), [](const auto& x) { return md::pow<7>(x); },
+      [](long double v) { return std::pow(v, 7.0L); });
+  check_unary<T>(
+      "pow<-1, 2>(x)", T(1e-3), T(1e3), [](const auto& x) { return md::pow<-1, 2>(x); },
+      [](long double v) { return 1.0L / std::sqrt(v); });
+  check_unary<T>(
+      "pow<3, 2>(x)", T(0), T(100), [](const auto& x) { return md::pow<3, 2>(x); },
+      [](long double v) { return std::pow(v, 1.5L); });
+
+  // 标量除数乘以倒数 与除法至多相差1 ULP
+  check_unary<T>(
+      "x / 3", T(-100), T(100), [](const auto& x) { return x / 3; }, [](long double v) { return v / 3.0L; });
+  check_unary<T>(
+      "div<fast>(1.7, x)", T(1e-3), T(1e3), [](const auto& x) { return md::div<md::fast_math>(T(1.7), x); },
+      [](long double v) { return 1.7L / v; });
+  {
+    const size_t n = 100003;
+    mdvector_1d<T> a({n});
+    mdvector_1d<T> b({n});
+    for (size_t i = 0; i < n; ++i) {
+      a(i) = T(-100) + T(200) * static_cast<T>(i) / static_cast<T>(n - 1);
+      b(i) = a(i) * a(i) + T(1);
+    }
+    mdvector_1d<T> q = md::div<md::fast_math>(a, b);
+    double max_err = 0;
+    for (size_t i = 0; i < n; ++i) {
+      max_err = std::max(max_err, ulp_error<T>(q(i), static_cast<long double>(a(i)) / b(i)));
+    }
+    std::cout << "div<fast>(a, b) max ulp error: " << max_err << "\n";
+  }
+
+  // polyval 10次多项式(e^x的Taylor展开) 参考值用同样转换为T的系数以long double求值
+  {
+    static constexpr double coef[] = {1.0 / 3628800, 1.0 / 362880, 1.0 / 40320, 1.0 / 5040, 1.0 / 720, 1.0 / 120,
+                                      1.0 / 24,      1.0 / 6,      0.5,          1.0,        1.0};
+    auto poly_ref = [](long double v) {
+      long double r = 0;
+      for (double c : coef) r = r * v + static_cast<T>(c);
+      return r;
+    };
+    check_unary<T>(
+        "polyval<horner>", T(-1), T(1), [](const auto& x) { return md::polyval(x, coef); }, poly_ref);
+    check_unary<T>(
+        "polyval<estrin>", T(-1), T(1), [](const auto& x) { return md::polyval<md::estrin>(x, coef); }, poly_ref);
+    const std::vector<double> coef_vec(std::begin(coef), std::end(coef));
+    check_unary<T>(
+        "polyval(vector)", T(-1), T(1), [&](const auto& x) { return md::polyval(x, coef_vec); }, poly_ref);
+  }
+
+  auto sigmoid_ref = [](long double v) { return 1.0L / (1.0L + std::exp(-v)); };
+  auto softplus_ref = [](long double v) { return std::log1p(std::exp(v)); };
+  check_unary<T>(
+      "tanh", T(-10), T(10), [](const auto& x) { return md::tanh(x); }, [](long double v) { return std::tanh(v); });
+  check_unary<T>(
+      "tanh", T(-1), T(1), [](const auto& x) { return md::tanh(x); }, [](long double v) { return std::tanh(v); });
+  check_unary<T>(
+      "sigmoid", T(-80), T(80), [](const auto& x) { return md::sigmoid(x); }, sigmoid_ref);
+  check_unary<T>(
+      "erf", T(-6), T(6), [](const auto& x) { return md::erf(x); }, [](long double v) { return std::erf(v); });
+  check_unary<T>(
+      "erf", T(-1.5), T(1.5), [](const auto& x) { return md::erf(x); }, [](long double v) { return std::erf(v); });
+  check_unary<T>(
+      "softplus", T(-80), T(80), [](const auto& x) { return md::softplus(x); }, softplus_ref);
+
+  // 快速档
+  check_relative<T>(
+      "tanh<fast>", T(-10), T(10), [](const auto& x) { return md::tanh<md::fast_math>(x); },
+      [](long double v) { return std::tanh(v); });
+  check_relative<T>(
+      "sigmoid<fast>", T(-80), T(80), [](const auto& x) { return md::sigmoid<md::fast_math>(x); }, sigmoid_ref);
+  check_relative<T>(
+      "erf<fast>", T(-6), T(6), [](const auto& x) { return md::erf<md::fast_math>(x); },
+      [](long double v) { return std::erf(v); });
+  check_relative<T>(
+      "softplus<fast>", T(-80), T(80), [](const auto& x) { return md::softplus<md::fast_math>(x); }, softplus_ref);
+}
+
+template <class T>
+void test_special_value() {
+  const T inf = std::numeric_limits<T>::infinity();
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+  mdvector_1d<T> x({6});
+  x(0) = 0;
+  x(1) = -1;
+  x(2) = inf;
+  x(3) = -inf;
+  x(4) = nan;
+  x(5) = 1000;
+
+  mdvector_1d<T> y = md::exp(x);
+  std::cout << "exp(0, -1, inf, -inf, nan, 1000): ";
+  y.show_data_array_style();
+  std::cout << "expected: 1 0.367879 inf 0 nan inf\n";
+
+  y = md::log(x);
+  std::cout << "log(0, -1, inf, -inf, nan, 1000): ";
+  y.show_data_array_style();
+  std::cout << "expected: -inf nan inf nan nan 6.90776\n";
+
+  y = md::pow(x, T(0));
+  std::cout << "pow(x, 0): ";
+  y.show_data_array_style();
+  std::cout << "expected: 1 1 1 1 1 1\n";
+
+  y = md::div<md::fast_math>(T(1), x);
+  std::cout << "div<fast>(1, x): ";
+  y.show_data_array_style();
+  std::cout << "expected: inf -1 0 -0 nan 0.001\n";
+
+  y = x / T(-0.25);
+  std::cout << "x / -0.25: ";
+  y.show_data_array_style();
+  std::cout << "expected: -0 4 -inf inf nan -4000\n";
+
+  y = md::tanh(x);
+  std::cout << "tanh(x): ";
+  y.show_data_array_style();
+  std::cout << "expected: 0 -0.761594 1 -1 nan 1\n";
+
+  y = md::sigmoid(x);
+  std::cout << "sigmoid(x): ";
+  y.show_data_array_style();
+  std::cout << "expected: 0.5 0.268941 1 0 nan 1\n";
+
+  y = md::erf(x);
+  std::cout << "erf(x): ";
+  y.show_data_array_style();
+  std::cout << "expected: 0 -0.842701 1 -1 nan 1\n";
+
+  y = md::softplus(x);
+  std::cout << "softplus(x): ";
+  y.show_data_array_style();
+  std::cout << "expected: 0.693147 0.313262 inf 0 nan 1000\n";
+
+  y = md::tanh<md::fast_math>(x) + md::sigmoid<md::fast_math>(x);
+  std::cout << "tanh<fast>(x) + sigmoid<fast>(x): ";
+  y.show_data_array_style();
+  std::cout << "expected: 0.5 -0.492653 2 -1 nan 2\n";
+}
+
+// pow的零/无穷/NaN特殊值与std::pow逐元素比较(含零的符号) 标量指数与向量指数两条路径
+template <class T>
+void test_pow_special() {
+  const T inf = std::numeric_limits<T>::infinity();
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+  const std::vector<T> xs = {T(0), T(-0.0), T(1), T(-1), T(2), T(-2), T(0.5), T(-0.5), inf, -inf, nan};
+  const std::vector<T> ys = {T(0),   T(-0.0), T(1),    T(-1),   T(2), T(3), T(-3),
+                             T(0.5), T(-0.5), T(1.5), T(-1.5), inf,  -inf, nan};
+
+  mdvector_1d<T> x({xs.size()});
+  mdvector_1d<T> yv({xs.size()});
+  for (size_t k = 0; k < xs.size(); ++k) x(k) = xs[k];
+
+  // 有限非零结果允许近似误差 其余须完全一致
+  auto same = [](T v, T ref) {
+    if (std::isnan(ref)) return std::isnan(v);
+    if (std::signbit(v) != std::signbit(ref)) return false;
+    if (ref == T(0) || std::isinf(ref)) return v == ref;
+    return std::fabs(v - ref) <= T(1e-5) * std::fabs(ref);
+  };
+
+  size_t bad_scalar = 0;
+  size_t bad_vector = 0;
+  for (const T y : ys) {
+    yv.set_value(y);
+    mdvector_1d<T> r = md::pow(x, y);
+    mdvector_1d<T> rv = md::pow(x, yv);
+    for (size_t k = 0; k < xs.size(); ++k) {
+      const T ref = std::pow(xs[k], y);
+      if (!same(r(k), ref)) ++bad_scalar;
+      if (!same(rv(k), ref)) ++bad_vector;
+    }
+  }
+  std::cout << "pow special values vs std::pow (scalar / vector exponent): expected 0 0\n"
+            << bad_scalar << " " << bad_vector << "\n";
+
+  mdvector_1d<T> r = md::pow<1, 2>(x) + md::pow<-1, 2>(x);
+  std::cout << "pow<1, 2>(x) + pow<-1, 2>(x) at -0 / -inf: expected inf inf\n" << r(1) << " " << r(9) << "\n";
+}
+
+void test_elementwise() {
+  mdvector_2d<double> x({2, 5});
+  mdvector_2d<double> y({2, 5});
+  for (size_t i = 0; i < 2; ++i) {
+    for (size_t j = 0; j < 5; ++j) {
+      x(i, j) = static_cast<double>(j) - 2.5 + static_cast<double>(i);  // -2.5 -1.5 -0.5 0.5 1.5 / -1.5 ... 2.5
+      y(i, j) = 2.0;
+    }
+  }
+  std::cout << "x:\n";
+  x.show_data_matrix_style();
+
+  mdvector_2d<double> r = md::sqrt(x * x + y * y);
+  std::cout << "\nsqrt(x*x + y*y): expected 3.20156 2.5 2.06155 2.06155 2.5 / 2.5 2.06155 2.06155 2.5 3.20156\n";
+  r.show_data_matrix_style();
+
+  r = md::abs(x);
+  std::cout << "\nabs(x): expected 2.5 1.5 0.5 0.5 1.5 / 1.5 0.5 0.5 1.5 2.5\n";
+  r.show_data_matrix_style();
+
+  r = -x;
+  std::cout << "\n-x: expected 2.5 1.5 0.5 -0.5 -1.5 / 1.5 0.5 -0.5 -1.5 -2.5\n";
+  r.show_data_matrix_style();
+
+  r = md::max(x, 0.0);
+  std::cout << "\nmax(x, 0): expected 0 0 0 0.5 1.5 / 0 0 0.5 1.5 2.5\n";
+  r.show_data_matrix_style();
+
+  r = md::min(1.0, x) * 2.0;
+  std::cout << "\nmin(1, x) * 2: expected -5 -3 -1 1 2 / -3 -1 1 2 2\n";
+  r.show_data_matrix_style();
+
+  r = md::clamp(x, -1.0, 1.0);
+  std::cout << "\nclamp(x, -1, 1): expected -1 -1 -0.5 0.5 1 / -1 -0.5 0.5 1 1\n";
+  r.show_data_matrix_style();
+
+  r = md::floor(x);
+  std::cout << "\nfloor(x): expected -3 -2 -1 0 1 / -2 -1 0 1 2\n";
+  r.show_data_matrix_style();
+
+  r = md::ceil(x);
+  std::cout << "\nceil(x): expected -2 -1 -0 1 2 / -1 -0 1 2 3\n";
+  r.show_data_matrix_style();
+
+  r = md::round(x);
+  std::cout << "\nround(x): expected -2 -2 -0 0 2 / -2 -0 0 2 2\n";
+  r.show_data_matrix_style();
+
+  // 标量在左侧时形状取自右侧
+  r = 0.5 * md::sqrt(y);
+  std::cout << "\n0.5 * sqrt(y): expected all 0.707107\n";
+  r.show_data_matrix_style();
+
+  r = md::polyval(x, {1.0, -2.0, 3.0});
+  std::cout << "\npolyval(x, {1, -2, 3}): expected 14.25 8.25 4.25 2.25 2.25 / 8.25 4.25 2.25 2.25 4.25\n";
+  r.show_data_matrix_style();
+
+  r = md::polyval<md::estrin>(x, std::array<double, 4>{0.5, 1.0, -2.0, 3.0}) - md::polyval(x, {0.5, 0.0, 0.0, 0.0});
+  std::cout << "\npolyval<estrin>(x, {0.5, 1, -2, 3}) - 0.5x^3: expected same as above\n";
+  r.show_data_matrix_style();
+
+  mdvector_1d<int> k({5});
+  for (int i = 0; i < 5; ++i) k(i) = i - 2;
+  mdvector_1d<int> kp = md::polyval(k, {2, 0, -1});
+  std::cout << "\npolyval(int {-2 -1 0 1 2}, {2, 0, -1}): expected 7 1 -1 1 7\n";
+  kp.show_data_matrix_style();
+
+  // 子视图
+  auto row = x.create_subspan(1, md::all());
+  row = md::clamp(row, 0.0, 1.0) - 1.0;
+  std::cout << "\nrow 1 = clamp(row 1, 0, 1) - 1: expected -2.5 -1.5 -0.5 0.5 1.5 / -1 -1 -0.5 0 0\n";
+  x.show_data_matrix_style();
+}
+
+int main(int args, char* argv[]) {
+  std::cout << "=== float ===" << std::endl;
+  test_accuracy<float>();
+  test_special_value<float>();
+  test_pow_special<float>();
+
+  std::cout << "\n=== double ===" << std::endl;
+  test_accuracy<double>();
+  test_special_value<double>();
+  test_pow_special<double>();
+
+  std::cout << "\n=== elementwise ===" << std::endl;
+  test_elementwise();
+
+  // 组合表达式 一次遍历完成
+  std::cout << "\n=== r = exp(-a * b) * sin(c) ===" << std::endl;
+  mdvector_2d<double> a({3, 5});
+  mdvector_2d<double> b({3, 5});
+  mdvector_2d<double> c({3, 5});
+  a.set_value(0.5);
+  b.set_value(2.0);
+  c.set_value(1.0);
+  mdvector_2d<double> r = md::exp(-a * b) * md::sin(c);
+  r.show_data_matrix_style();
+  std::cout << "expected: " << std::exp(-1.0) * std::sin(1.0) << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+// 与标量float计算后按存储类型收窄的结果比较 返回不一致个数
+template <class S, class F>
+size_t mismatch(const mdvector_2d<S>& r, const mdvector_2d<S>& x, F f) {
+  size_t count = 0;
+  for (size_t k = 0; k < x.size(); ++k) {
+    if (r.cbegin()[k].bits != S(f(static_cast<float>(x.cbegin()[k]))).bits) ++count;
+  }
+  return count;
+}
+
+template <class S>
+void test_storage(const char* name) {
+  std::cout << "=== " << name << " pack_size " << simd<float>::pack_size << " ===\n";
+
+  // 3 * 37 非pack_size整数倍 覆盖尾部掩码
+  mdvector_2d<S> x({3, 37});
+  for (size_t k = 0; k < x.size(); ++k) {
+    x.begin()[k] = S(0.25f * static_cast<float>(k) - 10.0f);
+  }
+  std::cout << "aligned storage: expected 1\n"
+            << (reinterpret_cast<uintptr_t>(x.begin()) % simd<float>::alignment == 0) << "\n";
+
+  mdvector_2d<S> y({3, 37});
+  y.set_value(S(1.5f));
+
+  // float计算 写回时收窄一次
+  mdvector_2d<S> r = x * y + 2.0f;
+  std::cout << "x * 1.5 + 2 mismatches: expected 0\n"
+            << mismatch(r, x, [](float v) { return v * 1.5f + 2.0f; }) << "\n";
+
+  r = x / y - x;
+  std::cout << "x / 1.5 - x mismatches: expected 0\n"
+            << mismatch(r, x, [](float v) { return v / 1.5f - v; }) << "\n";
+
+  r = md::where(x < 0.0f, -x, x);
+  std::cout << "where(x < 0, -x, x) mismatches: expected 0\n"
+            << mismatch(r, x, [](float v) { return std::fabs(v); }) << "\n";
+
+  // 与float数组混合 同以float计算
+  mdvector_2d<float> f({3, 37});
+  f.set_value(0.5f);
+  r = x * f;
+  std::cout << "half * float mismatches: expected 0\n" << mismatch(r, x, [](float v) { return v * 0.5f; }) << "\n";
+
+  mdvector_2d<float> wide = x + f;
+  std::cout << "to float: expected " << static_cast<float>(x.cbegin()[110]) + 0.5f << "\n" << wide.cbegin()[110] << "\n";
+
+  // 就地运算
+  r = x;
+  r += y;
+  std::cout << "r += y mismatches: expected 0\n" << mismatch(r, x, [](float v) { return v + 1.5f; }) << "\n";
+
+  // 归约以float累加
+  float s = 0.0f;
+  for (size_t k = 0; k < x.size(); ++k) s += static_cast<float>(x.cbegin()[k]);
+  std::cout << "sum(x): expected " << s << "\n" << md::sum(x) << "\n";
+  std::cout << "min(x) / max(x): expected -10 17.5\n" << md::min(x) << " " << md::max(x) << "\n";
+
+  // 子视图 UnalignedPolicy
+  auto row = x.create_subspan(1, all());
+  row = row * 2.0f;
+  std::cout << "row 1 *= 2: expected -1.5 -1 ... 16 16.5\n";
+  for (size_t j = 0; j < 37; ++j) std::cout << static_cast<float>(x(1, j)) << " ";
+  std::cout << "\n\n";
+}
+
+// 标量转换 舍入与特殊值
+void test_convert() {
+  std::cout << "=== conversion ===\n";
+  std::cout << "half(1 + 2^-11) tie to even: expected 1\n" << static_cast<float>(md::half(1.0f + 0x1p-11f)) << "\n";
+  std::cout << "half(1 + 3 * 2^-11) tie to even: expected 1.00195\n"
+            << static_cast<float>(md::half(1.0f + 3 * 0x1p-11f)) << "\n";
+  std::cout << "half(65520) / half(65504): expected inf 65504\n"
+            << static_cast<float>(md::half(65520.0f)) << " " << static_cast<float>(md::half(65504.0f)) << "\n";
+  std::cout << "half(2^-24) / half(2^-26): expected 5.96046e-08 0\n"
+            << static_cast<float>(md::half(0x1p-24f)) << " " << static_cast<float>(md::half(0x1p-26f)) << "\n";
+  std::cout << "bfloat16(1 + 2^-8) tie to even: expected 1\n"
+            << static_cast<float>(md::bfloat16(1.0f + 0x1p-8f)) << "\n";
+  std::cout << "bfloat16(3e38) / bfloat16(nan) is nan: expected 3.00406e+38 1\n"
+            << static_cast<float>(md::bfloat16(3e38f)) << " " << std::isnan(static_cast<float>(md::bfloat16(NAN)))
+            << "\n";
+
+  // 向量收窄与标量收窄逐位一致(含half非规格化数 溢出 NaN)
+  const float samples[] = {0.0f,   -0.0f,   1e-8f,  -3e-6f, 6.1e-5f, 0.1f,     1.0f / 3.0f, 2.5f,
+                           1000.7f, 65504.f, 7e4f,   1e30f,  -1e-20f, INFINITY, -INFINITY,   NAN};
+  mdvector_1d<float> src({16});
+  for (size_t k = 0; k < 16; ++k) src.begin()[k] = samples[k];
+  mdvector_1d<md::half> h = src * 1.0f;
+  mdvector_1d<md::bfloat16> b = src * 1.0f;
+  size_t bad = 0;
+  for (size_t k = 0; k < 16; ++k) {
+    if (h.cbegin()[k].bits != md::half(samples[k]).bits) ++bad;
+    if (b.cbegin()[k].bits != md::bfloat16(samples[k]).bits) ++bad;
+  }
+  std::cout << "simd vs scalar narrowing mismatches: expected 0\n" << bad << "\n\n";
+}
+
+int main(int args, char* argv[]) {
+  test_convert();
+  test_storage<md::half>("half");
+  test_storage<md::bfloat16>("bfloat16");
+
+  return 0;
+}
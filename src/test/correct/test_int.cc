@@ -0,0 +1,139 @@
+#include <cstdint>
+#include <iostream>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+// 与标量逐元素结果比较 返回不一致个数
+template <class T, class F>
+size_t mismatch(const mdvector_2d<T>& r, const mdvector_2d<T>& x, F f) {
+  size_t count = 0;
+  for (size_t k = 0; k < x.size(); ++k) {
+    if (r.cbegin()[k] != static_cast<T>(f(x.cbegin()[k]))) ++count;
+  }
+  return count;
+}
+
+template <class T>
+void test_int(const char* name) {
+  std::cout << "=== " << name << " pack_size " << simd<T>::pack_size << " ===\n";
+
+  // 3 * 37 非pack_size整数倍 覆盖尾部掩码
+  mdvector_2d<T> x({3, 37});
+  for (size_t k = 0; k < x.size(); ++k) {
+    x.begin()[k] = static_cast<T>(k % 50);
+  }
+  std::cout << "aligned storage: expected 1\n"
+            << (reinterpret_cast<uintptr_t>(x.begin()) % simd<T>::alignment == 0) << "\n";
+
+  // 字节数不是对齐整数倍的长度 分配时向上取整
+  mdvector_1d<T> odd({40});
+  std::cout << "aligned storage of 40 elements: expected 1\n"
+            << (reinterpret_cast<uintptr_t>(odd.begin()) % simd<T>::alignment == 0) << "\n";
+
+  // 掩码访存的元素个数可等于pack_size
+  mdvector_1d<T> full({simd<T>::pack_size});
+  simd<T>::mask_store(full.begin(), simd<T>::pack_size, simd<T>::mask_load(x.cbegin(), simd<T>::pack_size));
+  size_t full_mismatch = 0;
+  for (size_t k = 0; k < full.size(); ++k) {
+    if (full.cbegin()[k] != x.cbegin()[k]) ++full_mismatch;
+  }
+  std::cout << "mask_load/mask_store of a full pack mismatches: expected 0\n" << full_mismatch << "\n";
+
+  mdvector_2d<T> y({3, 37});
+  y.set_value(T(3));
+
+  // 四则运算 乘加拆分为乘法与加法
+  mdvector_2d<T> r = x * y + T(7);
+  std::cout << "x * 3 + 7 mismatches: expected 0\n" << mismatch(r, x, [](T v) { return v * 3 + 7; }) << "\n";
+
+  r = x * x - y;
+  std::cout << "x * x - 3 mismatches: expected 0\n" << mismatch(r, x, [](T v) { return v * v - 3; }) << "\n";
+
+  r = (x + 1) / y;
+  std::cout << "(x + 1) / 3 mismatches: expected 0\n" << mismatch(r, x, [](T v) { return (v + 1) / 3; }) << "\n";
+
+  // 编译期整数幂
+  r = md::pow<2>(x) + x;
+  std::cout << "pow<2>(x) + x mismatches: expected 0\n" << mismatch(r, x, [](T v) { return v * v + v; }) << "\n";
+
+  // 位运算与移位 标量字面量按元素类型广播
+  r = (x & 0x0F) | (y << 4);
+  std::cout << "(x & 15) | (3 << 4) mismatches: expected 0\n"
+            << mismatch(r, x, [](T v) { return (v & 0x0F) | (3 << 4); }) << "\n";
+
+  r = (x ^ y) >> 1;
+  std::cout << "(x ^ 3) >> 1 mismatches: expected 0\n" << mismatch(r, x, [](T v) { return (v ^ 3) >> 1; }) << "\n";
+
+  r = ~x;
+  std::cout << "~x mismatches: expected 0\n" << mismatch(r, x, [](T v) { return ~v; }) << "\n";
+
+  // 有符号类型为算术右移
+  r = (x - 25) >> 2;
+  std::cout << "(x - 25) >> 2 mismatches: expected 0\n"
+            << mismatch(r, x, [](T v) { return static_cast<T>(v - 25) >> 2; }) << "\n";
+
+  // 比较 条件选择 最值
+  r = md::where(x > T(20) && x != T(30), x, T(0));
+  std::cout << "where(x > 20 && x != 30, x, 0) mismatches: expected 0\n"
+            << mismatch(r, x, [](T v) { return v > 20 && v != 30 ? v : 0; }) << "\n";
+
+  r = md::clamp(x, T(10), T(40));
+  std::cout << "clamp(x, 10, 40) mismatches: expected 0\n"
+            << mismatch(r, x, [](T v) { return v < 10 ? 10 : (v > 40 ? 40 : v); }) << "\n";
+
+  // 浮点标量按浮点计算后转换 不截断为整数
+  r = x * 0.5 + 0.25;
+  std::cout << "x * 0.5 + 0.25 mismatches: expected 0\n" << mismatch(r, x, [](T v) { return v * 0.5 + 0.25; }) << "\n";
+
+  r = md::where(x < 2.5, T(1), T(0));
+  std::cout << "where(x < 2.5, 1, 0) mismatches: expected 0\n"
+            << mismatch(r, x, [](T v) { return v < 2.5 ? 1 : 0; }) << "\n";
+
+  r = x;
+  r *= 0.5;
+  std::cout << "x *= 0.5 mismatches: expected 0\n" << mismatch(r, x, [](T v) { return v * 0.5; }) << "\n";
+
+  double half_sum = 0.0;
+  for (size_t k = 0; k < x.size(); ++k) half_sum += x.cbegin()[k] * 0.5;
+  std::cout << "sum(x * 0.5): expected " << half_sum << "\n" << md::sum(x * 0.5) << "\n";
+
+  // 归约
+  // 64位以下整数以int64_t累加 不回绕
+  int64_t s = 0;
+  for (size_t k = 0; k < x.size(); ++k) s += x.cbegin()[k];
+  std::cout << "sum(x): expected " << s << "\n" << md::sum(x) << "\n";
+  std::cout << "sum(x + x): expected " << 2 * s << "\n" << md::sum(x + x) << "\n";
+
+  odd.set_value(T(100));
+  std::cout << "sum of 40 x 100: expected 4000\n" << md::sum(odd) << "\n";
+  std::cout << "sum of 40 x (100 + 100): expected 8000\n" << md::sum(odd + odd) << "\n";
+  std::cout << "min(x + 5) / max(x): expected 5 49\n" << +md::min(x + T(5)) << " " << +md::max(x) << "\n";
+
+  // 平均值返回double 不截断
+  mdvector_2d<T> pair({2, 2});
+  for (size_t k = 0; k < pair.size(); ++k) pair.begin()[k] = static_cast<T>(k + 1);
+  auto row_mean = md::mean<1>(pair);
+  std::cout << "mean of {1, 2}: expected 1.5\n" << md::mean(pair.create_subspan(0, all())) << "\n";
+  std::cout << "mean<1> of {{1, 2}, {3, 4}}: expected 1.5 3.5\n" << row_mean(0) << " " << row_mean(1) << "\n";
+  mdvector_2d<T> rows({2, 40});
+  rows.set_value(T(100));
+  std::cout << "mean<1> of 40 x 100 per row: expected 100\n" << md::mean<1>(rows)(1) << "\n";
+
+  // 子视图 UnalignedPolicy
+  auto row = x.create_subspan(1, all());
+  row = row * T(2);
+  std::cout << "row 1 *= 2: expected 37*2 ... 49*2 0 2 ... 23*2\n";
+  x.show_data_matrix_style();
+  std::cout << "\n";
+}
+
+int main(int args, char* argv[]) {
+  test_int<int32_t>("int32_t");
+  test_int<int64_t>("int64_t");
+  test_int<int16_t>("int16_t");
+  test_int<uint8_t>("uint8_t");
+
+  return 0;
+}
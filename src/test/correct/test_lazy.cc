@@ -0,0 +1,123 @@
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+// 与标量结果逐元素比较 返回不一致个数
+template <class R, class F>
+size_t mismatch(const R& r, F f) {
+  size_t count = 0;
+  for (size_t k = 0; k < r.size(); ++k) {
+    if (r.cbegin()[k] != f(k)) ++count;
+  }
+  return count;
+}
+
+// 在其他函数栈帧中构造 返回后子表达式与标量均已离开作用域
+template <class A, class B>
+auto make_update(const A& u, const B& v, double dt) {
+  return (md::sqrt(md::abs(u) * dt) + 1.0) * v;
+}
+
+template <class A>
+auto make_plane(A& field, size_t k) {
+  return field.create_subspan(k, all(), all()) * 2.0 - 1.0;
+}
+
+// 覆盖已释放的栈空间
+void scrub_stack() {
+  volatile char junk[4096];
+  std::memset(const_cast<char*>(junk), 0x5A, sizeof(junk));
+}
+
+// 求解器结构体中保存表达式 每个时间步重新求值
+struct Solver {
+  mdvector_2d<double> u;
+  mdvector_2d<double> v;
+  decltype(make_update(u, v, 0.0)) step;
+
+  Solver(size_t m, size_t n) : u({m, n}), v({m, n}), step(make_update(u, v, 0.01)) {}
+};
+
+int main(int args, char* argv[]) {
+  // 3 * 37 非pack_size整数倍 覆盖尾部掩码
+  mdvector_2d<double> a({3, 37});
+  mdvector_2d<double> b({3, 37});
+  for (size_t k = 0; k < a.size(); ++k) {
+    a.begin()[k] = 0.25 * static_cast<double>(k) - 10.0;
+    b.begin()[k] = 1.0 / (1.0 + static_cast<double>(k));
+  }
+  auto ak = [&](size_t k) { return a.cbegin()[k]; };
+  auto bk = [&](size_t k) { return b.cbegin()[k]; };
+
+  // 保存表达式 标量与子表达式按值持有
+  auto e = a * 2.0 + b;
+  scrub_stack();
+  mdvector_2d<double> r = e;
+  std::cout << "auto e = a * 2 + b mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return std::fma(ak(k), 2.0, bk(k)); }) << "\n";
+
+  // 具名数组按引用持有 修改后再次求值得到新结果
+  a.set_value(3.0);
+  r = e;
+  std::cout << "e after a = 3 mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return std::fma(3.0, 2.0, bk(k)); }) << "\n";
+
+  auto update = make_update(a, b, 0.5);
+  scrub_stack();
+  r = update;
+  std::cout << "returned (sqrt(|a| * dt) + 1) * b mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return (std::sqrt(std::fabs(ak(k)) * 0.5) + 1.0) * bk(k); }) << "\n";
+
+  // 条件选择与掩码逻辑同样可保存
+  for (size_t k = 0; k < a.size(); ++k) a.begin()[k] = static_cast<double>(k % 7) - 3.0;
+  auto clip = md::where((a > 0.0) && !(b < 0.05), a * b, -a);
+  scrub_stack();
+  r = clip;
+  std::cout << "stored where mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return (ak(k) > 0.0 && !(bk(k) < 0.05)) ? ak(k) * bk(k) : -ak(k); })
+            << "\n";
+
+  // 临时subspan视图按值持有
+  mdvector_3d<double> field({4, 5, 37});
+  for (size_t k = 0; k < field.size(); ++k) field.begin()[k] = static_cast<double>(k);
+  auto plane = make_plane(field, 2);
+  scrub_stack();
+  mdvector_2d<double> p({5, 37});
+  plane.eval_to(p.begin());
+  std::cout << "returned subspan * 2 - 1 mismatches: expected 0\n"
+            << mismatch(p, [&](size_t k) { return std::fma(static_cast<double>(2 * 5 * 37 + k), 2.0, -1.0); }) << "\n";
+
+  // 保存的广播表达式 低维操作数零拷贝映射 同维长度为1的操作数与子表达式在每次求值时重新展开
+  mdvector_1d<double> row({37});
+  mdvector_2d<double> col({3, 1});
+  row.set_value(1.0);
+  col.set_value(2.0);
+  auto bc = a * col + md::abs(row) * 2.0;
+  r = bc;
+  row.set_value(-4.0);
+  col.set_value(0.5);
+  r = bc;
+  std::cout << "stored broadcast after row, col updated mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return std::fma(ak(k), 0.5, 8.0); }) << "\n";
+  std::cout << "sum(stored broadcast) after update: expected 0\n"
+            << md::sum(bc) - md::sum(r) << "\n";
+
+  // 一次构造 多个时间步重复eval_to
+  Solver s(3, 37);
+  s.u.set_value(1.0);
+  s.v.set_value(2.0);
+  double expect = 2.0;
+  for (int t = 0; t < 5; ++t) {
+    s.step.eval_to(s.v.begin());
+    expect = (std::sqrt(0.01) + 1.0) * expect;
+  }
+  std::cout << "solver 5 steps mismatches: expected 0\n"
+            << mismatch(s.v, [&](size_t) { return expect; }) << "\n";
+  std::cout << "solver v(0, 0): expected " << expect << "\n" << s.v(0, 0) << "\n";
+
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <iostream>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+// 与同一公式不绑定时的结果逐元素比较 返回不一致个数
+template <class R, class S>
+size_t mismatch(const R& r, const S& s) {
+  size_t count = 0;
+  for (size_t k = 0; k < r.size(); ++k) {
+    if (r.cbegin()[k] != s.cbegin()[k]) ++count;
+  }
+  return count;
+}
+
+// 在其他函数栈帧中构造 返回后绑定变量与槽位仍有效
+template <class A>
+auto make_damping(const A& a, const A& b, const A& c) {
+  return md::let(md::exp(-a * b), [&](auto e) { return e * c + e * e; });
+}
+
+int main(int args, char* argv[]) {
+  // 3 * 37 非pack_size整数倍 覆盖尾部掩码
+  constexpr size_t M = 3;
+  constexpr size_t N = 37;
+  mdvector_2d<double> a({M, N});
+  mdvector_2d<double> b({M, N});
+  mdvector_2d<double> c({M, N});
+  for (size_t k = 0; k < a.size(); ++k) {
+    a.begin()[k] = 0.05 * static_cast<double>(k) - 2.0;
+    b.begin()[k] = 1.0 / (1.0 + static_cast<double>(k));
+    c.begin()[k] = static_cast<double>(k % 7) + 1.0;
+  }
+  mdvector_2d<double> r({M, N});
+  mdvector_2d<double> ref({M, N});
+
+  r = md::let(a + b, [&](auto s) { return s * s - c / s; });
+  ref = (a + b) * (a + b) - c / (a + b);
+  std::cout << "let(a + b) s * s - c / s mismatches: expected 0\n" << mismatch(r, ref) << "\n";
+
+  // 保存后重复求值 具名数组修改后结果随之更新
+  auto damping = make_damping(a, b, c);
+  r = damping;
+  ref = md::exp(-a * b) * c + md::exp(-a * b) * md::exp(-a * b);
+  std::cout << "returned let(exp(-a * b)) mismatches: expected 0\n" << mismatch(r, ref) << "\n";
+
+  a *= 0.5;
+  r = damping;
+  ref = md::exp(-a * b) * c + md::exp(-a * b) * md::exp(-a * b);
+  std::cout << "let after a *= 0.5 mismatches: expected 0\n" << mismatch(r, ref) << "\n";
+
+  // 同一let节点在表达式中出现两次 嵌套let
+  auto shifted = md::let(a + b, [&](auto s) { return s + 1.0; });
+  r = shifted / c - md::sqrt(md::abs(shifted));
+  ref = (a + b + 1.0) / c - md::sqrt(md::abs(a + b + 1.0));
+  std::cout << "let node used twice mismatches: expected 0\n" << mismatch(r, ref) << "\n";
+
+  r = md::let(a + b, [&](auto p) { return md::let(p * c, [&](auto q) { return q * q - p; }); });
+  ref = ((a + b) * c) * ((a + b) * c) - (a + b);
+  std::cout << "nested let mismatches: expected 0\n" << mismatch(r, ref) << "\n";
+
+  // 函数体内类型转换 float结果的一个pack对应两个double pack
+  mdvector_2d<float> f({M, N});
+  mdvector_2d<float> fref({M, N});
+  f = md::let(a * b, [&](auto s) { return md::cast<float>(s) + md::cast<float>(s * 2.0); });
+  fref = md::cast<float>(a * b) + md::cast<float>(a * b * 2.0);
+  std::cout << "let double, body float mismatches: expected 0\n" << mismatch(f, fref) << "\n";
+
+  // 函数体将低秩绑定变量广播
+  mdvector_1d<double> row({N});
+  for (size_t j = 0; j < N; ++j) row(j) = static_cast<double>(j);
+  r = md::let(row * 2.0, [&](auto s) { return a + s * s; });
+  ref = a + (row * 2.0) * (row * 2.0);
+  std::cout << "let broadcast in body mismatches: expected 0\n" << mismatch(r, ref) << "\n";
+
+  // subspan操作数 整数
+  mdvector_3d<int32_t> field({2, M, N});
+  for (size_t k = 0; k < field.size(); ++k) field.begin()[k] = static_cast<int32_t>(k % 11) - 5;
+  auto plane = field.create_subspan(1, all(), all());
+  mdvector_2d<int32_t> n({M, N});
+  mdvector_2d<int32_t> nref({M, N});
+  n = md::let(plane * 3 + 1, [&](auto s) { return s * s - s; });
+  nref = (plane * 3 + 1) * (plane * 3 + 1) - (plane * 3 + 1);
+  std::cout << "int32 let on subspan mismatches: expected 0\n" << mismatch(n, nref) << "\n";
+
+  return 0;
+}
@@ -0,0 +1,174 @@
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+template <class T>
+void test_reduce() {
+  // 长度遍历0~70 覆盖4路累加主循环/单pack循环/尾部掩码的所有组合
+  bool all_ok = true;
+  for (size_t n = 1; n <= 70; ++n) {
+    mdvector_1d<T> a({n});
+    mdvector_1d<T> b({n});
+    for (size_t i = 0; i < n; ++i) {
+      a(i) = static_cast<T>(i % 7) - T(3);  // -3 ... 3
+      b(i) = T(1) + static_cast<T>(i % 3);  // 1 2 3
+    }
+
+    T ref_sum = 0, ref_dot = 0, ref_sq = 0;
+    T ref_max = -std::numeric_limits<T>::infinity();
+    T ref_min = std::numeric_limits<T>::infinity();
+    for (size_t i = 0; i < n; ++i) {
+      ref_sum += a(i);
+      ref_dot += a(i) * b(i);
+      ref_sq += a(i) * a(i);
+      ref_max = std::max(ref_max, a(i) * b(i));
+      ref_min = std::min(ref_min, a(i) * b(i));
+    }
+
+    // 全为整数值 结果须精确相等
+    const bool ok = md::sum(a) == ref_sum && md::dot(a, b) == ref_dot && md::sum(a * b) == ref_dot &&
+                    md::max(a * b) == ref_max && md::min(a * b) == ref_min &&
+                    md::norm2(a) == std::sqrt(ref_sq) && md::mean(a) == ref_sum / static_cast<T>(n);
+    if (!ok) {
+      std::cout << "mismatch at n = " << n << "\n";
+      all_ok = false;
+    }
+  }
+  std::cout << "sum/dot/max/min/norm2/mean n = 1..70: " << (all_ok ? "ok" : "FAIL") << " expected: ok\n";
+
+  // 尾部单位元 全负数max 全正数min 乘积
+  mdvector_2d<T> x({3, 5});
+  x.set_value(T(-2));
+  std::cout << "max(all -2): " << md::max(x) << " expected: -2\n";
+  std::cout << "min(-x): " << md::min(-x) << " expected: 2\n";
+  std::cout << "prod(-x / 2 + 1): " << md::prod(-x / T(2) + T(1)) << " expected: " << std::pow(2.0, 15) << "\n";
+  std::cout << "sum(log(-x)) : " << md::sum(md::log(-x)) << " expected: " << 15 * std::log(2.0) << "\n";
+
+  // 标量在左侧的表达式
+  std::cout << "sum(1 - x): " << md::sum(T(1) - x) << " expected: 45\n";
+
+  // 子视图
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 5; ++j) {
+      x(i, j) = static_cast<T>(i * 5 + j);
+    }
+  }
+  auto row = x.create_subspan(1, all());
+  std::cout << "row 1 sum: " << md::sum(row) << " expected: 35\n";
+  std::cout << "row 1 max: " << md::max(row) << " expected: 9\n";
+  std::cout << "row 1 dot row 1: " << md::dot(row, row) << " expected: 255\n";
+  std::cout << "norm2(x - 7): " << md::norm2(x - T(7)) << " expected: " << std::sqrt(280.0) << "\n";
+}
+
+// 与标量三重循环比较 各维长度非pack_size整数倍
+template <class T>
+void test_reduce_axis() {
+  mdvector_3d<T> f({3, 5, 19});
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 5; ++j) {
+      for (size_t k = 0; k < 19; ++k) {
+        f(i, j, k) = static_cast<T>((i * 7 + j * 3 + k) % 11) - T(5);
+      }
+    }
+  }
+
+  mdvector_2d<T> s0 = md::sum<0>(f);
+  mdvector_2d<T> s1 = md::reduce<1>(f);
+  mdvector_2d<T> s2 = md::sum<2>(f);
+  mdvector_2d<T> m0 = md::max<0>(f);
+  mdvector_2d<T> m1 = md::min<1>(f);
+  mdvector_2d<T> m2 = md::max<2>(f);
+  mdvector_2d<T> a1 = md::mean<1>(f);
+  bool ok = s0.extents() == mdshape_2d{5, 19} && s1.extents() == mdshape_2d{3, 19} &&
+            s2.extents() == mdshape_2d{3, 5};
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 5; ++j) {
+      for (size_t k = 0; k < 19; ++k) {
+        T r0 = 0, r1 = 0, r2 = 0;
+        T x0 = -1000, n1 = 1000, x2 = -1000;
+        for (size_t t = 0; t < 3; ++t) {
+          r0 += f(t, j, k);
+          x0 = std::max(x0, f(t, j, k));
+        }
+        for (size_t t = 0; t < 5; ++t) {
+          r1 += f(i, t, k);
+          n1 = std::min(n1, f(i, t, k));
+        }
+        for (size_t t = 0; t < 19; ++t) {
+          r2 += f(i, j, t);
+          x2 = std::max(x2, f(i, j, t));
+        }
+        ok = ok && s0(j, k) == r0 && s1(i, k) == r1 && s2(i, j) == r2;
+        // 按轴均值为和乘以1/n
+        ok = ok && m0(j, k) == x0 && m1(i, k) == n1 && m2(i, j) == x2 && a1(i, k) == r1 * (T(1) / T(5));
+      }
+    }
+  }
+  std::cout << "sum/max/min/mean along axis 0/1/2 of 3x5x19: " << (ok ? "ok" : "FAIL") << " expected: ok\n";
+
+  // 连续子视图 形状1x5x19
+  auto slab = f.create_subspan(1, all(), all());
+  mdvector_2d<T> r = md::sum<2>(slab);
+  std::cout << "sum<2>(f[1]): ";
+  for (size_t j = 0; j < 5; ++j) std::cout << r(0, j) << " ";
+  std::cout << "expected: " << s2(1, 0) << " " << s2(1, 1) << " " << s2(1, 2) << " " << s2(1, 3) << " " << s2(1, 4)
+            << "\n";
+}
+
+// 大规模float求和 各累加策略相对long double参考值的误差
+void test_accumulate_policy() {
+  const size_t n = 10000019;
+  mdvector_1d<float> x({n});
+  mdvector_1d<float> y({n});
+  long double ref_sum = 0, ref_dot = 0;
+  for (size_t i = 0; i < n; ++i) {
+    x(i) = 0.1f + static_cast<float>(i % 1000) * 1e-4f;
+    y(i) = (i % 2) ? 1.5f : 0.5f;
+    ref_sum += x(i);
+    ref_dot += static_cast<long double>(x(i)) * y(i);
+  }
+  auto rel = [](float v, long double ref) { return static_cast<double>(std::fabs((v - ref) / ref)); };
+
+  const double e_plain = rel(md::sum(x), ref_sum);
+  const double e_pair = rel(md::sum(x, md::pairwise_sum), ref_sum);
+  const double e_kahan = rel(md::sum(x, md::kahan_sum), ref_sum);
+  std::cout << "float sum n=1e7 rel err plain: " << e_plain << " pairwise: " << e_pair << " kahan: " << e_kahan
+            << "\n";
+  std::cout << "plain > pairwise: " << (e_plain > e_pair ? "ok" : "FAIL") << " expected: ok\n";
+  std::cout << "pairwise < 1e-6: " << (e_pair < 1e-6 ? "ok" : "FAIL") << " expected: ok\n";
+  std::cout << "kahan < 1e-7: " << (e_kahan < 1e-7 ? "ok" : "FAIL") << " expected: ok\n";
+
+  const double d_kahan = rel(md::dot(x, y, md::kahan_sum), ref_dot);
+  const double d_pair = rel(md::dot(x, y, md::pairwise_sum), ref_dot);
+  std::cout << "dot kahan/pairwise < 1e-6: " << (d_kahan < 1e-6 && d_pair < 1e-6 ? "ok" : "FAIL") << " expected: ok\n";
+  const double m_kahan = rel(md::mean(x, md::kahan_sum), ref_sum / n);
+  std::cout << "mean kahan < 1e-7: " << (m_kahan < 1e-7 ? "ok" : "FAIL") << " expected: ok\n";
+
+  // 小规模结果与plain一致
+  mdvector_2d<double> a({3, 7});
+  a.set_value(0.5);
+  std::cout << "sum 21 * 0.5 plain/pairwise/kahan: " << md::sum(a) << " " << md::sum(a, md::pairwise_sum) << " "
+            << md::sum(a, md::kahan_sum) << " expected: 10.5 10.5 10.5\n";
+  std::cout << "norm2 21 * 0.5 pairwise/kahan: " << md::norm2(a, md::pairwise_sum) << " "
+            << md::norm2(a, md::kahan_sum) << " expected: " << std::sqrt(21 * 0.25) << " " << std::sqrt(21 * 0.25)
+            << "\n";
+}
+
+int main(int args, char* argv[]) {
+  std::cout << "=== float ===" << std::endl;
+  test_reduce<float>();
+  test_reduce_axis<float>();
+
+  std::cout << "\n=== double ===" << std::endl;
+  test_reduce<double>();
+  test_reduce_axis<double>();
+
+  std::cout << "\n=== accumulate policy ===" << std::endl;
+  test_accumulate_policy();
+
+  return 0;
+}
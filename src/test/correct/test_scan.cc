@@ -0,0 +1,83 @@
+#include <cmath>
+#include <iostream>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+// 与标量循环比较 各维长度非pack_size整数倍
+template <class T>
+void test_scan() {
+  mdvector_3d<T> f({3, 5, 37});
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 5; ++j) {
+      for (size_t k = 0; k < 37; ++k) {
+        f(i, j, k) = static_cast<T>((i * 7 + j * 3 + k) % 5) - T(2);
+      }
+    }
+  }
+
+  mdvector_3d<T> c0 = md::cumsum<0>(f);
+  mdvector_3d<T> c1 = md::cumsum<1>(f);
+  mdvector_3d<T> c2 = md::cumsum<2>(f);
+  bool ok = true;
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 5; ++j) {
+      for (size_t k = 0; k < 37; ++k) {
+        T r0 = 0, r1 = 0, r2 = 0;
+        for (size_t t = 0; t <= i; ++t) r0 += f(t, j, k);
+        for (size_t t = 0; t <= j; ++t) r1 += f(i, t, k);
+        for (size_t t = 0; t <= k; ++t) r2 += f(i, j, t);
+        ok = ok && c0(i, j, k) == r0 && c1(i, j, k) == r1 && c2(i, j, k) == r2;
+      }
+    }
+  }
+  std::cout << "cumsum along axis 0/1/2 of 3x5x37: " << (ok ? "ok" : "FAIL") << " expected: ok\n";
+
+  // 行长度遍历1~40 覆盖整pack/尾部组合
+  ok = true;
+  for (size_t n = 1; n <= 40; ++n) {
+    mdvector_2d<T> x({2, n});
+    for (size_t k = 0; k < n; ++k) {
+      x(0, k) = static_cast<T>(k % 3) + T(1);
+      x(1, k) = (k % 2) ? T(2) : T(0.5);
+    }
+    mdvector_2d<T> s = md::cumsum<1>(x);
+    mdvector_2d<T> p = md::cumprod<1>(x);
+    T rs0 = 0, rs1 = 0, rp1 = 1;
+    for (size_t k = 0; k < n; ++k) {
+      rs0 += x(0, k);
+      rs1 += x(1, k);
+      rp1 *= x(1, k);
+      ok = ok && s(0, k) == rs0 && s(1, k) == rs1 && p(1, k) == rp1;
+    }
+  }
+  std::cout << "cumsum/cumprod row length 1..40: " << (ok ? "ok" : "FAIL") << " expected: ok\n";
+
+  // 外层维cumprod 原地写入
+  mdvector_2d<T> g({4, 3});
+  g.set_value(T(2));
+  md::cumprod<0>(g, g);
+  std::cout << "in-place cumprod<0> of 4x3 twos:\n";
+  g.show_data_matrix_style();
+  std::cout << "expected: 2 2 2 / 4 4 4 / 8 8 8 / 16 16 16\n";
+
+  // 连续子视图写入子视图
+  auto src = f.create_subspan(1, all(), all());
+  auto dst = c0.create_subspan(2, all(), all());
+  md::cumsum<2>(src, dst);
+  std::cout << "cumsum<2>(f[1]) -> c0[2] first 5: ";
+  for (size_t k = 0; k < 5; ++k) std::cout << c0(2, 0, k) << " ";
+  std::cout << "expected: " << c2(1, 0, 0) << " " << c2(1, 0, 1) << " " << c2(1, 0, 2) << " " << c2(1, 0, 3) << " "
+            << c2(1, 0, 4) << "\n";
+}
+
+int main(int args, char* argv[]) {
+  std::cout << "=== float ===" << std::endl;
+  test_scan<float>();
+
+  std::cout << "\n=== double ===" << std::endl;
+  test_scan<double>();
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+// 阈值调小 使小数组也走自动流式写回
+#define MD_STREAM_THRESHOLD 4096
+
+#include <cstdint>
+#include <iostream>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+// 与标量结果逐元素比较 返回不一致个数
+template <class R, class F>
+size_t mismatch(const R& r, F f) {
+  size_t count = 0;
+  for (size_t k = 0; k < r.size(); ++k) {
+    if (r.cbegin()[k] != f(k)) ++count;
+  }
+  return count;
+}
+
+// 显式以StreamPolicy写回 元素个数非pack_size整数倍 覆盖尾部掩码
+template <class T>
+void test_explicit(const char* name) {
+  mdvector_2d<T> a({3, 37});
+  for (size_t k = 0; k < a.size(); ++k) a.begin()[k] = static_cast<T>(k % 50);
+  mdvector_2d<T> r({3, 37});
+  (a + a).template eval_to<StreamPolicy>(r.begin());
+  std::cout << name << " eval_to<StreamPolicy>(a + a) mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return static_cast<T>(a.cbegin()[k] + a.cbegin()[k]); }) << "\n";
+}
+
+int main(int args, char* argv[]) {
+  test_explicit<double>("double");
+  test_explicit<float>("float");
+  test_explicit<int32_t>("int32_t");
+  test_explicit<int64_t>("int64_t");
+  test_explicit<int16_t>("int16_t");
+  test_explicit<uint8_t>("uint8_t");
+
+  // 50 * 37 个double超过阈值
+  constexpr size_t M = 50;
+  constexpr size_t N = 37;
+  mdvector_2d<double> a({M, N});
+  mdvector_2d<double> b({M, N});
+  for (size_t k = 0; k < a.size(); ++k) {
+    a.begin()[k] = 0.5 * static_cast<double>(k);
+    b.begin()[k] = static_cast<double>(k % 7) - 3.0;
+  }
+  auto ak = [&](size_t k) { return a.cbegin()[k]; };
+  auto bk = [&](size_t k) { return b.cbegin()[k]; };
+
+  // 不相交 自动流式写回
+  mdvector_2d<double> r({M, N});
+  r = a - b;
+  std::cout << "r = a - b above threshold mismatches: expected 0\n"
+            << mismatch(r, [&](size_t k) { return ak(k) - bk(k); }) << "\n";
+
+  mdvector_2d<double> c = a + b * 2.0;
+  std::cout << "constructed from a + b * 2 mismatches: expected 0\n"
+            << mismatch(c, [&](size_t k) { return ak(k) + bk(k) * 2.0; }) << "\n";
+
+  // 目标为float 表达式为double 经类型转换后流式写回
+  mdvector_2d<float> f({M, N});
+  f = a - b;
+  std::cout << "float r = double a - b mismatches: expected 0\n"
+            << mismatch(f, [&](size_t k) { return static_cast<float>(ak(k) - bk(k)); }) << "\n";
+
+  // 16位浮点存储类型 写回为普通存储
+  mdvector_2d<md::half> h({M, N});
+  h = f * 0.25f;
+  std::cout << "half r = f * 0.25 mismatches: expected 0\n"
+            << mismatch(h, [&](size_t k) { return static_cast<float>(md::half(f.cbegin()[k] * 0.25f)); }) << "\n";
+
+  // 目标即操作数 或与操作数重叠 不流式写回 结果不变
+  c = c - b * 2.0;
+  std::cout << "c = c - b * 2 mismatches: expected 0\n" << mismatch(c, ak) << "\n";
+
+  // 操作数为subspan 目标不与其重叠 自动流式写回
+  mdvector_3d<double> field({2, M, N});
+  for (size_t k = 0; k < field.size(); ++k) field.begin()[k] = static_cast<double>(k);
+  mdvector_3d<double> plane({1, M, N});
+  plane = field.create_subspan(1, all(), all()) - static_cast<double>(M * N);
+  std::cout << "plane = subspan - offset mismatches: expected 0\n"
+            << mismatch(plane, [&](size_t k) { return static_cast<double>(k); }) << "\n";
+
+  // md::assign 目标不相交 写回总字节数超过阈值 对齐目标流式写回 subspan目标为普通存储
+  mdvector_2d<double> u1({M, N});
+  auto lower = field.create_subspan(0, all(), all());
+  md::assign(md::tie(u1, lower), a + b, a - b);
+  std::cout << "assign(tie(u1, subspan), a + b, a - b) mismatches: expected 0 0\n"
+            << mismatch(u1, [&](size_t k) { return ak(k) + bk(k); }) << " "
+            << mismatch(lower, [&](size_t k) { return ak(k) - bk(k); }) << "\n";
+
+  return 0;
+}
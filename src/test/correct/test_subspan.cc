@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 
 #include "src/mdvector/mdvector.h"
@@ -179,5 +180,135 @@ int main() {
   std::cout << "3D张量子视图[1, 2, 0:4]的形状: ";
   std::cout << tensor_sub.extent(0) << "x" << tensor_sub.extent(1) << "x" << tensor_sub.extent(2) << std::endl;
 
+  // 测试7: 子视图与mdvector混合运算 行长37使子视图起点不对齐
+  std::cout << "\n=== 测试7: 子视图与mdvector混合运算 ===" << std::endl;
+  constexpr size_t N = 37;
+  mdvector<double, 2> grid({3, N});
+  mdvector<double, 1> row({N});
+  mdvector<double, 2> line({1, N});
+  for (size_t k = 0; k < grid.size(); ++k) grid.begin()[k] = static_cast<double>(k);
+  for (size_t j = 0; j < N; ++j) {
+    row(j) = static_cast<double>(j) * 100.0;
+    line(0, j) = 1.0;
+  }
+  auto grid_row1 = grid.create_subspan(1, all());
+  auto grid_row2 = grid.create_subspan(2, all());
+
+  // 子视图 + mdvector 写入mdvector
+  size_t bad = 0;
+  mdvector<double, 2> mixed = grid_row1 + row;
+  for (size_t j = 0; j < N; ++j) bad += mixed(0, j) != static_cast<double>(N + j) + static_cast<double>(j) * 100.0;
+  std::cout << "grid[1, :] + row 不一致个数: 预期 0\n" << bad << std::endl;
+
+  // mdvector * 子视图 写入子视图
+  bad = 0;
+  grid_row2 = line * 2.0 - grid_row1;
+  for (size_t j = 0; j < N; ++j) bad += grid(2, j) != 2.0 - static_cast<double>(N + j);
+  std::cout << "grid[2, :] = line * 2 - grid[1, :] 不一致个数: 预期 0\n" << bad << std::endl;
+
+  // 复合赋值与函数
+  bad = 0;
+  line += md::max(grid_row1, row * 0.5);
+  for (size_t j = 0; j < N; ++j) {
+    bad += line(0, j) != 1.0 + std::max(static_cast<double>(N + j), static_cast<double>(j) * 50.0);
+  }
+  std::cout << "line += max(grid[1, :], row * 0.5) 不一致个数: 预期 0\n" << bad << std::endl;
+
+  bad = 0;
+  grid_row2 = md::where(grid_row1 > line, grid_row1, row);
+  for (size_t j = 0; j < N; ++j) {
+    const double g = static_cast<double>(N + j);
+    bad += grid(2, j) != (g > line(0, j) ? g : static_cast<double>(j) * 100.0);
+  }
+  std::cout << "grid[2, :] = where(grid[1, :] > line, grid[1, :], row) 不一致个数: 预期 0\n" << bad << std::endl;
+
+  double dot_ref = 0.0;
+  for (size_t j = 0; j < N; ++j) dot_ref += static_cast<double>(N + j) * static_cast<double>(j) * 100.0;
+  std::cout << "sum(grid[1, :] * row): 预期 " << dot_ref << "\n" << md::sum(grid_row1 * row) << std::endl;
+
+  // 测试8: 同一数组中部分重叠的子视图 赋值前检查内存区间
+  std::cout << "\n=== 测试8: 部分重叠的子视图 ===" << std::endl;
+  constexpr size_t R = 6;
+  mdvector<double, 2> field({R, N});
+  auto reset_field = [&] {
+    for (size_t k = 0; k < field.size(); ++k) field.begin()[k] = static_cast<double>(k);
+  };
+  auto f0 = [&](size_t r, size_t j) { return static_cast<double>(r * N + j); };
+  auto upper = field.create_subspan(md::slice(0, 3), all());  // 第0~3行
+  auto lower = field.create_subspan(md::slice(1, 4), all());  // 第1~4行 与upper错开一行
+
+  // 表达式赋值 操作数在目标之前 反向求值
+  reset_field();
+  bad = 0;
+  lower = upper + lower;
+  for (size_t r = 0; r < 4; ++r) {
+    for (size_t j = 0; j < N; ++j) bad += field(r + 1, j) != f0(r, j) + f0(r + 1, j);
+  }
+  std::cout << "rows[1:4] = rows[0:3] + rows[1:4] 不一致个数: 预期 0\n" << bad << std::endl;
+
+  // 子视图之间的复合赋值
+  reset_field();
+  bad = 0;
+  lower *= upper;
+  for (size_t r = 0; r < 4; ++r) {
+    for (size_t j = 0; j < N; ++j) bad += field(r + 1, j) != f0(r + 1, j) * f0(r, j);
+  }
+  std::cout << "rows[1:4] *= rows[0:3] 不一致个数: 预期 0\n" << bad << std::endl;
+
+  reset_field();
+  bad = 0;
+  upper -= lower * 0.5;
+  for (size_t r = 0; r < 4; ++r) {
+    for (size_t j = 0; j < N; ++j) bad += field(r, j) != f0(r, j) - f0(r + 1, j) * 0.5;
+  }
+  std::cout << "rows[0:3] -= rows[1:4] * 0.5 不一致个数: 预期 0\n" << bad << std::endl;
+
+  // 拷贝 目标在后时反向复制 在前时正向复制
+  reset_field();
+  bad = 0;
+  lower = upper;
+  for (size_t r = 0; r < 4; ++r) {
+    for (size_t j = 0; j < N; ++j) bad += field(r + 1, j) != f0(r, j);
+  }
+  reset_field();
+  upper = lower;
+  for (size_t r = 0; r < 4; ++r) {
+    for (size_t j = 0; j < N; ++j) bad += field(r, j) != f0(r + 1, j);
+  }
+  std::cout << "rows[1:4] = rows[0:3], rows[0:3] = rows[1:4] 不一致个数: 预期 0\n" << bad << std::endl;
+
+  // 操作数分别在目标之前与之后 经临时缓冲区
+  reset_field();
+  bad = 0;
+  auto middle = field.create_subspan(md::slice(1, 3), all());
+  auto below = field.create_subspan(md::slice(2, 4), all());
+  auto above = field.create_subspan(md::slice(0, 2), all());
+  middle = above - below * 2.0;
+  for (size_t r = 0; r < 3; ++r) {
+    for (size_t j = 0; j < N; ++j) bad += field(r + 1, j) != f0(r, j) - f0(r + 2, j) * 2.0;
+  }
+  std::cout << "rows[1:3] = rows[0:2] - rows[2:4] * 2 不一致个数: 预期 0\n" << bad << std::endl;
+
+  // 自身的一行广播到整个数组
+  reset_field();
+  bad = 0;
+  auto first = field.create_subspan(0, all());
+  field = field - md::broadcast_to(first, field.extents());
+  for (size_t r = 0; r < R; ++r) {
+    for (size_t j = 0; j < N; ++j) bad += field(r, j) != f0(r, j) - f0(0, j);
+  }
+  std::cout << "field = field - broadcast_to(field[0, :]) 不一致个数: 预期 0\n" << bad << std::endl;
+
+  // 同一视图原位计算与不相交视图 直接写回
+  reset_field();
+  bad = 0;
+  auto head = field.create_subspan(md::slice(0, 1), all());
+  auto tail = field.create_subspan(md::slice(4, 5), all());
+  head = head * 2.0 + tail;
+  for (size_t r = 0; r < 2; ++r) {
+    for (size_t j = 0; j < N; ++j) bad += field(r, j) != f0(r, j) * 2.0 + f0(r + 4, j);
+  }
+  std::cout << "rows[0:1] = rows[0:1] * 2 + rows[4:5] 不一致个数: 预期 0\n" << bad << std::endl;
+
   return 0;
 }
\ No newline at end of file
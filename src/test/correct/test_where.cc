@@ -0,0 +1,73 @@
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "src/mdvector/mdvector.h"
+
+using md::all;
+
+template <class T>
+void test_where() {
+  // 非pack_size整数倍 覆盖尾部掩码
+  mdvector_2d<T> x({3, 7});
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 7; ++j) {
+      x(i, j) = static_cast<T>(i * 7 + j) - T(10);  // -10 ... 10
+    }
+  }
+  std::cout << "x:\n";
+  x.show_data_matrix_style();
+
+  // 分段函数 x<0 ? -0.5x : x
+  mdvector_2d<T> r = md::where(x < T(0), -x * T(0.5), x);
+  std::cout << "\nwhere(x < 0, -0.5x, x): expected 5 4.5 4 3.5 3 2.5 2 / 1.5 1 0.5 0 1 2 3 / 4 5 6 7 8 9 10\n";
+  r.show_data_matrix_style();
+
+  // 区间判断 逻辑与/或/非
+  r = md::where(x >= T(-2) && x <= T(2), T(1), T(0));
+  std::cout << "\nwhere(-2 <= x <= 2, 1, 0): expected 0 0 0 0 0 0 0 / 0 1 1 1 1 1 0 / 0 0 0 0 0 0 0\n";
+  r.show_data_matrix_style();
+
+  r = md::where(!(x > T(-8)) || T(8) < x, x, T(0));
+  std::cout << "\nwhere(!(x > -8) || 8 < x, x, 0): expected -10 -9 -8 0 0 0 0 / 0 0 0 0 0 0 0 / 0 0 0 0 0 9 10\n";
+  r.show_data_matrix_style();
+
+  // 向量与向量比较
+  mdvector_2d<T> y({3, 7});
+  y.set_value(T(3));
+  r = md::where(x == y, T(100), md::max(x, y));
+  std::cout << "\nwhere(x == 3, 100, max(x, 3)): expected 3 3 3 3 3 3 3 / 3 3 3 3 3 3 100 / 4 5 6 7 8 9 10\n";
+  r.show_data_matrix_style();
+
+  r = md::where(x != y, T(0), y);
+  std::cout << "\nwhere(x != 3, 0, 3): expected 0 0 0 0 0 0 0 / 0 0 0 0 0 0 3 / 0 0 0 0 0 0 0\n";
+  r.show_data_matrix_style();
+
+  // NaN与任何值比较均为假 只有!=为真
+  mdvector_1d<T> n({3});
+  n(0) = std::numeric_limits<T>::quiet_NaN();
+  n(1) = T(1);
+  n(2) = T(-1);
+  mdvector_1d<T> rn = md::where(n < T(0) || n >= T(0), T(1), T(-1));
+  std::cout << "\nwhere(nan/1/-1 < 0 || >= 0, 1, -1): expected -1 1 1\n";
+  rn.show_data_array_style();
+  rn = md::where(n != n, T(1), T(0));
+  std::cout << "where(x != x, 1, 0): expected 1 0 0\n";
+  rn.show_data_array_style();
+
+  // 子视图 UnalignedPolicy
+  auto row = x.create_subspan(1, all());
+  row = md::where(row > T(0), row * T(10), row);
+  std::cout << "\nrow 1 = where(row 1 > 0, 10 * row 1, row 1): expected -10 ... -4 / -3 -2 -1 0 10 20 30 / -4 ... 10\n";
+  x.show_data_matrix_style();
+}
+
+int main(int args, char* argv[]) {
+  std::cout << "=== float ===" << std::endl;
+  test_where<float>();
+
+  std::cout << "\n=== double ===" << std::endl;
+  test_where<double>();
+
+  return 0;
+}
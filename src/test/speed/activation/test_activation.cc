@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+using std::vector;
+
+//
+#include "src/mdvector/mdvector.h"
+#include "src/test/speed/common/time_cost.h"
+
+// 测试点
+vector<TestPoint> all_test_points = {TestPoint(100, 100), TestPoint(1000, 1000)};
+
+// 防止结果被优化掉
+template <class T>
+void do_not_optimize(const T* p) {
+  volatile T sink = p[0];
+  (void)sink;
+}
+
+// long double参考值
+long double ref_tanh(long double x) { return std::tanh(x); }
+long double ref_sigmoid(long double x) { return 1.0L / (1.0L + std::exp(-x)); }
+long double ref_erf(long double x) { return std::erf(x); }
+long double ref_softplus(long double x) { return std::max(x, 0.0L) + std::log1p(std::exp(-std::fabs(x))); }
+
+// ======================== 标量循环 ========================
+template <class T, class Func>
+void test_scalar_loop(const string& name, T lo, T hi, Func func) {
+  vector<T> data1_(total_element);
+  vector<T> data3_(total_element);
+  for (size_t i = 0; i < total_element; i++) {
+    data1_[i] = lo + (hi - lo) * static_cast<T>(i) / static_cast<T>(total_element);
+  }
+
+  {
+    TimerRecorder a(name);
+
+    size_t k = 0;
+    while (k++ < loop) {
+      for (size_t i = 0; i < total_element; i++) {
+        data3_[i] = func(data1_[i]);
+      }
+    }
+  }
+  do_not_optimize(data3_.data());
+}
+
+// ======================== mdvector表达式 ========================
+template <class T, class Func>
+void test_mdvector_expr(const string& name, T lo, T hi, Func func) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> data1_(test_shape);
+  mdvector_2d<T> data3_(test_shape);
+  for (size_t i = 0; i < total_element; i++) {
+    data1_.begin()[i] = lo + (hi - lo) * static_cast<T>(i) / static_cast<T>(total_element);
+  }
+
+  {
+    TimerRecorder a(name);
+
+    size_t k = 0;
+    while (k++ < loop) {
+      data3_ = func(data1_);
+    }
+  }
+  do_not_optimize(data3_.begin());
+}
+
+// ======================== 精度 ========================
+// [lo, hi]上均匀取点 相对long double参考值的最大相对误差
+template <class T, class Func, class Ref>
+void test_accuracy(const string& name, T lo, T hi, Func func, Ref ref) {
+  const size_t n = 1000003;
+  mdvector_1d<T> x({n});
+  for (size_t i = 0; i < n; i++) {
+    x(i) = lo + (hi - lo) * static_cast<T>(i) / static_cast<T>(n - 1);
+  }
+  mdvector_1d<T> y = func(x);
+
+  long double max_err = 0;
+  for (size_t i = 0; i < n; i++) {
+    const long double r = ref(static_cast<long double>(x(i)));
+    if (r != 0) max_err = std::max(max_err, std::fabs((static_cast<long double>(y(i)) - r) / r));
+  }
+  std::cout << name << "\t\tmax relative error " << static_cast<double>(max_err) << "\n";
+}
+
+template <class T>
+void test_all_accuracy(const string& type) {
+  test_accuracy<T>("md tanh " + type, T(-10), T(10), [](const auto& x) { return md::tanh(x); }, ref_tanh);
+  test_accuracy<T>(
+      "md tanh<fast> " + type, T(-10), T(10), [](const auto& x) { return md::tanh<md::fast_math>(x); }, ref_tanh);
+
+  test_accuracy<T>("md sigmoid " + type, T(-20), T(20), [](const auto& x) { return md::sigmoid(x); }, ref_sigmoid);
+  test_accuracy<T>(
+      "md sigmoid<fast> " + type, T(-20), T(20), [](const auto& x) { return md::sigmoid<md::fast_math>(x); },
+      ref_sigmoid);
+
+  test_accuracy<T>("md erf " + type, T(-5), T(5), [](const auto& x) { return md::erf(x); }, ref_erf);
+  test_accuracy<T>(
+      "md erf<fast> " + type, T(-5), T(5), [](const auto& x) { return md::erf<md::fast_math>(x); }, ref_erf);
+
+  test_accuracy<T>("md softplus " + type, T(-20), T(20), [](const auto& x) { return md::softplus(x); }, ref_softplus);
+  test_accuracy<T>(
+      "md softplus<fast> " + type, T(-20), T(20), [](const auto& x) { return md::softplus<md::fast_math>(x); },
+      ref_softplus);
+}
+
+template <class T>
+void test_all(const string& type) {
+  test_scalar_loop<T>("std tanh " + type, T(-10), T(10), [](T x) { return std::tanh(x); });
+  test_mdvector_expr<T>("md tanh " + type, T(-10), T(10), [](const auto& x) { return md::tanh(x); });
+  test_mdvector_expr<T>("md tanh<fast> " + type, T(-10), T(10),
+                        [](const auto& x) { return md::tanh<md::fast_math>(x); });
+
+  test_scalar_loop<T>("std sigmoid " + type, T(-20), T(20), [](T x) { return T(1) / (T(1) + std::exp(-x)); });
+  test_mdvector_expr<T>("md sigmoid " + type, T(-20), T(20), [](const auto& x) { return md::sigmoid(x); });
+  test_mdvector_expr<T>("md sigmoid<fast> " + type, T(-20), T(20),
+                        [](const auto& x) { return md::sigmoid<md::fast_math>(x); });
+
+  test_scalar_loop<T>("std erf " + type, T(-5), T(5), [](T x) { return std::erf(x); });
+  test_mdvector_expr<T>("md erf " + type, T(-5), T(5), [](const auto& x) { return md::erf(x); });
+  test_mdvector_expr<T>("md erf<fast> " + type, T(-5), T(5), [](const auto& x) { return md::erf<md::fast_math>(x); });
+
+  test_scalar_loop<T>("std softplus " + type, T(-20), T(20),
+                      [](T x) { return std::max(x, T(0)) + std::log1p(std::exp(-std::fabs(x))); });
+  test_mdvector_expr<T>("md softplus " + type, T(-20), T(20), [](const auto& x) { return md::softplus(x); });
+  test_mdvector_expr<T>("md softplus<fast> " + type, T(-20), T(20),
+                        [](const auto& x) { return md::softplus<md::fast_math>(x); });
+}
+
+void print_simd_type() {
+#if defined(USE_AVX2)
+  std::cout << "avx2...\n";
+
+#elif defined(USE_AVX512)
+  std::cout << "avx512...\n";
+
+#elif defined(USE_SSE)
+  std::cout << "sse...\n";
+
+#elif defined(USE_NEON)
+  std::cout << "neon...\n";
+
+#elif defined(USE_RVV)
+  std::cout << "risc_v...\n";
+
+#else
+  std::cout << "default avx2...\n";
+#endif
+}
+
+int main(int args, char* argv[]) {
+  print_simd_type();
+
+  std::cout << "activation accuracy\n";
+  test_all_accuracy<float>("f32");
+  test_all_accuracy<double>("f64");
+
+  for (const auto& test : all_test_points) {
+    loop = test.loop_;
+    dim1 = test.dim1_;
+    dim2 = test.dim2_;
+    total_element = test.total_element_;
+    total_cal = test.total_cal_;
+
+    std::cout << "2d matrix activation: " << dim1 << "*" << dim2 << "\n";
+
+    test_all<float>("f32");
+    test_all<double>("f64");
+  }
+  TimerRecorder::SaveSpeedResult("activation_speed_result.csv");
+  std::cout << "test complete" << std::endl;
+
+  return 0;
+}
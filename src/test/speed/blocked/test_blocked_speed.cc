@@ -0,0 +1,134 @@
+#include <iostream>
+#include <vector>
+using std::vector;
+
+//
+#include "src/mdvector/mdvector.h"
+#include "src/test/speed/common/time_cost.h"
+
+// 测试点
+vector<TestPoint> all_test_points = {TestPoint(100, 100), TestPoint(1000, 1000), TestPoint(4000, 2000)};
+
+// 防止结果被优化掉
+template <class T>
+void do_not_optimize(const T* p) {
+  volatile T sink = p[0];
+  (void)sink;
+}
+
+// ======================== 多语句 t = a * b; u = t + c; v = u * u - d ========================
+template <class T>
+void test_statements(const string& type) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> a_(test_shape);
+  mdvector_2d<T> b_(test_shape);
+  mdvector_2d<T> c_(test_shape);
+  mdvector_2d<T> d_(test_shape);
+  mdvector_2d<T> t_(test_shape);
+  mdvector_2d<T> u_(test_shape);
+  mdvector_2d<T> v_(test_shape);
+  for (size_t i = 0; i < total_element; i++) {
+    a_.begin()[i] = static_cast<T>(i % 97) * T(0.01);
+    b_.begin()[i] = static_cast<T>(i % 13) * T(0.1);
+    c_.begin()[i] = static_cast<T>(i % 7);
+    d_.begin()[i] = static_cast<T>(i % 3);
+  }
+
+  // 手写单循环 不写出t
+  {
+    TimerRecorder a("std loop fused " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      const T* pa = a_.cbegin();
+      const T* pb = b_.cbegin();
+      const T* pc = c_.cbegin();
+      const T* pd = d_.cbegin();
+      T* pu = u_.begin();
+      T* pv = v_.begin();
+      for (size_t i = 0; i < total_element; i++) {
+        const T u = pa[i] * pb[i] + pc[i];
+        pu[i] = u;
+        pv[i] = u * u - pd[i];
+      }
+      do_not_optimize(pv);
+    }
+  }
+  do_not_optimize(v_.begin());
+
+  // 逐条求值 每条语句完整遍历一次
+  {
+    TimerRecorder a("md t = ...; u = ...; v = ... " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      t_ = a_ * b_;
+      u_ = t_ + c_;
+      v_ = u_ * u_ - d_;
+    }
+  }
+  do_not_optimize(v_.begin());
+
+  // 分块求值 t为完整数组
+  {
+    auto step = md::blocked(md::stmt(t_, a_ * b_), md::stmt(u_, t_ + c_), md::stmt(v_, u_ * u_ - d_));
+    TimerRecorder a("md blocked (t mdvector) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      step.eval();
+    }
+  }
+  do_not_optimize(v_.begin());
+
+  // 分块求值 t只保留一个块
+  md::scratch<T, 2> t(test_shape);
+  for (size_t tile : {size_t(256), md::blocked_tile_size, size_t(4096)}) {
+    auto step = md::blocked(md::stmt(t, a_ * b_), md::stmt(u_, t + c_), md::stmt(v_, u_ * u_ - d_));
+    TimerRecorder a("md blocked (t scratch, tile " + to_string(tile) + ") " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      step.eval(tile);
+    }
+  }
+  do_not_optimize(v_.begin());
+}
+
+void print_simd_type() {
+#if defined(USE_AVX2)
+  std::cout << "avx2...\n";
+
+#elif defined(USE_AVX512)
+  std::cout << "avx512...\n";
+
+#elif defined(USE_SSE)
+  std::cout << "sse...\n";
+
+#elif defined(USE_NEON)
+  std::cout << "neon...\n";
+
+#elif defined(USE_RVV)
+  std::cout << "risc_v...\n";
+
+#else
+  std::cout << "default avx2...\n";
+#endif
+}
+
+int main(int args, char* argv[]) {
+  print_simd_type();
+
+  for (const auto& test : all_test_points) {
+    loop = test.loop_;
+    dim1 = test.dim1_;
+    dim2 = test.dim2_;
+    total_element = test.total_element_;
+    total_cal = test.total_cal_;
+
+    std::cout << "2d blocked multi-statement evaluation: " << dim1 << "*" << dim2 << "\n";
+
+    test_statements<float>("f32");
+    test_statements<double>("f64");
+  }
+  TimerRecorder::SaveSpeedResult("blocked_speed_result.csv");
+  std::cout << "test complete" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,163 @@
+#include <iostream>
+#include <vector>
+using std::vector;
+
+//
+#include "src/mdvector/mdvector.h"
+#include "src/test/speed/common/time_cost.h"
+
+// 测试点
+vector<TestPoint> all_test_points = {TestPoint(100, 100), TestPoint(1000, 1000), TestPoint(10000, 37)};
+
+// 防止结果被优化掉
+template <class T>
+void do_not_optimize(const T* p) {
+  volatile T sink = p[0];
+  (void)sink;
+}
+
+// ======================== 行向量偏置 (dim1, dim2) + (dim2) ========================
+template <class T>
+void test_row_bias(const string& type) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> data1_(test_shape);
+  mdvector_2d<T> data3_(test_shape);
+  mdvector_2d<T> expanded_(test_shape);
+  mdvector_1d<T> bias_({dim2});
+  for (size_t i = 0; i < total_element; i++) data1_.begin()[i] = static_cast<T>(i % 97);
+  for (size_t j = 0; j < dim2; j++) bias_(j) = static_cast<T>(j);
+
+  // 标量双层循环
+  {
+    TimerRecorder a("std loop m + row " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      for (size_t i = 0; i < dim1; i++) {
+        for (size_t j = 0; j < dim2; j++) {
+          data3_(i, j) = data1_(i, j) + bias_(j);
+        }
+      }
+    }
+  }
+  do_not_optimize(data3_.begin());
+
+  // 每次先展开为完整矩阵再相加
+  {
+    TimerRecorder a("md expand + add " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      for (size_t i = 0; i < dim1; i++) {
+        std::copy(bias_.begin(), bias_.end(), expanded_.begin() + i * dim2);
+      }
+      data3_ = data1_ + expanded_;
+    }
+  }
+  do_not_optimize(data3_.begin());
+
+  // 已展开的完整矩阵 仅计入相加
+  {
+    TimerRecorder a("md m + expanded " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      data3_ = data1_ + expanded_;
+    }
+  }
+  do_not_optimize(data3_.begin());
+
+  // 广播
+  {
+    TimerRecorder a("md m + row " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      data3_ = data1_ + bias_;
+    }
+  }
+  do_not_optimize(data3_.begin());
+}
+
+// ======================== 列向量 (dim1, dim2) * (dim1, 1) ========================
+template <class T>
+void test_col_scale(const string& type) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> data1_(test_shape);
+  mdvector_2d<T> data3_(test_shape);
+  mdvector_2d<T> scale_({dim1, 1});
+  for (size_t i = 0; i < total_element; i++) data1_.begin()[i] = static_cast<T>(i % 97);
+  for (size_t i = 0; i < dim1; i++) scale_(i, 0) = static_cast<T>(i % 7 + 1);
+
+  {
+    TimerRecorder a("std loop m * col " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      for (size_t i = 0; i < dim1; i++) {
+        for (size_t j = 0; j < dim2; j++) {
+          data3_(i, j) = data1_(i, j) * scale_(i, 0);
+        }
+      }
+    }
+  }
+  do_not_optimize(data3_.begin());
+
+  {
+    TimerRecorder a("md m * col " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      data3_ = data1_ * md::broadcast_to(scale_, test_shape);
+    }
+  }
+  do_not_optimize(data3_.begin());
+
+  // 同秩自动广播 列向量每次求值前展开到节点缓冲区
+  {
+    TimerRecorder a("md m * col auto " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      data3_ = data1_ * scale_;
+    }
+  }
+  do_not_optimize(data3_.begin());
+}
+
+void print_simd_type() {
+#if defined(USE_AVX2)
+  std::cout << "avx2...\n";
+
+#elif defined(USE_AVX512)
+  std::cout << "avx512...\n";
+
+#elif defined(USE_SSE)
+  std::cout << "sse...\n";
+
+#elif defined(USE_NEON)
+  std::cout << "neon...\n";
+
+#elif defined(USE_RVV)
+  std::cout << "risc_v...\n";
+
+#else
+  std::cout << "default avx2...\n";
+#endif
+}
+
+int main(int args, char* argv[]) {
+  print_simd_type();
+
+  for (const auto& test : all_test_points) {
+    loop = test.loop_;
+    dim1 = test.dim1_;
+    dim2 = test.dim2_;
+    total_element = test.total_element_;
+    total_cal = test.total_cal_;
+
+    std::cout << "2d matrix broadcast: " << dim1 << "*" << dim2 << "\n";
+
+    test_row_bias<float>("f32");
+    test_row_bias<double>("f64");
+    test_col_scale<float>("f32");
+    test_col_scale<double>("f64");
+  }
+  TimerRecorder::SaveSpeedResult("broadcast_speed_result.csv");
+  std::cout << "test complete" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,34 @@
+#ifndef __TEST_SET_H__
+#define __TEST_SET_H__
+
+#include <iostream>
+#include <vector>
+
+using std::vector;
+
+// 每个测试点默认共计算的元素个数
+constexpr size_t default_points = 1E8;
+
+struct TestPoint {
+  TestPoint(size_t dim1, size_t dim2, size_t points = default_points) : dim1_(dim1), dim2_(dim2) {
+    total_element_ = dim1 * dim2;
+    loop_ = points / total_element_;
+    total_cal_ = points;
+  }
+
+  size_t loop_;
+  size_t dim1_;
+  size_t dim2_;
+  size_t total_element_;
+  size_t total_cal_;
+};
+
+// 各性能测试共用本文件与time_cost.h 测试点由各测试自行定义
+extern vector<TestPoint> all_test_points;
+
+size_t loop;
+size_t dim1;
+size_t dim2;
+size_t total_element;
+size_t total_cal;
+#endif  // __TEST_SET_H__
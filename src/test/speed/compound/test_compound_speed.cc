@@ -0,0 +1,163 @@
+#include <iostream>
+#include <vector>
+using std::vector;
+
+//
+#include "src/mdvector/mdvector.h"
+#include "src/test/speed/common/time_cost.h"
+
+// 测试点
+vector<TestPoint> all_test_points = {TestPoint(100, 100), TestPoint(1000, 1000), TestPoint(10000, 37)};
+
+// 防止结果被优化掉
+template <class T>
+void do_not_optimize(const T* p) {
+  volatile T sink = p[0];
+  (void)sink;
+}
+
+// ======================== axpy型更新 a += b * c ========================
+template <class T>
+void test_axpy(const string& type) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> data1_(test_shape);
+  mdvector_2d<T> data2_(test_shape);
+  mdvector_2d<T> data3_(test_shape);
+  mdvector_2d<T> temp_(test_shape);
+  for (size_t i = 0; i < total_element; i++) {
+    data1_.begin()[i] = 0;
+    data2_.begin()[i] = static_cast<T>(i % 97) * T(0.01);
+    data3_.begin()[i] = static_cast<T>(i % 13) * T(0.001);
+  }
+
+  // 标量循环
+  {
+    TimerRecorder a("std loop a += b * c " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      T* a_ = data1_.begin();
+      const T* b_ = data2_.cbegin();
+      const T* c_ = data3_.cbegin();
+      for (size_t i = 0; i < total_element; i++) {
+        a_[i] += b_[i] * c_[i];
+      }
+      // 阻止编译器交换内外层循环(a_[i]留在寄存器中累加loop次)
+      do_not_optimize(a_);
+    }
+  }
+  do_not_optimize(data1_.begin());
+
+  // 先求出临时数组再复合赋值 两次遍历
+  {
+    TimerRecorder a("md temp = b * c; a += temp " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      temp_ = data2_ * data3_;
+      data1_ += temp_;
+    }
+  }
+  do_not_optimize(data1_.begin());
+
+  {
+    TimerRecorder a("md a = a + b * c " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      data1_ = data1_ + data2_ * data3_;
+    }
+  }
+  do_not_optimize(data1_.begin());
+
+  // 单次遍历读-改-写
+  {
+    TimerRecorder a("md a += b * c " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      data1_ += data2_ * data3_;
+    }
+  }
+  do_not_optimize(data1_.begin());
+}
+
+// ======================== 多输出 u1 = u + dt * f; v1 = v - dt * f ========================
+template <class T>
+void test_multi_output(const string& type) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> u_(test_shape);
+  mdvector_2d<T> v_(test_shape);
+  mdvector_2d<T> f_(test_shape);
+  mdvector_2d<T> u1_(test_shape);
+  mdvector_2d<T> v1_(test_shape);
+  for (size_t i = 0; i < total_element; i++) {
+    u_.begin()[i] = static_cast<T>(i % 97);
+    v_.begin()[i] = static_cast<T>(i % 89);
+    f_.begin()[i] = static_cast<T>(i % 13) * T(0.1);
+  }
+  const T dt = T(0.01);
+
+  // 两次独立遍历 f读取两次
+  {
+    TimerRecorder a("md u1 = ...; v1 = ... " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      u1_ = u_ + dt * f_;
+      v1_ = v_ - dt * f_;
+    }
+  }
+  do_not_optimize(u1_.begin());
+  do_not_optimize(v1_.begin());
+
+  // 单次遍历
+  {
+    TimerRecorder a("md assign(tie(u1, v1), ...) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      md::assign(md::tie(u1_, v1_), u_ + dt * f_, v_ - dt * f_);
+    }
+  }
+  do_not_optimize(u1_.begin());
+  do_not_optimize(v1_.begin());
+}
+
+void print_simd_type() {
+#if defined(USE_AVX2)
+  std::cout << "avx2...\n";
+
+#elif defined(USE_AVX512)
+  std::cout << "avx512...\n";
+
+#elif defined(USE_SSE)
+  std::cout << "sse...\n";
+
+#elif defined(USE_NEON)
+  std::cout << "neon...\n";
+
+#elif defined(USE_RVV)
+  std::cout << "risc_v...\n";
+
+#else
+  std::cout << "default avx2...\n";
+#endif
+}
+
+int main(int args, char* argv[]) {
+  print_simd_type();
+
+  for (const auto& test : all_test_points) {
+    loop = test.loop_;
+    dim1 = test.dim1_;
+    dim2 = test.dim2_;
+    total_element = test.total_element_;
+    total_cal = test.total_cal_;
+
+    std::cout << "2d compound / multi-output assignment: " << dim1 << "*" << dim2 << "\n";
+
+    test_axpy<float>("f32");
+    test_axpy<double>("f64");
+    test_multi_output<float>("f32");
+    test_multi_output<double>("f64");
+  }
+  TimerRecorder::SaveSpeedResult("compound_speed_result.csv");
+  std::cout << "test complete" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <vector>
+using std::vector;
+
+//
+#include "src/mdvector/mdvector.h"
+#include "src/test/speed/common/time_cost.h"
+
+// 测试点
+vector<TestPoint> all_test_points = {TestPoint(100, 100), TestPoint(1000, 1000), TestPoint(10000, 37)};
+
+// 防止结果被优化掉
+template <class T>
+void do_not_optimize(const T* p) {
+  volatile T sink = p[0];
+  (void)sink;
+}
+
+// 保存的表达式在另一函数中求值 编译器看不到其构造 无法合并相同的子树(如求解器结构体中保存的表达式)
+template <class E, class R>
+MD_NOINLINE void eval_stored(const E& e, R& r) {
+  r = e;
+}
+
+// ======================== (a + b) * (a + b) - c / (a + b) ========================
+template <class T>
+void test_sum_reuse(const string& type) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> a_(test_shape);
+  mdvector_2d<T> b_(test_shape);
+  mdvector_2d<T> c_(test_shape);
+  mdvector_2d<T> r_(test_shape);
+  for (size_t i = 0; i < total_element; i++) {
+    a_.begin()[i] = static_cast<T>(i % 97) * T(0.01);
+    b_.begin()[i] = static_cast<T>(i % 13) * T(0.1) + T(1);
+    c_.begin()[i] = static_cast<T>(i % 7);
+  }
+
+  {
+    TimerRecorder a("std loop " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      const T* pa = a_.cbegin();
+      const T* pb = b_.cbegin();
+      const T* pc = c_.cbegin();
+      T* pr = r_.begin();
+      for (size_t i = 0; i < total_element; i++) {
+        const T s = pa[i] + pb[i];
+        pr[i] = s * s - pc[i] / s;
+      }
+      do_not_optimize(pr);
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  // 三个(a + b)节点各自求值
+  {
+    TimerRecorder a("md (a + b) * (a + b) - c / (a + b) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      r_ = (a_ + b_) * (a_ + b_) - c_ / (a_ + b_);
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  {
+    TimerRecorder a("md let(a + b) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      r_ = md::let(a_ + b_, [&](auto s) { return s * s - c_ / s; });
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  {
+    const auto e = (a_ + b_) * (a_ + b_) - c_ / (a_ + b_);
+    TimerRecorder a("md stored (a + b) * (a + b) - c / (a + b) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      eval_stored(e, r_);
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  {
+    const auto e = md::let(a_ + b_, [&](auto s) { return s * s - c_ / s; });
+    TimerRecorder a("md stored let(a + b) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      eval_stored(e, r_);
+    }
+  }
+  do_not_optimize(r_.begin());
+}
+
+// ======================== e = exp(-a * b) 使用三次 ========================
+template <class T>
+void test_exp_reuse(const string& type) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> a_(test_shape);
+  mdvector_2d<T> b_(test_shape);
+  mdvector_2d<T> c_(test_shape);
+  mdvector_2d<T> r_(test_shape);
+  for (size_t i = 0; i < total_element; i++) {
+    a_.begin()[i] = static_cast<T>(i % 97) * T(0.01);
+    b_.begin()[i] = static_cast<T>(i % 13) * T(0.1);
+    c_.begin()[i] = static_cast<T>(i % 7);
+  }
+
+  {
+    TimerRecorder a("md exp(-a * b) * c + exp(-a * b) * exp(-a * b) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      r_ = md::exp(-a_ * b_) * c_ + md::exp(-a_ * b_) * md::exp(-a_ * b_);
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  {
+    TimerRecorder a("md let(exp(-a * b)) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      r_ = md::let(md::exp(-a_ * b_), [&](auto e) { return e * c_ + e * e; });
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  {
+    const auto e = md::exp(-a_ * b_) * c_ + md::exp(-a_ * b_) * md::exp(-a_ * b_);
+    TimerRecorder a("md stored exp(-a * b) * c + ... " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      eval_stored(e, r_);
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  {
+    const auto e = md::let(md::exp(-a_ * b_), [&](auto e) { return e * c_ + e * e; });
+    TimerRecorder a("md stored let(exp(-a * b)) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      eval_stored(e, r_);
+    }
+  }
+  do_not_optimize(r_.begin());
+}
+
+void print_simd_type() {
+#if defined(USE_AVX2)
+  std::cout << "avx2...\n";
+
+#elif defined(USE_AVX512)
+  std::cout << "avx512...\n";
+
+#elif defined(USE_SSE)
+  std::cout << "sse...\n";
+
+#elif defined(USE_NEON)
+  std::cout << "neon...\n";
+
+#elif defined(USE_RVV)
+  std::cout << "risc_v...\n";
+
+#else
+  std::cout << "default avx2...\n";
+#endif
+}
+
+int main(int args, char* argv[]) {
+  print_simd_type();
+
+  for (const auto& test : all_test_points) {
+    loop = test.loop_;
+    dim1 = test.dim1_;
+    dim2 = test.dim2_;
+    total_element = test.total_element_;
+    total_cal = test.total_cal_;
+
+    std::cout << "2d common subexpression: " << dim1 << "*" << dim2 << "\n";
+
+    test_sum_reuse<float>("f32");
+    test_sum_reuse<double>("f64");
+    test_exp_reuse<float>("f32");
+    test_exp_reuse<double>("f64");
+  }
+  TimerRecorder::SaveSpeedResult("let_speed_result.csv");
+  std::cout << "test complete" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+using std::vector;
+
+//
+#include "src/mdvector/mdvector.h"
+#include "src/test/speed/common/time_cost.h"
+
+// 测试点
+vector<TestPoint> all_test_points = {TestPoint(1, 10), TestPoint(10, 100), TestPoint(100, 100), TestPoint(1000, 1000)};
+
+// 防止结果被优化掉
+template <class T>
+void do_not_optimize(const T* p) {
+  volatile T sink = p[0];
+  (void)sink;
+}
+
+// ======================== 标量循环 ========================
+template <class T, class Func>
+void test_scalar_loop(const string& name, T lo, T hi, Func func) {
+  vector<T> data1_(total_element);
+  vector<T> data3_(total_element);
+  for (size_t i = 0; i < total_element; i++) {
+    data1_[i] = lo + (hi - lo) * static_cast<T>(i) / static_cast<T>(total_element);
+  }
+
+  {
+    TimerRecorder a(name);
+
+    size_t k = 0;
+    while (k++ < loop) {
+      for (size_t i = 0; i < total_element; i++) {
+        data3_[i] = func(data1_[i]);
+      }
+    }
+  }
+  do_not_optimize(data3_.data());
+}
+
+// ======================== mdvector表达式 ========================
+template <class T, class Func>
+void test_mdvector_expr(const string& name, T lo, T hi, Func func) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> data1_(test_shape);
+  mdvector_2d<T> data3_(test_shape);
+  for (size_t i = 0; i < total_element; i++) {
+    data1_.begin()[i] = lo + (hi - lo) * static_cast<T>(i) / static_cast<T>(total_element);
+  }
+
+  {
+    TimerRecorder a(name);
+
+    size_t k = 0;
+    while (k++ < loop) {
+      data3_ = func(data1_);
+    }
+  }
+  do_not_optimize(data3_.begin());
+}
+
+template <class T>
+void test_all(const string& type) {
+  test_scalar_loop<T>("std exp " + type, T(-50), T(50), [](T x) { return std::exp(x); });
+  test_mdvector_expr<T>("md exp " + type, T(-50), T(50), [](const auto& x) { return md::exp(x); });
+
+  test_scalar_loop<T>("std log " + type, T(1e-3), T(1e3), [](T x) { return std::log(x); });
+  test_mdvector_expr<T>("md log " + type, T(1e-3), T(1e3), [](const auto& x) { return md::log(x); });
+
+  test_scalar_loop<T>("std sin " + type, T(-100), T(100), [](T x) { return std::sin(x); });
+  test_mdvector_expr<T>("md sin " + type, T(-100), T(100), [](const auto& x) { return md::sin(x); });
+
+  test_scalar_loop<T>("std cos " + type, T(-100), T(100), [](T x) { return std::cos(x); });
+  test_mdvector_expr<T>("md cos " + type, T(-100), T(100), [](const auto& x) { return md::cos(x); });
+
+  test_scalar_loop<T>("std tan " + type, T(-10), T(10), [](T x) { return std::tan(x); });
+  test_mdvector_expr<T>("md tan " + type, T(-10), T(10), [](const auto& x) { return md::tan(x); });
+
+  test_scalar_loop<T>("std atan2 " + type, T(-100), T(100), [](T x) { return std::atan2(x, T(1.5)); });
+  test_mdvector_expr<T>("md atan2 " + type, T(-100), T(100), [](const auto& x) { return md::atan2(x, T(1.5)); });
+
+  test_scalar_loop<T>("std pow " + type, T(0), T(100), [](T x) { return std::pow(x, T(2.5)); });
+  test_mdvector_expr<T>("md pow " + type, T(0), T(100), [](const auto& x) { return md::pow(x, T(2.5)); });
+
+  test_scalar_loop<T>("std pow3 " + type, T(-10), T(10), [](T x) { return std::pow(x, T(3)); });
+  test_mdvector_expr<T>("md pow(x,3) " + type, T(-10), T(10), [](const auto& x) { return md::pow(x, T(3)); });
+  test_mdvector_expr<T>("md pow<3> " + type, T(-10), T(10), [](const auto& x) { return md::pow<3>(x); });
+
+  test_scalar_loop<T>("std 1.7 / x " + type, T(1), T(100), [](T x) { return T(1.7) / x; });
+  test_mdvector_expr<T>("md 1.7 / x " + type, T(1), T(100), [](const auto& x) { return T(1.7) / x; });
+  test_mdvector_expr<T>("md div<fast>(1.7, x) " + type, T(1), T(100),
+                        [](const auto& x) { return md::div<md::fast_math>(T(1.7), x); });
+  test_mdvector_expr<T>("md x * 3 " + type, T(1), T(100), [](const auto& x) { return x * T(3); });
+  test_mdvector_expr<T>("md x / 3 " + type, T(1), T(100), [](const auto& x) { return x / T(3); });
+
+  // 6次/10次标定多项式 系数最高次项在前
+  static constexpr T c6[] = {T(1.2e-5), T(-3.1e-4), T(2.7e-3), T(-1.1e-2), T(0.21), T(1.3), T(0.05)};
+  static constexpr T c10[] = {T(2.1e-9), T(-4.3e-8), T(3.9e-7), T(-2.2e-6), T(1.2e-5), T(-3.1e-4),
+                              T(2.7e-3), T(-1.1e-2), T(0.21),   T(1.3),     T(0.05)};
+  auto horner = [](T x, const auto& c) {
+    T r = c[0];
+    for (size_t k = 1; k < std::size(c); ++k) r = r * x + c[k];
+    return r;
+  };
+  test_scalar_loop<T>("std horner deg6 " + type, T(0), T(10), [&](T x) { return horner(x, c6); });
+  test_mdvector_expr<T>("md polyval deg6 " + type, T(0), T(10), [](const auto& x) { return md::polyval(x, c6); });
+  test_mdvector_expr<T>("md polyval<estrin> deg6 " + type, T(0), T(10),
+                        [](const auto& x) { return md::polyval<md::estrin>(x, c6); });
+  test_scalar_loop<T>("std horner deg10 " + type, T(0), T(10), [&](T x) { return horner(x, c10); });
+  test_mdvector_expr<T>("md polyval deg10 " + type, T(0), T(10), [](const auto& x) { return md::polyval(x, c10); });
+  test_mdvector_expr<T>("md polyval<estrin> deg10 " + type, T(0), T(10),
+                        [](const auto& x) { return md::polyval<md::estrin>(x, c10); });
+}
+
+void print_simd_type() {
+#if defined(USE_AVX2)
+  std::cout << "avx2...\n";
+
+#elif defined(USE_AVX512)
+  std::cout << "avx512...\n";
+
+#elif defined(USE_SSE)
+  std::cout << "sse...\n";
+
+#elif defined(USE_NEON)
+  std::cout << "neon...\n";
+
+#elif defined(USE_RVV)
+  std::cout << "risc_v...\n";
+
+#else
+  std::cout << "default avx2...\n";
+#endif
+}
+
+int main(int args, char* argv[]) {
+  print_simd_type();
+
+  for (const auto& test : all_test_points) {
+    loop = test.loop_;
+    dim1 = test.dim1_;
+    dim2 = test.dim2_;
+    total_element = test.total_element_;
+    total_cal = test.total_cal_;
+
+    std::cout << "2d matrix function: " << dim1 << "*" << dim2 << "\n";
+
+    test_all<float>("f32");
+    test_all<double>("f64");
+  }
+  TimerRecorder::SaveSpeedResult("math_speed_result.csv");
+  std::cout << "test complete" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+#include <iostream>
+#include <vector>
+using std::vector;
+
+//
+#include "src/mdvector/mdvector.h"
+#include "src/test/speed/common/time_cost.h"
+
+// 测试点
+vector<TestPoint> all_test_points = {TestPoint(100, 100), TestPoint(1000, 1000), TestPoint(10000, 37)};
+
+// 防止结果被优化掉
+template <class T>
+void do_not_optimize(const T* p) {
+  volatile T sink = p[0];
+  (void)sink;
+}
+
+// ======================== 同一数组中错开一行的子视图 ========================
+template <class T>
+void test_shifted_rows(const string& type) {
+  mdshape_2d test_shape = {dim1 + 1, dim2};
+  mdvector_2d<T> field_(test_shape);
+  mdvector_2d<T> other_(test_shape);
+  mdvector_2d<T> temp_({dim1, dim2});
+  for (size_t i = 0; i < field_.size(); i++) {
+    field_.begin()[i] = static_cast<T>(i % 97) * T(0.01);
+    other_.begin()[i] = static_cast<T>(i % 13) * T(0.1);
+  }
+  const long long last = static_cast<long long>(dim1);
+  auto upper = field_.create_subspan(md::slice(0, last - 1), md::all());
+  auto lower = field_.create_subspan(md::slice(1, last), md::all());
+  auto disjoint = other_.create_subspan(md::slice(0, last - 1), md::all());
+  auto middle = field_.create_subspan(md::slice(1, last - 1), md::all());
+  auto above = field_.create_subspan(md::slice(0, last - 2), md::all());
+  auto below = field_.create_subspan(md::slice(2, last), md::all());
+
+  // 调用方防御性复制 每次都经过临时数组
+  {
+    TimerRecorder a("md temp = upper * 0.5 + lower; lower = temp " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      temp_ = upper * T(0.5) + lower;
+      lower = temp_;
+    }
+  }
+  do_not_optimize(field_.begin());
+
+  // 操作数在目标之前 库内反向求值
+  {
+    TimerRecorder a("md lower = upper * 0.5 + lower " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      lower = upper * T(0.5) + lower;
+    }
+  }
+  do_not_optimize(field_.begin());
+
+  // 操作数分别在目标之前与之后 库内经临时缓冲区
+  {
+    TimerRecorder a("md middle = above * 0.5 + below " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      middle = above * T(0.5) + below;
+    }
+  }
+  do_not_optimize(field_.begin());
+
+  // 不相交 直接写回
+  {
+    TimerRecorder a("md lower = disjoint * 0.5 + lower " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      lower = disjoint * T(0.5) + lower;
+    }
+  }
+  do_not_optimize(field_.begin());
+}
+
+void print_simd_type() {
+#if defined(USE_AVX2)
+  std::cout << "avx2...\n";
+
+#elif defined(USE_AVX512)
+  std::cout << "avx512...\n";
+
+#elif defined(USE_SSE)
+  std::cout << "sse...\n";
+
+#elif defined(USE_NEON)
+  std::cout << "neon...\n";
+
+#elif defined(USE_RVV)
+  std::cout << "risc_v...\n";
+
+#else
+  std::cout << "default avx2...\n";
+#endif
+}
+
+int main(int args, char* argv[]) {
+  print_simd_type();
+
+  for (const auto& test : all_test_points) {
+    loop = test.loop_;
+    dim1 = test.dim1_;
+    dim2 = test.dim2_;
+    total_element = test.total_element_;
+    total_cal = test.total_cal_;
+
+    std::cout << "2d overlapping subspan assignment: " << dim1 << "*" << dim2 << "\n";
+
+    test_shifted_rows<float>("f32");
+    test_shifted_rows<double>("f64");
+  }
+  TimerRecorder::SaveSpeedResult("overlap_speed_result.csv");
+  std::cout << "test complete" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <numeric>
+#include <vector>
+using std::vector;
+
+//
+#include "src/mdvector/mdvector.h"
+#include "src/test/speed/common/time_cost.h"
+
+// 测试点
+vector<TestPoint> all_test_points = {TestPoint(1, 10), TestPoint(10, 100), TestPoint(100, 100), TestPoint(1000, 1000),
+                                     TestPoint(1000, 10000)};
+
+// 防止结果被优化掉
+template <class T>
+void do_not_optimize(T v) {
+  volatile T sink = v;
+  (void)sink;
+}
+
+// ======================== 标量循环 ========================
+template <class T>
+void test_std_accumulate(const string& name) {
+  vector<T> data1_(total_element, T(0.1));
+  T res = 0;
+  {
+    TimerRecorder a(name);
+
+    size_t k = 0;
+    while (k++ < loop) {
+      res += std::accumulate(data1_.begin(), data1_.end(), T(0));
+    }
+  }
+  do_not_optimize(res);
+}
+
+// ======================== mdvector归约 ========================
+template <class T, class Accum>
+void test_md_sum(const string& name, Accum accum) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> data1_(test_shape);
+  data1_.set_value(T(0.1));
+  T res = 0;
+  {
+    TimerRecorder a(name);
+
+    size_t k = 0;
+    while (k++ < loop) {
+      res += md::sum(data1_, accum);
+    }
+  }
+  do_not_optimize(res);
+}
+
+template <class T>
+void test_md_dot(const string& name) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> data1_(test_shape);
+  mdvector_2d<T> data2_(test_shape);
+  data1_.set_value(T(0.1));
+  data2_.set_value(T(0.2));
+  T res = 0;
+  {
+    TimerRecorder a(name);
+
+    size_t k = 0;
+    while (k++ < loop) {
+      res += md::dot(data1_, data2_);
+    }
+  }
+  do_not_optimize(res);
+}
+
+template <class T>
+void test_all(const string& type) {
+  test_std_accumulate<T>("std accumulate " + type);
+  test_md_sum<T>("md sum plain " + type, md::plain_sum);
+  test_md_sum<T>("md sum pairwise " + type, md::pairwise_sum);
+  test_md_sum<T>("md sum kahan " + type, md::kahan_sum);
+  test_md_dot<T>("md dot " + type);
+}
+
+void print_simd_type() {
+#if defined(USE_AVX2)
+  std::cout << "avx2...\n";
+
+#elif defined(USE_AVX512)
+  std::cout << "avx512...\n";
+
+#elif defined(USE_SSE)
+  std::cout << "sse...\n";
+
+#elif defined(USE_NEON)
+  std::cout << "neon...\n";
+
+#elif defined(USE_RVV)
+  std::cout << "risc_v...\n";
+
+#else
+  std::cout << "default avx2...\n";
+#endif
+}
+
+int main(int args, char* argv[]) {
+  print_simd_type();
+
+  for (const auto& test : all_test_points) {
+    loop = test.loop_;
+    dim1 = test.dim1_;
+    dim2 = test.dim2_;
+    total_element = test.total_element_;
+    total_cal = test.total_cal_;
+
+    std::cout << "2d matrix reduction: " << dim1 << "*" << dim2 << "\n";
+
+    test_all<float>("f32");
+    test_all<double>("f64");
+  }
+  TimerRecorder::SaveSpeedResult("reduce_speed_result.csv");
+  std::cout << "test complete" << std::endl;
+
+  return 0;
+}
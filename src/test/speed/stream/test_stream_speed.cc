@@ -0,0 +1,99 @@
+#include <iostream>
+#include <vector>
+using std::vector;
+
+//
+#include "src/mdvector/mdvector.h"
+#include "src/test/speed/common/time_cost.h"
+
+// 测试点
+vector<TestPoint> all_test_points = {TestPoint(1000, 1000), TestPoint(4000, 4000), TestPoint(10000, 10000)};
+
+// 防止结果被优化掉
+template <class T>
+void do_not_optimize(const T* p) {
+  volatile T sink = p[0];
+  (void)sink;
+}
+
+// ======================== 只写输出 r = a * 1.5 + 0.5 ========================
+// 普通存储先把目标缓存行读入缓存再写回 流式存储省去这次读取
+template <class T>
+void test_write_only(const string& type) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> a_(test_shape);
+  mdvector_2d<T> r_(test_shape);
+  for (size_t i = 0; i < a_.size(); i++) {
+    a_.begin()[i] = static_cast<T>(i % 97) * T(0.01);
+  }
+
+  {
+    TimerRecorder a("md r = a * 1.5 + 0.5 (aligned store) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      (a_ * T(1.5) + T(0.5)).template eval_to<AlignedPolicy>(r_.begin());
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  {
+    TimerRecorder a("md r = a * 1.5 + 0.5 (stream store) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      (a_ * T(1.5) + T(0.5)).template eval_to<StreamPolicy>(r_.begin());
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  // 按md::stream_threshold自动选择
+  {
+    TimerRecorder a("md r = a * 1.5 + 0.5 (auto) " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      r_ = a_ * T(1.5) + T(0.5);
+    }
+  }
+  do_not_optimize(r_.begin());
+}
+
+void print_simd_type() {
+#if defined(USE_AVX2)
+  std::cout << "avx2...\n";
+
+#elif defined(USE_AVX512)
+  std::cout << "avx512...\n";
+
+#elif defined(USE_SSE)
+  std::cout << "sse...\n";
+
+#elif defined(USE_NEON)
+  std::cout << "neon...\n";
+
+#elif defined(USE_RVV)
+  std::cout << "risc_v...\n";
+
+#else
+  std::cout << "default avx2...\n";
+#endif
+}
+
+int main(int args, char* argv[]) {
+  print_simd_type();
+
+  for (const auto& test : all_test_points) {
+    loop = test.loop_;
+    dim1 = test.dim1_;
+    dim2 = test.dim2_;
+    total_element = test.total_element_;
+    total_cal = test.total_cal_;
+
+    std::cout << "2d write-only output: " << dim1 << "*" << dim2 << "\n";
+
+    test_write_only<float>("f32");
+    test_write_only<double>("f64");
+  }
+  TimerRecorder::SaveSpeedResult("stream_speed_result.csv");
+  std::cout << "test complete" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,147 @@
+#include <iostream>
+#include <vector>
+using std::vector;
+
+//
+#include "src/mdvector/mdvector.h"
+#include "src/test/speed/common/time_cost.h"
+
+// 测试点
+constexpr size_t points = 1E9;
+vector<TestPoint> all_test_points = {TestPoint(1, 10, points), TestPoint(1, 50, points), TestPoint(2, 60, points),
+                                     TestPoint(3, 70, points), TestPoint(5, 100, points), TestPoint(10, 100, points),
+                                     TestPoint(100, 100, points)};
+
+// 防止结果被优化掉
+template <class T>
+void do_not_optimize(const T* p) {
+  volatile T sink = p[0];
+  (void)sink;
+}
+
+// 未展开的对照 每次循环一个pack
+template <class T>
+void simd_add_single(const T* __restrict a, const T* __restrict b, T* __restrict c, const size_t n) {
+  constexpr size_t pack_size = simd<T>::pack_size;
+
+  size_t i = 0;
+  for (; i + pack_size <= n; i += pack_size) {
+    const typename simd<T>::type va = AlignedPolicy::template load<T>(a + i);
+    const typename simd<T>::type vb = AlignedPolicy::template load<T>(b + i);
+    AlignedPolicy::template store<T>(c + i, simd<T>::add(va, vb));
+  }
+
+  const size_t remaining = n - i;
+  const typename simd<T>::type va = AlignedPolicy::template mask_load<T>(a + i, remaining);
+  const typename simd<T>::type vb = AlignedPolicy::template mask_load<T>(b + i, remaining);
+  AlignedPolicy::template mask_store<T>(c + i, remaining, simd<T>::add(va, vb));
+}
+
+template <class T, class E>
+void eval_to_single(const E& expr, T* dest) {
+  constexpr size_t pack_size = simd<T>::pack_size;
+  const size_t n = expr.size();
+  expr.prepare();
+
+  size_t i = 0;
+  for (; i + pack_size <= n; i += pack_size) {
+    AlignedPolicy::template store<T>(dest + i, expr.template eval_simd<T>(i));
+  }
+
+  if (i < n) {
+    AlignedPolicy::template mask_store<T>(dest + i, n - i, expr.template eval_simd_mask<T>(i));
+  }
+}
+
+// ======================== 展开与未展开对照 ========================
+template <class T>
+void test_unroll(const string& type) {
+  mdshape_2d test_shape = {dim1, dim2};
+  mdvector_2d<T> a_(test_shape);
+  mdvector_2d<T> b_(test_shape);
+  mdvector_2d<T> c_(test_shape);
+  mdvector_2d<T> r_(test_shape);
+  for (size_t i = 0; i < a_.size(); i++) {
+    a_.begin()[i] = static_cast<T>(i % 97) * T(0.01);
+    b_.begin()[i] = static_cast<T>(i % 13) * T(0.1);
+    c_.begin()[i] = static_cast<T>(i % 7);
+  }
+
+  {
+    TimerRecorder a("simd_add single pack " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      simd_add_single<T>(a_.begin(), b_.begin(), r_.begin(), total_element);
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  {
+    TimerRecorder a("simd_add unrolled " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      simd_add<T, AlignedPolicy>(a_.begin(), b_.begin(), r_.begin(), total_element);
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  {
+    TimerRecorder a("md r = a * b + c single pack " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      eval_to_single<T>(a_ * b_ + c_, r_.begin());
+    }
+  }
+  do_not_optimize(r_.begin());
+
+  {
+    TimerRecorder a("md r = a * b + c unrolled " + type);
+    size_t k = 0;
+    while (k++ < loop) {
+      (a_ * b_ + c_).template eval_to<AlignedPolicy>(r_.begin());
+    }
+  }
+  do_not_optimize(r_.begin());
+}
+
+void print_simd_type() {
+#if defined(USE_AVX2)
+  std::cout << "avx2...\n";
+
+#elif defined(USE_AVX512)
+  std::cout << "avx512...\n";
+
+#elif defined(USE_SSE)
+  std::cout << "sse...\n";
+
+#elif defined(USE_NEON)
+  std::cout << "neon...\n";
+
+#elif defined(USE_RVV)
+  std::cout << "risc_v...\n";
+
+#else
+  std::cout << "default avx2...\n";
+#endif
+}
+
+int main(int args, char* argv[]) {
+  print_simd_type();
+
+  for (const auto& test : all_test_points) {
+    loop = test.loop_;
+    dim1 = test.dim1_;
+    dim2 = test.dim2_;
+    total_element = test.total_element_;
+    total_cal = test.total_cal_;
+
+    std::cout << "2d unrolled evaluation: " << dim1 << "*" << dim2 << "\n";
+
+    test_unroll<float>("f32");
+    test_unroll<double>("f64");
+  }
+  TimerRecorder::SaveSpeedResult("unroll_speed_result.csv");
+  std::cout << "test complete" << std::endl;
+
+  return 0;
+}